@@ -13,11 +13,16 @@
 
 #include "esp_err.h"
 #include "lvgl.h"
+#include "esp_lvgl_port_stats.h"
 #include "esp_lvgl_port_disp.h"
 #include "esp_lvgl_port_touch.h"
 #include "esp_lvgl_port_knob.h"
 #include "esp_lvgl_port_button.h"
 #include "esp_lvgl_port_usbhid.h"
+#include "esp_lvgl_port_draw.h"
+#include "esp_lvgl_port_cmd.h"
+#include "esp_lvgl_port_governor.h"
+#include "esp_lvgl_port_trace.h"
 
 #if LVGL_VERSION_MAJOR == 8
 #include "esp_lvgl_port_compatibility.h"
@@ -44,6 +49,20 @@ typedef struct {
     void *param;
 } lvgl_port_event_t;
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Statistics of LVGL task wakeups
+ */
+typedef struct {
+    uint32_t events;     /*!< Count of events sent to LVGL task (lvgl_port_task_wake) */
+    uint32_t coalesced;  /*!< Count of events merged into an already pending event of the same kind */
+    uint32_t wakeups;    /*!< Count of LVGL task passes with at least one pending event */
+    uint32_t passes;     /*!< Count of all LVGL task passes (lv_timer_handler calls) */
+    uint32_t timeouts;   /*!< Count of LVGL task wakeups by timeout, without any event (idle wakeups) */
+    uint32_t max_batch;  /*!< Maximum count of events handled by one pass */
+} lvgl_port_task_stats_t;
+#endif
+
 /**
  * @brief Init configuration structure
  */
@@ -53,6 +72,7 @@ typedef struct {
     int task_affinity;      /*!< LVGL task pinned to core (-1 is no affinity) */
     int task_max_sleep_ms;  /*!< Maximum sleep in LVGL task */
     int timer_period_ms;    /*!< LVGL timer tick period in ms */
+    bool tickless;          /*!< Read LVGL tick from esp_timer_get_time() instead of periodic timer (timer_period_ms is not used). LVGL9: task sleeps without timeout, when no LVGL timer is ready */
 } lvgl_port_cfg_t;
 
 /**
@@ -109,6 +129,44 @@ bool lvgl_port_lock(uint32_t timeout_ms);
  */
 void lvgl_port_unlock(void);
 
+/**
+ * @brief Enable or disable recording of LVGL mutex statistics (lock contention profiling)
+ *
+ * @note For each task using lvgl_port_lock, the waiting and holding time is recorded, together with the caller of the longest hold.
+ *       When the LVGL task has to wait for the mutex, the wait is blamed on the task, which holds it.
+ * @note Statistics are cleared when enabled. When disabled, the cost is one flag check per lock.
+ *
+ * @param enable True, if statistics should be recorded
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if LVGL port is not initialized
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_lock_stats_enable(bool enable);
+
+/**
+ * @brief Get statistics of LVGL mutex
+ *
+ * @param stats Statistics output, tasks are sorted from the one, which delayed the LVGL task the most
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_INVALID_STATE     if statistics were never enabled
+ */
+esp_err_t lvgl_port_lock_get_stats(lvgl_port_lock_stats_t *stats, bool reset);
+
+/**
+ * @brief Print ranked report of LVGL mutex statistics (one log line per task)
+ *
+ * @param reset True, if statistics should be cleared after print
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if statistics were never enabled
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_lock_log_stats(bool reset);
+
 /**
  * @brief Notify LVGL, that data was flushed to LCD display
  *
@@ -148,10 +206,24 @@ esp_err_t lvgl_port_resume(void);
  * @return
  *      - ESP_OK on success
  *      - ESP_ERR_NOT_SUPPORTED if it is not implemented
- *      - ESP_ERR_INVALID_STATE if queue is not initialized (can be returned after LVGL deinit)
+ *      - ESP_ERR_INVALID_STATE if LVGL task is not initialized (can be returned after LVGL deinit)
  */
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param);
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Get statistics of LVGL task wakeups and events coalescing
+ *
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_INVALID_STATE     if LVGL task is not running
+ */
+esp_err_t lvgl_port_task_get_stats(lvgl_port_task_stats_t *stats, bool reset);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
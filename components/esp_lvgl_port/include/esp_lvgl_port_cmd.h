@@ -0,0 +1,136 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port UI command queue
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum count of merge keys
+ */
+#define LVGL_PORT_CMD_MERGE_KEYS_MAX    (32)
+
+/**
+ * @brief UI command callback, called in LVGL task with LVGL mutex taken
+ *
+ * @param user_data User data from post
+ * @param data      Copy of posted parameter data (NULL if no data was posted)
+ * @param len       Length of posted parameter data
+ */
+typedef void (*lvgl_port_cmd_cb_t)(void *user_data, const void *data, size_t len);
+
+/**
+ * @brief Behavior of post into full command queue
+ */
+typedef enum {
+    LVGL_PORT_CMD_OVERFLOW_DROP_NEW = 0,    /*!< New command is rejected */
+    LVGL_PORT_CMD_OVERFLOW_DROP_OLDEST,     /*!< The oldest queued command is dropped */
+} lvgl_port_cmd_overflow_t;
+
+/**
+ * @brief Configuration of UI command queue
+ */
+typedef struct {
+    uint16_t queue_size;                /*!< Count of pending commands, rounded up to power of two (0: 32) */
+    uint16_t data_size;                 /*!< Maximum size of parameter data of one command in bytes (0: 16) */
+    uint8_t merge_keys;                 /*!< Count of merge keys, keys 1..merge_keys can be used (max LVGL_PORT_CMD_MERGE_KEYS_MAX) */
+    lvgl_port_cmd_overflow_t overflow;  /*!< Behavior of post into full queue */
+} lvgl_port_cmd_queue_cfg_t;
+
+/**
+ * @brief Statistics of UI command queue
+ */
+typedef struct {
+    uint32_t posted;        /*!< Count of posted commands */
+    uint32_t applied;       /*!< Count of commands applied in LVGL task */
+    uint32_t merged;        /*!< Count of commands replaced by a newer command with the same key */
+    uint32_t dropped;       /*!< Count of commands dropped on overflow (rejected new or dropped oldest) */
+    uint32_t batches;       /*!< Count of batches with at least one applied command */
+    uint32_t max_batch;     /*!< Maximum count of commands applied in one batch */
+    uint32_t depth;         /*!< Count of pending commands now */
+    uint32_t max_depth;     /*!< Maximum count of pending commands */
+} lvgl_port_cmd_stats_t;
+
+/**
+ * @brief Create UI command queue
+ *
+ * @note Commands are applied in a batch by LVGL task, before each lv_timer_handler call. Only with LVGL9.
+ * @note LVGL port must be initialized (lvgl_port_init) before. The queue is deleted in lvgl_port_deinit,
+ *       all tasks and interrupts posting commands must stop before it.
+ *
+ * @param cfg Queue configuration (NULL: default configuration)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if configuration is not valid
+ *      - ESP_ERR_INVALID_STATE     if queue was already created
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_cmd_queue_init(const lvgl_port_cmd_queue_cfg_t *cfg);
+
+/**
+ * @brief Post UI command into queue
+ *
+ * @note It does not block and does not take LVGL mutex, it can be called from any task or interrupt.
+ *       The command is applied later in LVGL task, posts from one task are applied in the same order.
+ *
+ * @param cb        Command callback
+ * @param user_data User data for the callback
+ * @param data      Parameter data, they are copied into the queue (can be NULL)
+ * @param len       Length of parameter data (max data_size)
+ * @return
+ *      - ESP_OK                    on success (also when the oldest command was dropped)
+ *      - ESP_ERR_INVALID_ARG       if callback is NULL or data are too long
+ *      - ESP_ERR_INVALID_STATE     if queue was not created
+ *      - ESP_ERR_NO_MEM            if queue is full
+ */
+esp_err_t lvgl_port_cmd_post(lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len);
+
+/**
+ * @brief Post UI command with merge key into queue
+ *
+ * @note Pending command with the same key is replaced, only the newest one is applied (e.g. the last value of a label).
+ *       Merged commands are applied after the other commands of the batch.
+ *
+ * @param key       Merge key (1..merge_keys)
+ * @param cb        Command callback
+ * @param user_data User data for the callback
+ * @param data      Parameter data, they are copied into the queue (can be NULL)
+ * @param len       Length of parameter data (max data_size)
+ * @return
+ *      - ESP_OK                    on success (also when the oldest command was dropped)
+ *      - ESP_ERR_INVALID_ARG       if key is not valid, callback is NULL or data are too long
+ *      - ESP_ERR_INVALID_STATE     if queue was not created
+ *      - ESP_ERR_NO_MEM            if queue is full
+ */
+esp_err_t lvgl_port_cmd_post_merge(uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len);
+
+/**
+ * @brief Get statistics of UI command queue
+ *
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read (maximum depth is set to the current depth)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_INVALID_STATE     if queue was not created
+ */
+esp_err_t lvgl_port_cmd_get_stats(lvgl_port_cmd_stats_t *stats, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
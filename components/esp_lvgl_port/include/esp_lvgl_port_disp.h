@@ -15,6 +15,7 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "lvgl.h"
+#include "esp_lvgl_port_stats.h"
 
 #if LVGL_VERSION_MAJOR == 8
 #include "esp_lvgl_port_compatibility.h"
@@ -24,6 +25,16 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Maximum count of draw buffers in ring (buffer_count)
+ */
+#define LVGL_PORT_DISP_BUFFERS_MAX  (8)
+
+/**
+ * @brief Maximum count of transfers queued in transmit task (tx_task.max_pending)
+ */
+#define LVGL_PORT_DISP_TX_PENDING_MAX  (16)
+
 /**
  * @brief Rotation configuration
  */
@@ -43,7 +54,7 @@ typedef struct {
 
     uint32_t    buffer_size;        /*!< Size of the buffer for the screen in pixels */
     bool        double_buffer;      /*!< True, if should be allocated two buffers */
-    uint32_t    trans_size;         /*!< Allocated buffer will be in SRAM to move framebuf (optional) */
+    uint32_t    trans_size;         /*!< Allocated buffer will be in SRAM to move framebuf, size in pixels (optional, LVGL9 uses two buffers to overlap copy and transfer) */
 
     uint32_t    hres;           /*!< LCD display horizontal resolution */
     uint32_t    vres;           /*!< LCD display vertical resolution */
@@ -52,16 +63,29 @@ typedef struct {
 
     lvgl_port_rotation_cfg_t rotation;      /*!< Default values of the screen rotation */
 #if LVGL_VERSION_MAJOR >= 9
-    lv_color_format_t        color_format;  /*!< The color format of the display */
+    lv_color_format_t        color_format;  /*!< The color format of the display (LV_COLOR_FORMAT_I1 only for monochrome display, from LVGL 9.2) */
+    uint8_t     coalesce_overdraw;  /*!< Merge invalidated areas, when it costs max this overdraw in percent (0: disabled, only in partial mode) */
+    uint8_t     buffer_count;       /*!< Count of draw buffers in ring, LVGL renders ahead while transfers are pending (0: use double_buffer, max LVGL_PORT_DISP_BUFFERS_MAX, only in partial mode) */
+    struct {
+        int     priority;           /*!< Render task priority (0: priority 4) */
+        int     stack;              /*!< Render task stack size (0: 6144 bytes) */
+        int     affinity;           /*!< Render task pinned to core (-1 is no affinity) */
+    } render_task;                  /*!< Own render task of this display, used only with flags.own_task */
+    struct {
+        uint32_t size;              /*!< Size of transmit FIFO in SRAM in pixels, flushed areas are copied into it and LVGL continues immediately (0: disabled, only I2C/SPI/I8080 displays) */
+        uint8_t  max_pending;       /*!< Maximum count of transfers queued in transmit task, the next flush waits for a finished one (0: 4, max LVGL_PORT_DISP_TX_PENDING_MAX) */
+        int      priority;          /*!< Transmit task priority (0: priority 5) */
+        int      stack;             /*!< Transmit task stack size (0: 3072 bytes) */
+        int      affinity;          /*!< Transmit task pinned to core (-1 is no affinity) */
+    } tx_task;                      /*!< Transmit task of this display, which calls esp_lcd_panel_draw_bitmap, used only with tx_task.size */
 #endif
     struct {
         unsigned int buff_dma: 1;    /*!< Allocated LVGL buffer will be DMA capable */
         unsigned int buff_spiram: 1; /*!< Allocated LVGL buffer will be in PSRAM */
-#if LVGL_VERSION_MAJOR == 8
         unsigned int sw_rotate: 1;   /*!< Use software rotation (slower) */
-#endif
 #if LVGL_VERSION_MAJOR >= 9
         unsigned int swap_bytes: 1;  /*!< Swap bytes in RGB656 (16-bit) color format before send to LCD driver */
+        unsigned int own_task: 1;    /*!< Refresh this display in own render task (render_task), independently of other displays */
 #endif
         unsigned int full_refresh: 1;/*!< 1: Always make the whole screen redrawn */
         unsigned int direct_mode: 1; /*!< 1: Use screen-sized buffers and draw to absolute coordinates */
@@ -75,6 +99,8 @@ typedef struct {
     struct {
         unsigned int bb_mode: 1;        /*!< 1: Use bounce buffer mode */
         unsigned int avoid_tearing: 1;  /*!< 1: Use internal RGB buffers as a LVGL draw buffers to avoid tearing effect */
+        unsigned int nonblocking: 1;    /*!< 1: With avoid_tearing, LVGL task does not wait for VSYNC, frame buffers are switched in VSYNC interrupt (only with LVGL9, full_refresh or direct_mode) */
+        unsigned int triple_buffer: 1;  /*!< 1: With nonblocking, use three RGB buffers (panel must have num_fbs = 3), LVGL renders into the free one immediately */
     } flags;
 } lvgl_port_display_rgb_cfg_t;
 
@@ -82,9 +108,50 @@ typedef struct {
  * @brief Configuration MIPI-DSI display structure
  */
 typedef struct {
-    int dummy;
+    struct {
+        unsigned int use_ppa: 1;    /*!< 1: Copy rendered areas into the frame buffer by PPA with rotation and mirroring (only ESP32P4 from IDF 5.4 and LVGL9, RGB565 only) */
+        unsigned int fb_rgb888: 1;  /*!< 1: Frame buffer of the panel is in RGB888, PPA converts rendered RGB565 (only with use_ppa) */
+    } flags;
 } lvgl_port_display_dsi_cfg_t;
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Statistics of invalidated areas coalescing
+ */
+typedef struct {
+    uint32_t frames;         /*!< Count of rendered frames with coalescing */
+    uint32_t areas_in;       /*!< Count of invalidated areas before coalescing */
+    uint32_t areas_out;      /*!< Count of areas sent to the display after coalescing */
+    uint32_t merged;         /*!< Count of areas merged into another area */
+    uint32_t unmerged;       /*!< Count of areas sent without merging */
+    uint64_t overdraw_px;    /*!< Count of pixels redrawn only because of merging */
+} lvgl_port_coalesce_stats_t;
+
+/**
+ * @brief Statistics of draw buffers ring
+ */
+typedef struct {
+    uint32_t flushes;        /*!< Count of flushed areas */
+    uint32_t stalls;         /*!< Count of flushes, which had to wait for a free buffer */
+    uint64_t stall_time_us;  /*!< Time spent waiting for a free buffer */
+    uint8_t  max_in_flight;  /*!< Maximum count of buffers in flight (flushed and not transferred yet) */
+    uint32_t in_flight[LVGL_PORT_DISP_BUFFERS_MAX + 1]; /*!< Histogram of buffers in flight right after each flush (index is count of buffers) */
+} lvgl_port_buffer_stats_t;
+
+/**
+ * @brief Statistics of transmit task
+ */
+typedef struct {
+    uint32_t flushes;        /*!< Count of flushed areas */
+    uint32_t transfers;      /*!< Count of transfers queued in transmit task (areas are split by the size of transmit FIFO) */
+    uint64_t copy_us;        /*!< Time of copying into transmit FIFO */
+    uint32_t stalls;         /*!< Count of transfers, which waited for space in transmit FIFO or in the queue (back-pressure) */
+    uint64_t stall_time_us;  /*!< Time spent waiting for space */
+    uint8_t  max_pending;    /*!< Maximum count of transfers queued or in progress */
+    uint32_t max_fill;       /*!< Maximum count of used bytes in transmit FIFO */
+} lvgl_port_tx_stats_t;
+#endif
+
 /**
  * @brief Add I2C/SPI/I8080 display handling to LVGL
  *
@@ -121,12 +188,97 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, co
  * @brief Remove display handling from LVGL
  *
  * @note Free all memory used for this display.
+ * @note Render task is stopped and transfers queued in transmit task are finished before the display is removed.
+ *       If they are not stopped in time, the display is not removed (it is not refreshed anymore) and the removal
+ *       can be repeated. Render task needs LVGL mutex to finish, do not call this function with the mutex locked.
  *
  * @return
  *      - ESP_OK                    on success
+ *      - ESP_ERR_TIMEOUT           if render task or transmit task was not stopped in time (only with LVGL9)
  */
 esp_err_t lvgl_port_remove_disp(lv_display_t *disp);
 
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Get statistics of invalidated areas coalescing
+ *
+ * @note Coalescing must be enabled by `coalesce_overdraw` in display configuration.
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if coalescing is not enabled for this display
+ */
+esp_err_t lvgl_port_disp_get_coalesce_stats(lv_display_t *disp, lvgl_port_coalesce_stats_t *stats, bool reset);
+
+/**
+ * @brief Get statistics of draw buffers ring
+ *
+ * @note Ring must be enabled by `buffer_count` in display configuration.
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if ring is not enabled for this display
+ */
+esp_err_t lvgl_port_disp_get_buffer_stats(lv_display_t *disp, lvgl_port_buffer_stats_t *stats, bool reset);
+
+/**
+ * @brief Get statistics of transmit task
+ *
+ * @note Transmit task must be enabled by `tx_task.size` in display configuration. Bus throughput is measured
+ *       by display statistics (lvgl_port_disp_stats_enable).
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if transmit task is not enabled for this display
+ */
+esp_err_t lvgl_port_disp_get_tx_stats(lv_display_t *disp, lvgl_port_tx_stats_t *stats, bool reset);
+
+/**
+ * @brief Enable or disable collecting of display statistics
+ *
+ * @note Statistics are cleared when enabled. When disabled, the cost is one flag check per flush and transfer.
+ *
+ * @param disp   LVGL display handle (returned from lvgl_port_add_disp)
+ * @param enable True, if statistics should be collected
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if display was not added by LVGL port
+ */
+esp_err_t lvgl_port_disp_stats_enable(lv_display_t *disp, bool enable);
+
+/**
+ * @brief Get display statistics (frames, areas, pixels, render time, flush wait, bus throughput and latency)
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if statistics are not enabled for this display
+ */
+esp_err_t lvgl_port_disp_get_stats(lv_display_t *disp, lvgl_port_disp_stats_t *stats, bool reset);
+
+/**
+ * @brief Print display statistics in one compact log line
+ *
+ * @param disp  LVGL display handle (returned from lvgl_port_add_disp)
+ * @param reset True, if statistics should be cleared after print
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if statistics are not enabled for this display
+ */
+esp_err_t lvgl_port_disp_log_stats(lv_display_t *disp, bool reset);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port draw worker
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Configuration of draw worker
+ */
+typedef struct {
+    int task_priority;      /*!< Draw worker task priority (0: priority 4) */
+    int task_stack;         /*!< Draw worker task stack size (0: 8192 bytes) */
+    int task_affinity;      /*!< Draw worker task pinned to core (-1: core, which is not used by LVGL task) */
+} lvgl_port_draw_worker_cfg_t;
+
+/**
+ * @brief Statistics of draw worker
+ */
+typedef struct {
+    uint32_t sw_tasks;          /*!< Count of draw tasks left to LVGL software renderer */
+    uint32_t worker_tasks;      /*!< Count of draw tasks rendered by draw worker (counted after rendering) */
+    uint64_t sw_px;             /*!< Pixels of draw tasks left to LVGL software renderer */
+    uint64_t worker_px;         /*!< Pixels of draw tasks rendered by draw worker */
+    uint64_t worker_busy_us;    /*!< Time spent by draw worker in rendering */
+} lvgl_port_draw_worker_stats_t;
+
+/**
+ * @brief Start draw worker on the second core
+ *
+ * @note Draw worker is added into LVGL as a draw unit. Draw tasks are split between LVGL software renderer and the worker by their size.
+ *       Independent tasks (not overlapping areas) are rendered on both cores in parallel. It needs LVGL 9.1 or 9.2 with OS (LV_USE_OS).
+ * @note LVGL port must be initialized (lvgl_port_init) before.
+ *
+ * @param cfg Draw worker configuration (NULL: default configuration)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_SUPPORTED     if LVGL version or configuration is not supported, or the chip has one core
+ *      - ESP_ERR_INVALID_ARG       if core number is not valid
+ *      - ESP_ERR_INVALID_STATE     if draw worker is already running
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_draw_worker_init(const lvgl_port_draw_worker_cfg_t *cfg);
+
+/**
+ * @brief Enable or disable splitting of draw tasks to the draw worker
+ *
+ * @note When disabled, all draw tasks are rendered by LVGL software renderer (e.g. for comparing in benchmark).
+ *
+ * @param enable True, if draw tasks should be split
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if draw worker is not running
+ */
+esp_err_t lvgl_port_draw_worker_enable(bool enable);
+
+/**
+ * @brief Get statistics of draw worker
+ *
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if draw worker is not running
+ */
+esp_err_t lvgl_port_draw_worker_get_stats(lvgl_port_draw_worker_stats_t *stats, bool reset);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,76 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port refresh rate governor
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Configuration of refresh rate governor
+ */
+typedef struct {
+    uint32_t active_period_ms;  /*!< Refresh and input read period during interaction or animations (0: LV_DEF_REFR_PERIOD) */
+    uint32_t idle_period_ms;    /*!< Refresh and input read period, when nothing animates (0: 100 ms) */
+    uint32_t active_hold_ms;    /*!< Time after the last input activity, when the active period is kept (0: 2000 ms) */
+    bool pm_lock;               /*!< Keep maximum CPU frequency during rendering (esp_pm lock, needs CONFIG_PM_ENABLE) */
+} lvgl_port_governor_cfg_t;
+
+/**
+ * @brief Statistics of refresh rate governor
+ */
+typedef struct {
+    uint32_t switches;          /*!< Count of switches between active and idle period */
+    uint64_t active_us;         /*!< Time spent with active period */
+    uint64_t idle_us;           /*!< Time spent with idle period */
+    uint32_t renders;           /*!< Count of renders with CPU frequency lock */
+    uint64_t render_us;         /*!< Time of renders with CPU frequency lock */
+} lvgl_port_governor_stats_t;
+
+/**
+ * @brief Start refresh rate governor
+ *
+ * @note The governor is evaluated in every LVGL task pass. It sets refresh period of all displays and read period
+ *       of all polled input devices to the active period, when any animation is running or any input device was
+ *       active in the last active_hold_ms. Otherwise the idle period is set.
+ * @note LVGL port must be initialized (lvgl_port_init) before.
+ *
+ * @param cfg Governor configuration (NULL: default configuration)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if governor is already running
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_governor_init(const lvgl_port_governor_cfg_t *cfg);
+
+/**
+ * @brief Get statistics of refresh rate governor
+ *
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if stats is NULL
+ *      - ESP_ERR_INVALID_STATE     if governor is not running
+ */
+esp_err_t lvgl_port_governor_get_stats(lvgl_port_governor_stats_t *stats, bool reset);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,155 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port statistics
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Count of buckets in latency histogram (bucket i counts latencies below 2^i ms, the last one counts the rest)
+ */
+#define LVGL_PORT_STATS_LATENCY_BUCKETS  (8)
+
+/**
+ * @brief Display statistics
+ */
+typedef struct {
+    uint64_t elapsed_us;     /*!< Time since statistics were enabled or reset */
+    uint32_t frames;         /*!< Count of rendered frames */
+    uint32_t areas;          /*!< Count of flushed areas */
+    uint64_t pixels;         /*!< Count of flushed pixels */
+    uint64_t bytes;          /*!< Count of bytes sent to the panel */
+    uint64_t render_us;      /*!< Time spent in LVGL rendering (without waiting for flush ready) */
+    uint64_t flush_wait_us;  /*!< Time LVGL waited for flush ready (from LVGL 9.1) */
+    uint64_t bus_busy_us;    /*!< Time with pending transfers (from flush to panel ready) */
+    uint64_t latency_sum_us; /*!< Sum of latencies from the first invalidation to panel ready */
+    uint32_t latency_max_us; /*!< Maximum latency from the first invalidation to panel ready */
+    uint32_t latency_hist[LVGL_PORT_STATS_LATENCY_BUCKETS]; /*!< Histogram of latencies from the first invalidation to panel ready */
+} lvgl_port_disp_stats_t;
+
+/**
+ * @brief Add latency of one frame into statistics
+ *
+ * @param stats      Statistics
+ * @param latency_us Latency from the first invalidation to panel ready
+ */
+void lvgl_port_stats_add_latency(lvgl_port_disp_stats_t *stats, uint32_t latency_us);
+
+/**
+ * @brief Format statistics into one compact line
+ *
+ * Example: `frames 120 (30.0 fps), areas 2.5/frame, px 4800/frame, render 7.2 ms/frame, wait 1.1 ms/frame, bus 10.2 MB/s (40% busy), latency avg 12.4 ms max 33.0 ms, hist 0 4 20 80 10 6 0 0`
+ *
+ * @param stats Statistics
+ * @param buf   Output buffer
+ * @param len   Size of output buffer (the line is truncated, 192 bytes is enough)
+ * @return Length of the whole line (same as snprintf)
+ */
+int lvgl_port_stats_format(const lvgl_port_disp_stats_t *stats, char *buf, size_t len);
+
+/**
+ * @brief Count of tasks recorded in LVGL lock statistics (locks of other tasks are counted only as dropped)
+ */
+#define LVGL_PORT_LOCK_STATS_TASKS  (8)
+
+/**
+ * @brief LVGL lock statistics of one task
+ */
+typedef struct {
+    const void *task;               /*!< Task handle (TaskHandle_t) */
+    char name[16];                  /*!< Task name */
+    uint32_t locks;                 /*!< Count of taken locks (nested locks are not counted) */
+    uint32_t waits;                 /*!< Count of locks, which waited for another task */
+    uint32_t timeouts;              /*!< Count of locks, which failed on timeout */
+    uint64_t wait_us;               /*!< Time spent waiting for the lock */
+    uint32_t wait_max_us;           /*!< Longest wait for the lock */
+    uint64_t hold_us;               /*!< Time of holding the lock */
+    uint32_t hold_max_us;           /*!< Longest hold of the lock */
+    const void *hold_max_caller;    /*!< Return address into the caller of lvgl_port_lock with the longest hold */
+    uint32_t starved;               /*!< Count of LVGL task waits for the lock held by this task */
+    uint64_t starved_us;            /*!< Time of LVGL task waiting for the lock held by this task */
+} lvgl_port_lock_task_stats_t;
+
+/**
+ * @brief LVGL lock statistics
+ */
+typedef struct {
+    uint64_t elapsed_us;            /*!< Time since statistics were enabled or reset */
+    uint32_t starved;               /*!< Count of LVGL task waits for the lock held by another task */
+    uint64_t starved_us;            /*!< Time of LVGL task waiting for the lock held by another task */
+    uint32_t dropped;               /*!< Count of locks not recorded (table of tasks is full) */
+    uint32_t task_cnt;              /*!< Count of recorded tasks */
+    lvgl_port_lock_task_stats_t tasks[LVGL_PORT_LOCK_STATS_TASKS]; /*!< Recorded tasks */
+} lvgl_port_lock_stats_t;
+
+/**
+ * @brief Find task in lock statistics or add it
+ *
+ * @param stats Lock statistics
+ * @param task  Task handle
+ * @param name  Task name (copied only for a new task)
+ * @return Index of the task, or -1 if the table is full (the lock is counted as dropped)
+ */
+int lvgl_port_lock_stats_task(lvgl_port_lock_stats_t *stats, const void *task, const char *name);
+
+/**
+ * @brief Add one wait for the lock into statistics
+ *
+ * @param stats     Lock statistics
+ * @param idx       Index of the waiting task (-1 or not recorded index is ignored)
+ * @param wait_us   Waiting time
+ * @param locked    True, if the lock was taken (false on timeout)
+ * @param owner     Index of the task, which held the lock when the wait started (-1: unknown)
+ * @param lvgl_task True, if the waiting task is the LVGL task (the wait is counted as starving)
+ */
+void lvgl_port_lock_stats_add_wait(lvgl_port_lock_stats_t *stats, int idx, uint32_t wait_us, bool locked, int owner, bool lvgl_task);
+
+/**
+ * @brief Add one hold of the lock into statistics
+ *
+ * @param stats     Lock statistics
+ * @param idx       Index of the holding task (-1 or not recorded index is ignored)
+ * @param hold_us   Time from the outermost lock to the last unlock
+ * @param caller    Return address into the caller of lvgl_port_lock
+ */
+void lvgl_port_lock_stats_add_hold(lvgl_port_lock_stats_t *stats, int idx, uint32_t hold_us, const void *caller);
+
+/**
+ * @brief Sort tasks in lock statistics from the worst one
+ *
+ * @note Tasks are ranked by time the LVGL task waited for them, then by their hold time. Indexes of tasks are changed.
+ *
+ * @param stats Lock statistics
+ */
+void lvgl_port_lock_stats_sort(lvgl_port_lock_stats_t *stats);
+
+/**
+ * @brief Format lock statistics of one task into one compact line
+ *
+ * Example: `sensor: locks 250, wait 1.2 ms (max 0.4 ms, 3 timeouts), hold 812.5 ms (20%, max 35.0 ms at 0x42001234), starved LVGL 12 times 96.3 ms`
+ *
+ * @param task       Lock statistics of the task
+ * @param elapsed_us Time of collecting statistics
+ * @param buf        Output buffer
+ * @param len        Size of output buffer (the line is truncated, 160 bytes is enough)
+ * @return Length of the whole line (same as snprintf)
+ */
+int lvgl_port_lock_stats_format(const lvgl_port_lock_task_stats_t *task, uint64_t elapsed_us, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -34,6 +34,13 @@ extern "C" {
 typedef struct {
     lv_display_t *disp;    /*!< LVGL display handle (returned from lvgl_port_add_disp) */
     esp_lcd_touch_handle_t   handle;   /*!< LCD touch IO handle */
+#if LVGL_VERSION_MAJOR >= 9
+    struct {
+        uint16_t ring_size;     /*!< Count of buffered touch samples (0: touch is read in LVGL task). Reader task of esp_lcd_touch saves timestamped samples and LVGL takes all of them */
+        int task_priority;      /*!< Reader task priority (0: 5) */
+        int task_affinity;      /*!< Reader task pinned to core (-1 is no affinity) */
+    } sampler;
+#endif
 } lvgl_port_touch_cfg_t;
 
 /**
@@ -55,6 +62,41 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg);
  *      - ESP_OK                    on success
  */
 esp_err_t lvgl_port_remove_touch(lv_indev_t *touch);
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Recognized two-finger gestures (bit mask of lvgl_port_touch_gesture_t::recognized)
+ */
+#define LVGL_PORT_TOUCH_GESTURE_PINCH   (1 << 0)
+#define LVGL_PORT_TOUCH_GESTURE_ROTATE  (1 << 1)
+#define LVGL_PORT_TOUCH_GESTURE_SCROLL  (1 << 2)
+
+/**
+ * @brief Two-finger gesture of touch input, relative to positions of the fingers when the second one was pressed
+ */
+typedef struct {
+    bool     active;        /*!< Exactly two points are pressed (the last values are kept after the end) */
+    uint8_t  recognized;    /*!< Gestures over threshold since the start (LVGL_PORT_TOUCH_GESTURE_*) */
+    float    scale;         /*!< Distance between the fingers / start distance (pinch) */
+    float    rotation;      /*!< Rotation of the fingers in degrees, -180 .. 180, clockwise on screen */
+    int32_t  scroll_x;      /*!< Move of the center between the fingers on x-axis (two-finger scroll) */
+    int32_t  scroll_y;      /*!< Move of the center between the fingers on y-axis (two-finger scroll) */
+    int32_t  center_x;      /*!< Center between the fingers on x-axis */
+    int32_t  center_y;      /*!< Center between the fingers on y-axis */
+} lvgl_port_touch_gesture_t;
+
+/**
+ * @brief Get the last two-finger gesture of touch input
+ *
+ * @note Only with LVGL9. Gesture is updated with each touch read.
+ *
+ * @param touch LVGL touch input device (returned from lvgl_port_add_touch)
+ * @param gesture Two-finger gesture
+ * @return
+ *      - ESP_OK                    on success
+ */
+esp_err_t lvgl_port_touch_get_gesture(lv_indev_t *touch, lvgl_port_touch_gesture_t *gesture);
+#endif
 #endif
 
 #ifdef __cplusplus
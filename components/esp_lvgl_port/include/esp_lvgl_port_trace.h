@@ -0,0 +1,73 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port frame-time trace recorder
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+/**
+ * @brief Default count of trace records (20 bytes each)
+ */
+#define LVGL_PORT_TRACE_ENTRIES_DEFAULT     (1024)
+
+/**
+ * @brief Start trace recording
+ *
+ * @note These events are recorded with timestamp and task: lv_timer_handler run, flush of area, transfer done
+ *       (DMA done interrupt), touch read, LVGL mutex hold (outermost lock to the last unlock) and events posted
+ *       to LVGL task (lvgl_port_task_wake). The newest records overwrite the oldest ones.
+ * @note The buffer is allocated in internal RAM on the first start and kept until lvgl_port_deinit.
+ *       Previous records are cleared.
+ *
+ * @param entries Count of trace records, rounded up to power of two (0: LVGL_PORT_TRACE_ENTRIES_DEFAULT)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if LVGL port is not initialized
+ *      - ESP_ERR_INVALID_SIZE      if the buffer is already allocated with different count of records
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t lvgl_port_trace_start(uint32_t entries);
+
+/**
+ * @brief Stop trace recording, records are kept for lvgl_port_trace_dump
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if trace was not started
+ */
+esp_err_t lvgl_port_trace_stop(void);
+
+/**
+ * @brief Write recorded trace as Chrome trace JSON (chrome://tracing, ui.perfetto.dev)
+ *
+ * @note Recording is paused during the dump and continues after it, if it was running.
+ * @note Timestamps are relative to the oldest record. Tasks are shown by their handles, interrupts and
+ *       LVGL task are named.
+ *
+ * @param stream Output stream (NULL: console)
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if trace was not started
+ */
+esp_err_t lvgl_port_trace_dump(FILE *stream);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
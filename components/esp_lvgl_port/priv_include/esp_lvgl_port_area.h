@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port invalidated areas coalescing
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Area (coordinates are inclusive, same as lv_area_t)
+ */
+typedef struct {
+    int32_t x1;
+    int32_t y1;
+    int32_t x2;
+    int32_t y2;
+} lvgl_port_area_t;
+
+/**
+ * @brief Result of one coalescing pass
+ */
+typedef struct {
+    uint32_t areas_in;       /*!< Count of areas on input (not joined) */
+    uint32_t areas_out;      /*!< Count of areas on output (not joined) */
+    uint32_t merged;         /*!< Count of areas merged into another area */
+    uint32_t unmerged;       /*!< Count of areas left untouched */
+    uint32_t overdraw_px;    /*!< Pixels, which will be redrawn only because of merging */
+} lvgl_port_area_result_t;
+
+/**
+ * @brief Merge areas into fewer areas, if the overdraw fits into the budget
+ *
+ * Two areas are merged, when their bounding box is not bigger than the count of really
+ * invalidated pixels in both areas plus the overdraw budget. The pair with the lowest overdraw
+ * is merged first, until no pair fits into the budget.
+ *
+ * @note Merged area is always stored on the higher index and the lower one is marked as joined.
+ *       The last not joined area stays the last one after merging.
+ *
+ * @param areas         Array of areas, merged areas are enlarged in place
+ * @param joined        Array of joined flags (1: area is not used), same length as areas
+ * @param count         Count of items in areas and joined arrays
+ * @param overdraw_pct  Allowed overdraw in percent of really invalidated pixels
+ * @param result        Result of coalescing (can be NULL)
+ * @return
+ *      - Count of merged areas
+ */
+uint32_t lvgl_port_area_coalesce(lvgl_port_area_t *areas, uint8_t *joined, uint32_t count, uint32_t overdraw_pct, lvgl_port_area_result_t *result);
+
+/**
+ * @brief Get size of the area in pixels
+ */
+static inline uint32_t lvgl_port_area_get_size(const lvgl_port_area_t *area)
+{
+    return (uint32_t)(area->x2 - area->x1 + 1) * (uint32_t)(area->y2 - area->y1 + 1);
+}
+
+/**
+ * @brief Get width of the area in pixels
+ */
+static inline uint32_t lvgl_port_area_get_width(const lvgl_port_area_t *area)
+{
+    return (uint32_t)(area->x2 - area->x1 + 1);
+}
+
+/**
+ * @brief Get height of the area in pixels
+ */
+static inline uint32_t lvgl_port_area_get_height(const lvgl_port_area_t *area)
+{
+    return (uint32_t)(area->y2 - area->y1 + 1);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port copy of rendered area into frame buffer
+ *
+ * Software reference of the 2D engine (PPA) operation: rotation (same as LVGL), mirroring
+ * on the display in default orientation and RGB565 to RGB888 conversion.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_lvgl_port_area.h"
+#include "esp_lvgl_port_rotate.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Configuration of copy into frame buffer
+ */
+typedef struct {
+    uint32_t hres;                  /*!< Horizontal resolution of the rotated screen (in LVGL) */
+    uint32_t vres;                  /*!< Vertical resolution of the rotated screen (in LVGL) */
+    lvgl_port_rotate_t rotation;    /*!< Rotation */
+    bool mirror_x;                  /*!< Mirror X on the display in default orientation */
+    bool mirror_y;                  /*!< Mirror Y on the display in default orientation */
+    bool swap_bytes;                /*!< Swap bytes of source RGB565 pixels */
+    bool rgb888;                    /*!< Frame buffer is in RGB888 format (otherwise RGB565) */
+} lvgl_port_blit_cfg_t;
+
+/**
+ * @brief Get area in the frame buffer, where the rendered area will be copied
+ *
+ * @param cfg   Configuration
+ * @param area  Area on the rotated screen
+ * @param out   Area in the frame buffer (display in default orientation)
+ */
+void lvgl_port_blit_get_area(const lvgl_port_blit_cfg_t *cfg, const lvgl_port_area_t *area, lvgl_port_area_t *out);
+
+/**
+ * @brief Copy RGB565 area into frame buffer with rotation, mirroring and color conversion
+ *
+ * @note In RGB888, the lower bits of each channel are filled by its upper bits (full white stays full white).
+ *
+ * @param cfg           Configuration
+ * @param fb            Frame buffer of the display in default orientation
+ * @param src           First pixel of the area
+ * @param src_stride    Source line length in pixels
+ * @param area          Area on the rotated screen
+ */
+void lvgl_port_blit_rgb565(const lvgl_port_blit_cfg_t *cfg, uint8_t *fb, const uint16_t *src, uint32_t src_stride, const lvgl_port_area_t *area);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,110 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port lock-free command queue
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_lvgl_port_cmd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Lock-free command queue (opaque)
+ */
+typedef struct lvgl_port_cmdq_s lvgl_port_cmdq_t;
+
+/**
+ * @brief Result of post into command queue
+ */
+typedef enum {
+    LVGL_PORT_CMDQ_POSTED,      /* Command was queued */
+    LVGL_PORT_CMDQ_MERGED,      /* Command replaced pending command with the same key */
+    LVGL_PORT_CMDQ_DROPPED,     /* Command was queued, the oldest command was dropped */
+    LVGL_PORT_CMDQ_FULL,        /* Command was rejected */
+} lvgl_port_cmdq_result_t;
+
+/**
+ * @brief Create command queue
+ *
+ * @param cfg Queue configuration (zero values are replaced by defaults)
+ * @return
+ *      - Command queue, or NULL if memory allocation fails or configuration is not valid
+ */
+lvgl_port_cmdq_t *lvgl_port_cmdq_create(const lvgl_port_cmd_queue_cfg_t *cfg);
+
+/**
+ * @brief Delete command queue, pending commands are not applied
+ *
+ * @param queue Command queue
+ */
+void lvgl_port_cmdq_delete(lvgl_port_cmdq_t *queue);
+
+/**
+ * @brief Post command (multiple producers, wait-free when the queue is not full)
+ *
+ * @note Callback must not be NULL and len must not exceed data_size, it is checked by the caller.
+ *
+ * @param queue     Command queue
+ * @param key       Merge key (0: no merging, 1..merge_keys)
+ * @param cb        Command callback
+ * @param user_data User data for the callback
+ * @param data      Parameter data (can be NULL)
+ * @param len       Length of parameter data
+ * @return
+ *      - Result of post
+ */
+lvgl_port_cmdq_result_t lvgl_port_cmdq_post(lvgl_port_cmdq_t *queue, uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len);
+
+/**
+ * @brief Apply pending commands (single consumer)
+ *
+ * @note Commands posted from callbacks are applied in the same batch, up to queue size commands are applied.
+ *
+ * @param queue Command queue
+ * @return
+ *      - Count of applied commands
+ */
+uint32_t lvgl_port_cmdq_run(lvgl_port_cmdq_t *queue);
+
+/**
+ * @brief Get statistics of command queue
+ *
+ * @param queue Command queue
+ * @param stats Statistics output
+ * @param reset True, if statistics should be cleared after read
+ */
+void lvgl_port_cmdq_get_stats(lvgl_port_cmdq_t *queue, lvgl_port_cmd_stats_t *stats, bool reset);
+
+/**
+ * @brief Get maximum size of parameter data of one command
+ *
+ * @param queue Command queue
+ * @return
+ *      - Size in bytes
+ */
+size_t lvgl_port_cmdq_get_data_size(const lvgl_port_cmdq_t *queue);
+
+/**
+ * @brief Get count of merge keys
+ *
+ * @param queue Command queue
+ * @return
+ *      - Count of merge keys
+ */
+uint32_t lvgl_port_cmdq_get_merge_keys(const lvgl_port_cmdq_t *queue);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port multi-touch tracking and two-finger gestures
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum count of tracked points (maximum of CONFIG_ESP_LCD_TOUCH_MAX_POINTS)
+ */
+#define LVGL_PORT_GESTURE_POINTS_MAX    (10)
+
+/**
+ * @brief Recognized two-finger gestures (bit mask)
+ */
+#define LVGL_PORT_GESTURE_PINCH     (1 << 0)
+#define LVGL_PORT_GESTURE_ROTATE    (1 << 1)
+#define LVGL_PORT_GESTURE_SCROLL    (1 << 2)
+
+/**
+ * @brief Tracked touch point
+ */
+typedef struct {
+    int32_t x;          /* Position on x-axis */
+    int32_t y;          /* Position on y-axis */
+    uint8_t id;         /* Touch ID, stable from press to release */
+    bool    pressed;    /* False: the point was released in this read (last known position) */
+} lvgl_port_gesture_point_t;
+
+/**
+ * @brief Thresholds of tracking and recognition
+ */
+typedef struct {
+    uint32_t track_dist;        /* Maximum move of a point between two reads to keep its ID (pixels) */
+    uint32_t pinch_permille;    /* Change of distance between the fingers recognized as pinch (1/1000 of the start distance) */
+    uint32_t rotate_decideg;    /* Rotation recognized as rotate gesture (0.1 degree) */
+    uint32_t scroll_dist;       /* Move of the center recognized as two-finger scroll (pixels) */
+} lvgl_port_gesture_cfg_t;
+
+/**
+ * @brief Two-finger gesture, relative to positions of the fingers when the second one was pressed
+ */
+typedef struct {
+    bool     active;        /* Exactly two points are pressed */
+    uint8_t  recognized;    /* Gestures over threshold since the start (LVGL_PORT_GESTURE_*) */
+    float    scale;         /* Distance between the fingers / start distance */
+    float    rotation;      /* Rotation of the line between the fingers in degrees (-180 .. 180, clockwise on screen) */
+    int32_t  scroll_x;      /* Move of the center between the fingers on x-axis */
+    int32_t  scroll_y;      /* Move of the center between the fingers on y-axis */
+    int32_t  center_x;      /* Center between the fingers on x-axis */
+    int32_t  center_y;      /* Center between the fingers on y-axis */
+} lvgl_port_gesture_t;
+
+/**
+ * @brief Touch tracker
+ */
+typedef struct {
+    lvgl_port_gesture_cfg_t     cfg;
+    lvgl_port_gesture_point_t   points[LVGL_PORT_GESTURE_POINTS_MAX];  /* Pressed points, the oldest press first */
+    uint8_t                     count;      /* Count of pressed points */
+    uint8_t                     next_id;    /* ID for the next new point */
+    struct {
+        uint8_t id[2];                      /* IDs of the fingers */
+        float   dist;                       /* Start distance between the fingers */
+        float   angle;                      /* Start angle of the line between the fingers (radians) */
+        int32_t center_x;                   /* Start center between the fingers */
+        int32_t center_y;
+    } start;
+    lvgl_port_gesture_t         gesture;
+} lvgl_port_gesture_tracker_t;
+
+/**
+ * @brief Initialize touch tracker
+ *
+ * @param tracker   Touch tracker
+ * @param cfg       Thresholds (NULL: default)
+ */
+void lvgl_port_gesture_init(lvgl_port_gesture_tracker_t *tracker, const lvgl_port_gesture_cfg_t *cfg);
+
+/**
+ * @brief Match points of one read with the tracked points and update the two-finger gesture
+ *
+ * Points are matched by the smallest move first, points moved more than track_dist get a new ID.
+ *
+ * @param tracker   Touch tracker
+ * @param x         Positions of pressed points on x-axis
+ * @param y         Positions of pressed points on y-axis
+ * @param cnt       Count of pressed points (points over LVGL_PORT_GESTURE_POINTS_MAX are ignored)
+ * @param out       Pressed points followed by points released in this read (2 * LVGL_PORT_GESTURE_POINTS_MAX)
+ * @return
+ *      - Count of points in out
+ */
+uint8_t lvgl_port_gesture_update(lvgl_port_gesture_tracker_t *tracker, const uint16_t *x, const uint16_t *y, uint8_t cnt,
+                                 lvgl_port_gesture_point_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port monochrome conversion
+ *
+ * Monochrome displays (SSD1306, SH1107...) use page layout: one byte contains 8 vertical pixels,
+ * the LSB is the top pixel. Page N contains lines 8*N ... 8*N+7. A set bit is a dark pixel.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Pixel is light, when the MSB of any color channel is set
+ */
+#define LVGL_PORT_MONO_RGB565_LIGHT(px)   (((px) & 0x8410) != 0)
+
+/**
+ * @brief Get size of the buffer in page layout
+ *
+ * @param w     Width in pixels
+ * @param h     Height in pixels (rounded up to whole pages)
+ */
+static inline uint32_t lvgl_port_mono_pages_size(uint32_t w, uint32_t h)
+{
+    return w * ((h + 7) / 8);
+}
+
+/**
+ * @brief Convert RGB565 area into page layout (not rotated)
+ *
+ * Eight source lines are packed into one page in one pass, source is read line by line.
+ *
+ * @param dst       Destination buffer (width src_w, min. size lvgl_port_mono_pages_size(src_w, src_h))
+ * @param src       Source RGB565 buffer
+ * @param src_w     Source width in pixels
+ * @param src_h     Source height in pixels
+ */
+void lvgl_port_mono_rgb565_to_pages(uint8_t *dst, const uint16_t *src, uint32_t src_w, uint32_t src_h);
+
+/**
+ * @brief Convert RGB565 area into page layout with swapped X and Y (90/270 rotation)
+ *
+ * Source line Y is destination column Y, eight neighboring source pixels are packed into one byte.
+ *
+ * @param dst       Destination buffer (width src_h, min. size lvgl_port_mono_pages_size(src_h, src_w))
+ * @param src       Source RGB565 buffer
+ * @param src_w     Source width in pixels
+ * @param src_h     Source height in pixels
+ */
+void lvgl_port_mono_rgb565_to_pages_swap_xy(uint8_t *dst, const uint16_t *src, uint32_t src_w, uint32_t src_h);
+
+/**
+ * @brief Convert 1-bit row-major area (LVGL I1 without palette) into page layout (not rotated)
+ *
+ * Source has MSB as the left pixel and a set bit is a light pixel. Blocks of 8x8 pixels are transposed at once.
+ *
+ * @param dst           Destination buffer (width src_w, min. size lvgl_port_mono_pages_size(src_w, src_h))
+ * @param src           Source buffer
+ * @param src_stride    Source line length in bytes
+ * @param src_w         Source width in pixels
+ * @param src_h         Source height in pixels
+ */
+void lvgl_port_mono_i1_to_pages(uint8_t *dst, const uint8_t *src, uint32_t src_stride, uint32_t src_w, uint32_t src_h);
+
+/**
+ * @brief Convert 1-bit row-major area (LVGL I1 without palette) into page layout with swapped X and Y (90/270 rotation)
+ *
+ * Source line Y is destination column Y, every source byte is one destination byte with reversed bit order.
+ *
+ * @param dst           Destination buffer (width src_h, min. size lvgl_port_mono_pages_size(src_h, src_w))
+ * @param src           Source buffer
+ * @param src_stride    Source line length in bytes
+ * @param src_w         Source width in pixels
+ * @param src_h         Source height in pixels
+ */
+void lvgl_port_mono_i1_to_pages_swap_xy(uint8_t *dst, const uint8_t *src, uint32_t src_stride, uint32_t src_w, uint32_t src_h);
+
+#ifdef __cplusplus
+}
+#endif
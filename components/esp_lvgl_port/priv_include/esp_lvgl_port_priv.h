@@ -29,19 +29,112 @@ typedef enum {
  */
 typedef struct {
     unsigned int avoid_tearing: 1;    /*!< Use internal RGB buffers as a LVGL draw buffers to avoid tearing effect */
+    unsigned int nonblocking: 1;      /*!< Frame buffers are switched in VSYNC interrupt, LVGL task does not wait for VSYNC */
+    unsigned int triple_buffer: 1;    /*!< Use three internal RGB buffers */
 } lvgl_port_disp_priv_cfg_t;
 
+/**
+ * @brief Notification bits of LVGL task (LVGL9 sets them, LVGL8 only wakes the task)
+ */
+#define LVGL_PORT_NOTIFY_WAKE   (1 << 0)    /* Some event is pending (lvgl_port_task_wake) */
+#define LVGL_PORT_NOTIFY_VSYNC  (1 << 1)    /* RGB panel switched frame buffer */
+#define LVGL_PORT_NOTIFY_FLUSH  (1 << 2)    /* Flush of display with own render task is finished */
+
 /**
  * @brief Notify LVGL task
  *
  * @note It is called from RGB vsync ready
  *
- * @param value     notification value
+ * @param value     notification value (LVGL_PORT_NOTIFY_* bits)
  * @return
  *      - true, whether a high priority task has been waken up by this function
  */
 bool lvgl_port_task_notify(uint32_t value);
 
+/**
+ * @brief Wait in LVGL task for notification bits
+ *
+ * @note Other notification bits are kept for LVGL task loop. Only with LVGL9.
+ *
+ * @param value     notification bits to wait for (LVGL_PORT_NOTIFY_* bits)
+ */
+void lvgl_port_task_wait_notify(uint32_t value);
+
+/**
+ * @brief Get core of LVGL task
+ *
+ * @return Core number from LVGL port configuration (-1 is no affinity). Only with LVGL9.
+ */
+int lvgl_port_task_get_affinity(void);
+
+/**
+ * @brief Get handle of LVGL task
+ *
+ * @return Task handle (NULL if the task is not running). Only with LVGL9.
+ */
+void *lvgl_port_task_get_handle(void);
+
+/**
+ * @brief Apply pending UI commands (lvgl_port_cmd_post) in LVGL task
+ *
+ * @note It is called with LVGL mutex taken, before lv_timer_handler. Only with LVGL9.
+ */
+void lvgl_port_cmd_queue_run(void);
+
+/**
+ * @brief Delete UI command queue, pending commands are not applied
+ *
+ * @note It is called from LVGL port deinit, after LVGL task is stopped and before LVGL mutex is deleted. Only with LVGL9.
+ */
+void lvgl_port_cmd_queue_deinit(void);
+
+/**
+ * @brief Set refresh period by activity (lvgl_port_governor_init)
+ *
+ * @note It is called in LVGL task with LVGL mutex taken, before lv_timer_handler. Only with LVGL9.
+ */
+void lvgl_port_governor_update(void);
+
+/**
+ * @brief Stop refresh rate governor
+ *
+ * @note It is called from LVGL port deinit. Only with LVGL9.
+ */
+void lvgl_port_governor_deinit(void);
+
+/**
+ * @brief Trace recording is running (lvgl_port_trace_start), checked before each record
+ */
+extern bool lvgl_port_trace_enabled;
+
+/**
+ * @brief Write trace record with timestamp and current task
+ *
+ * @note Use LVGL_PORT_TRACE, it can be called from interrupt. Only with LVGL9.
+ *
+ * @param event Traced event (lvgl_port_trace_event_t)
+ * @param phase Phase of traced event (LVGL_PORT_TRACE_BEGIN / END / INSTANT)
+ * @param arg0  Event argument
+ * @param arg1  Event argument
+ */
+void lvgl_port_trace_record(uint8_t event, uint8_t phase, uint32_t arg0, uint32_t arg1);
+
+/**
+ * @brief Record trace event, only one check when the trace is stopped
+ */
+#define LVGL_PORT_TRACE(event, phase, arg0, arg1) do { \
+        if (lvgl_port_trace_enabled) { \
+            lvgl_port_trace_record((event), (phase), (arg0), (arg1)); \
+        } \
+    } while (0)
+
+/**
+ * @brief Free trace buffer
+ *
+ * @note It is called from LVGL port deinit. Only with LVGL9.
+ */
+void lvgl_port_trace_deinit(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,115 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port software rotation
+ *
+ * Rotation is the same as in LVGL 9 (lv_draw_sw_rotate): for 90 degrees, pixel [x, y] of the area
+ * with width W is moved to [y, W - 1 - x].
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_lvgl_port_area.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Default size of the tile side in pixels (tile of source and destination should fit into the cache)
+ */
+#define LVGL_PORT_ROTATE_TILE   (32)
+
+/**
+ * @brief Rotation
+ */
+typedef enum {
+    LVGL_PORT_ROTATE_0 = 0,
+    LVGL_PORT_ROTATE_90,
+    LVGL_PORT_ROTATE_180,
+    LVGL_PORT_ROTATE_270,
+} lvgl_port_rotate_t;
+
+/**
+ * @brief Rotate RGB565 area
+ *
+ * Area is processed in square tiles, so the destination lines written by one tile stay in the cache.
+ *
+ * @param dst       Destination buffer (width h for 90/270, size w * h)
+ * @param src       Source buffer (width w)
+ * @param w         Source width in pixels
+ * @param h         Source height in pixels
+ * @param rotation  Rotation
+ * @param tile      Size of the tile side in pixels (LVGL_PORT_ROTATE_TILE recommended)
+ */
+void lvgl_port_rotate_rgb565(uint16_t *dst, const uint16_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile);
+
+/**
+ * @brief Rotate RGB888 area (3 bytes per pixel)
+ *
+ * @param dst       Destination buffer (width h for 90/270, size w * h * 3)
+ * @param src       Source buffer (width w)
+ * @param w         Source width in pixels
+ * @param h         Source height in pixels
+ * @param rotation  Rotation
+ * @param tile      Size of the tile side in pixels (LVGL_PORT_ROTATE_TILE recommended)
+ */
+void lvgl_port_rotate_rgb888(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile);
+
+/**
+ * @brief Rotate XRGB8888/ARGB8888 area
+ *
+ * @param dst       Destination buffer (width h for 90/270, size w * h)
+ * @param src       Source buffer (width w)
+ * @param w         Source width in pixels
+ * @param h         Source height in pixels
+ * @param rotation  Rotation
+ * @param tile      Size of the tile side in pixels (LVGL_PORT_ROTATE_TILE recommended)
+ */
+void lvgl_port_rotate_argb8888(uint32_t *dst, const uint32_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile);
+
+/**
+ * @brief Rotate area coordinates from rotated screen into the not rotated screen
+ *
+ * @param area      Area to be rotated (in place)
+ * @param hres      Horizontal resolution of the rotated screen
+ * @param vres      Vertical resolution of the rotated screen
+ * @param rotation  Rotation
+ */
+static inline void lvgl_port_rotate_area(lvgl_port_area_t *area, int32_t hres, int32_t vres, lvgl_port_rotate_t rotation)
+{
+    const lvgl_port_area_t a = *area;
+
+    switch (rotation) {
+    case LVGL_PORT_ROTATE_90:
+        area->x1 = a.y1;
+        area->x2 = a.y2;
+        area->y1 = hres - 1 - a.x2;
+        area->y2 = hres - 1 - a.x1;
+        break;
+    case LVGL_PORT_ROTATE_180:
+        area->x1 = hres - 1 - a.x2;
+        area->x2 = hres - 1 - a.x1;
+        area->y1 = vres - 1 - a.y2;
+        area->y2 = vres - 1 - a.y1;
+        break;
+    case LVGL_PORT_ROTATE_270:
+        area->x1 = vres - 1 - a.y2;
+        area->x2 = vres - 1 - a.y1;
+        area->y1 = a.x1;
+        area->y2 = a.x2;
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
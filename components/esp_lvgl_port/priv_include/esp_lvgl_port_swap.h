@@ -0,0 +1,36 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port RGB565 byte swapping
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Swap bytes in RGB565 pixels
+ *
+ * Pixels are processed in blocks by plain loops, which the compiler can vectorize. The same portable kernel is used
+ * on all targets, there is no ESP32-S3 PIE (SIMD) variant.
+ *
+ * @note Source and destination can be the same buffer (in-place swap), but must not partially overlap.
+ *
+ * @param dst   Destination buffer
+ * @param src   Source buffer
+ * @param len   Count of pixels
+ */
+void lvgl_port_rgb565_swap(uint16_t *dst, const uint16_t *src, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
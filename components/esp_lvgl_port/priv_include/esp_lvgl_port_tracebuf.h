@@ -0,0 +1,165 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port trace ring buffer
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Traced events
+ */
+typedef enum {
+    LVGL_PORT_TRACE_TIMER_HANDLER = 1,  /* lv_timer_handler (end: arg0 is time to the next timer in ms) */
+    LVGL_PORT_TRACE_FLUSH,              /* Flush of area (arg0: x1, y1, arg1: x2, y2 by LVGL_PORT_TRACE_XY) */
+    LVGL_PORT_TRACE_FLUSH_READY,        /* Transfer to display is done (DMA done interrupt) */
+    LVGL_PORT_TRACE_TOUCH_READ,         /* Read of touch controller (end: arg0 is count of touched points) */
+    LVGL_PORT_TRACE_LOCK,               /* LVGL mutex is held (outermost lock to the last unlock) */
+    LVGL_PORT_TRACE_EVENT,              /* Event posted to LVGL task (arg0: lvgl_port_event_type_t) */
+} lvgl_port_trace_event_t;
+
+/**
+ * @brief Phases of traced event (Chrome trace event phases)
+ */
+#define LVGL_PORT_TRACE_BEGIN   ('B')
+#define LVGL_PORT_TRACE_END     ('E')
+#define LVGL_PORT_TRACE_INSTANT ('i')
+
+/**
+ * @brief Pack two signed 16-bit coordinates into one argument
+ */
+#define LVGL_PORT_TRACE_XY(x, y)    ((uint32_t)(uint16_t)(x) | ((uint32_t)(uint16_t)(y) << 16))
+
+/**
+ * @brief One trace record
+ */
+typedef struct {
+    uint32_t ts;            /* Timestamp in microseconds (wraps after 71 minutes) */
+    uint32_t tid;           /* Task handle (0: interrupt) */
+    uint8_t event;          /* lvgl_port_trace_event_t */
+    uint8_t phase;          /* LVGL_PORT_TRACE_BEGIN / END / INSTANT */
+    uint32_t arg0;
+    uint32_t arg1;
+} lvgl_port_trace_entry_t;
+
+/**
+ * @brief Trace ring buffer, the newest records overwrite the oldest ones
+ */
+typedef struct {
+    uint32_t mask;          /* Count of records - 1 (count is power of two) */
+    _Atomic uint32_t head;  /* Count of all written records */
+    lvgl_port_trace_entry_t entries[];
+} lvgl_port_trace_ring_t;
+
+/**
+ * @brief Get memory size of trace ring buffer
+ *
+ * @param entries Count of records (rounded up to power of two)
+ * @return
+ *      - Size in bytes
+ */
+size_t lvgl_port_trace_ring_size(uint32_t entries);
+
+/**
+ * @brief Initialize trace ring buffer in memory of lvgl_port_trace_ring_size bytes
+ *
+ * @param mem       Memory for the ring buffer
+ * @param entries   Count of records (rounded up to power of two)
+ * @return
+ *      - Trace ring buffer
+ */
+lvgl_port_trace_ring_t *lvgl_port_trace_ring_init(void *mem, uint32_t entries);
+
+/**
+ * @brief Clear trace ring buffer
+ *
+ * @note Not safe against concurrent writers.
+ *
+ * @param ring Trace ring buffer
+ */
+void lvgl_port_trace_ring_clear(lvgl_port_trace_ring_t *ring);
+
+/**
+ * @brief Write record into trace ring buffer (multiple writers, wait-free, from interrupt too)
+ *
+ * @param ring  Trace ring buffer
+ * @param ts    Timestamp in microseconds
+ * @param tid   Task ID (0: interrupt)
+ * @param event Traced event
+ * @param phase Phase of traced event
+ * @param arg0  Event argument
+ * @param arg1  Event argument
+ */
+static inline __attribute__((always_inline)) void lvgl_port_trace_ring_put(lvgl_port_trace_ring_t *ring, uint32_t ts, uint32_t tid, uint8_t event, uint8_t phase, uint32_t arg0, uint32_t arg1)
+{
+    /* Each writer owns its record, readers stop writers before reading. Inlined into IRAM callers */
+    const uint32_t idx = atomic_fetch_add_explicit(&ring->head, 1, memory_order_relaxed);
+    lvgl_port_trace_entry_t *entry = &ring->entries[idx & ring->mask];
+    entry->ts = ts;
+    entry->tid = tid;
+    entry->event = event;
+    entry->phase = phase;
+    entry->arg0 = arg0;
+    entry->arg1 = arg1;
+}
+
+/**
+ * @brief Get the oldest record kept in trace ring buffer
+ *
+ * @param ring  Trace ring buffer
+ * @param count Output: count of kept records
+ * @return
+ *      - Index of the oldest record (records are read by lvgl_port_trace_ring_get with index up to index + count)
+ */
+uint32_t lvgl_port_trace_ring_first(lvgl_port_trace_ring_t *ring, uint32_t *count);
+
+/**
+ * @brief Get record of trace ring buffer
+ *
+ * @param ring  Trace ring buffer
+ * @param idx   Index of record (from lvgl_port_trace_ring_first)
+ * @return
+ *      - Record
+ */
+const lvgl_port_trace_entry_t *lvgl_port_trace_ring_get(const lvgl_port_trace_ring_t *ring, uint32_t idx);
+
+/**
+ * @brief Format record as Chrome trace event (JSON object)
+ *
+ * @param entry     Record
+ * @param ts_base   Timestamp of the trace start (timestamps are relative to it)
+ * @param buf       Output buffer
+ * @param len       Size of output buffer
+ * @return
+ *      - Length of the event (as snprintf), 0 if the record is not valid
+ */
+int lvgl_port_trace_format(const lvgl_port_trace_entry_t *entry, uint32_t ts_base, char *buf, size_t len);
+
+/**
+ * @brief Format thread name metadata as Chrome trace event (JSON object)
+ *
+ * @param tid   Task ID (0: interrupt)
+ * @param name  Name of the thread
+ * @param buf   Output buffer
+ * @param len   Size of output buffer
+ * @return
+ *      - Length of the event (as snprintf)
+ */
+int lvgl_port_trace_format_thread(uint32_t tid, const char *name, char *buf, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
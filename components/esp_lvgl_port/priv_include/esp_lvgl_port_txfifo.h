@@ -0,0 +1,80 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LVGL port transmit FIFO
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Alignment of allocations in transmit FIFO (DMA transfers)
+ */
+#define LVGL_PORT_TXFIFO_ALIGN  (4)
+
+/**
+ * @brief Transmit FIFO, contiguous blocks are allocated at the head and freed at the tail in the same order
+ *
+ * @note Allocation and free must be called from one task.
+ */
+typedef struct {
+    uint8_t *buf;       /* Memory of FIFO */
+    uint32_t size;      /* Size of memory in bytes */
+    uint32_t head;      /* Offset of the next allocation */
+    uint32_t tail;      /* Offset of the oldest allocation */
+    uint32_t end;       /* End of blocks before the head wrapped to the beginning (size: not wrapped) */
+    uint32_t count;     /* Count of allocated blocks */
+} lvgl_port_txfifo_t;
+
+/**
+ * @brief Initialize transmit FIFO
+ *
+ * @param fifo  Transmit FIFO
+ * @param buf   Memory of FIFO (aligned to LVGL_PORT_TXFIFO_ALIGN)
+ * @param size  Size of memory in bytes
+ */
+void lvgl_port_txfifo_init(lvgl_port_txfifo_t *fifo, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief Allocate contiguous block
+ *
+ * @note Block, which does not fit before the end of memory, is allocated from the beginning.
+ *
+ * @param fifo  Transmit FIFO
+ * @param len   Size of block in bytes
+ * @return
+ *      - Allocated block, NULL if there is not enough contiguous space now
+ */
+uint8_t *lvgl_port_txfifo_alloc(lvgl_port_txfifo_t *fifo, uint32_t len);
+
+/**
+ * @brief Free the oldest allocated block
+ *
+ * @param fifo  Transmit FIFO
+ * @param data  The oldest allocated block
+ * @param len   Size of block in bytes (the same as allocated)
+ */
+void lvgl_port_txfifo_free(lvgl_port_txfifo_t *fifo, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief Get bytes of allocated blocks
+ *
+ * @param fifo  Transmit FIFO
+ * @return
+ *      - Allocated bytes (rounded to LVGL_PORT_TXFIFO_ALIGN)
+ */
+uint32_t lvgl_port_txfifo_used(const lvgl_port_txfifo_t *fifo);
+
+#ifdef __cplusplus
+}
+#endif
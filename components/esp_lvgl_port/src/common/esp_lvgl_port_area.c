@@ -0,0 +1,150 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdbool.h>
+#include "esp_lvgl_port_area.h"
+
+/* Maximum count of areas handled in one pass (LVGL default LV_INV_BUF_SIZE is 32) */
+#define LVGL_PORT_AREA_COALESCE_MAX   (64)
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t lvgl_port_area_overlap(const lvgl_port_area_t *a, const lvgl_port_area_t *b);
+static void lvgl_port_area_join(lvgl_port_area_t *res, const lvgl_port_area_t *a, const lvgl_port_area_t *b);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+uint32_t lvgl_port_area_coalesce(lvgl_port_area_t *areas, uint8_t *joined, uint32_t count, uint32_t overdraw_pct, lvgl_port_area_result_t *result)
+{
+    /* Really invalidated pixels in each area (merged areas contain less than their bounding box) */
+    uint32_t useful[LVGL_PORT_AREA_COALESCE_MAX];
+    /* Area was enlarged by merging */
+    bool enlarged[LVGL_PORT_AREA_COALESCE_MAX];
+    uint32_t merged = 0;
+    uint32_t areas_in = 0;
+    uint64_t useful_sum = 0;
+
+    if (count > LVGL_PORT_AREA_COALESCE_MAX) {
+        count = LVGL_PORT_AREA_COALESCE_MAX;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        useful[i] = 0;
+        enlarged[i] = false;
+        if (!joined[i]) {
+            useful[i] = lvgl_port_area_get_size(&areas[i]);
+            useful_sum += useful[i];
+            areas_in++;
+        }
+    }
+
+    while (true) {
+        uint32_t best_i = 0;
+        uint32_t best_j = 0;
+        uint64_t best_cost = UINT64_MAX;
+        uint32_t best_useful = 0;
+        lvgl_port_area_t best_area = {0};
+
+        for (uint32_t j = 0; j < count; j++) {
+            if (joined[j]) {
+                continue;
+            }
+            for (uint32_t i = 0; i < j; i++) {
+                if (joined[i]) {
+                    continue;
+                }
+
+                lvgl_port_area_t tmp;
+                lvgl_port_area_join(&tmp, &areas[i], &areas[j]);
+
+                /* Overlapped part is counted only once */
+                uint32_t both = useful[i] + useful[j] - lvgl_port_area_overlap(&areas[i], &areas[j]);
+                if (both < useful[i] || both < useful[j]) {
+                    both = (useful[i] > useful[j] ? useful[i] : useful[j]);
+                }
+
+                const uint64_t size = lvgl_port_area_get_size(&tmp);
+                /* Merged area must fit into the overdraw budget */
+                if (size * 100 > (uint64_t)both * (100 + overdraw_pct)) {
+                    continue;
+                }
+
+                const uint64_t cost = size - both;
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_i = i;
+                    best_j = j;
+                    best_useful = both;
+                    best_area = tmp;
+                }
+            }
+        }
+
+        if (best_cost == UINT64_MAX) {
+            break;
+        }
+
+        /* Keep the merged area on the higher index */
+        areas[best_j] = best_area;
+        useful[best_j] = best_useful;
+        enlarged[best_j] = true;
+        joined[best_i] = 1;
+        useful[best_i] = 0;
+        merged++;
+    }
+
+    if (result) {
+        uint64_t out_sum = 0;
+        uint32_t areas_out = 0;
+        uint32_t untouched = 0;
+        for (uint32_t i = 0; i < count; i++) {
+            if (!joined[i]) {
+                out_sum += lvgl_port_area_get_size(&areas[i]);
+                areas_out++;
+                if (!enlarged[i]) {
+                    untouched++;
+                }
+            }
+        }
+        result->areas_in = areas_in;
+        result->areas_out = areas_out;
+        result->merged = merged;
+        result->unmerged = untouched;
+        result->overdraw_px = (out_sum > useful_sum ? (uint32_t)(out_sum - useful_sum) : 0);
+    }
+
+    return merged;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint32_t lvgl_port_area_overlap(const lvgl_port_area_t *a, const lvgl_port_area_t *b)
+{
+    const int32_t x1 = (a->x1 > b->x1 ? a->x1 : b->x1);
+    const int32_t y1 = (a->y1 > b->y1 ? a->y1 : b->y1);
+    const int32_t x2 = (a->x2 < b->x2 ? a->x2 : b->x2);
+    const int32_t y2 = (a->y2 < b->y2 ? a->y2 : b->y2);
+
+    if (x1 > x2 || y1 > y2) {
+        return 0;
+    }
+
+    return (uint32_t)(x2 - x1 + 1) * (uint32_t)(y2 - y1 + 1);
+}
+
+static void lvgl_port_area_join(lvgl_port_area_t *res, const lvgl_port_area_t *a, const lvgl_port_area_t *b)
+{
+    res->x1 = (a->x1 < b->x1 ? a->x1 : b->x1);
+    res->y1 = (a->y1 < b->y1 ? a->y1 : b->y1);
+    res->x2 = (a->x2 > b->x2 ? a->x2 : b->x2);
+    res->y2 = (a->y2 > b->y2 ? a->y2 : b->y2);
+}
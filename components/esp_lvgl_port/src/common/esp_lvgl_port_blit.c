@@ -0,0 +1,116 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_lvgl_port_blit.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static void lvgl_port_blit_point(const lvgl_port_blit_cfg_t *cfg, int32_t x, int32_t y, int32_t *out_x, int32_t *out_y);
+static inline uint32_t lvgl_port_blit_fb_width(const lvgl_port_blit_cfg_t *cfg);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_blit_get_area(const lvgl_port_blit_cfg_t *cfg, const lvgl_port_area_t *area, lvgl_port_area_t *out)
+{
+    int32_t x1, y1, x2, y2;
+
+    /* Linear mapping, opposite corners stay opposite */
+    lvgl_port_blit_point(cfg, area->x1, area->y1, &x1, &y1);
+    lvgl_port_blit_point(cfg, area->x2, area->y2, &x2, &y2);
+    out->x1 = (x1 < x2 ? x1 : x2);
+    out->x2 = (x1 < x2 ? x2 : x1);
+    out->y1 = (y1 < y2 ? y1 : y2);
+    out->y2 = (y1 < y2 ? y2 : y1);
+}
+
+void lvgl_port_blit_rgb565(const lvgl_port_blit_cfg_t *cfg, uint8_t *fb, const uint16_t *src, uint32_t src_stride, const lvgl_port_area_t *area)
+{
+    const int32_t fb_w = (int32_t)lvgl_port_blit_fb_width(cfg);
+    const uint32_t w = lvgl_port_area_get_width(area);
+    const uint32_t h = lvgl_port_area_get_height(area);
+    int32_t x, y;
+
+    /* Frame buffer index of pixel [x, y] of the area is origin + x * step_x + y * step_y */
+    lvgl_port_blit_point(cfg, area->x1, area->y1, &x, &y);
+    const int32_t origin = y * fb_w + x;
+    lvgl_port_blit_point(cfg, area->x1 + 1, area->y1, &x, &y);
+    const int32_t step_x = y * fb_w + x - origin;
+    lvgl_port_blit_point(cfg, area->x1, area->y1 + 1, &x, &y);
+    const int32_t step_y = y * fb_w + x - origin;
+
+    for (uint32_t ly = 0; ly < h; ly++) {
+        const uint16_t *in = src + ly * src_stride;
+        int32_t out = origin + (int32_t)ly * step_y;
+        for (uint32_t lx = 0; lx < w; lx++) {
+            uint16_t px = in[lx];
+            if (cfg->swap_bytes) {
+                px = (uint16_t)((px >> 8) | (px << 8));
+            }
+
+            if (cfg->rgb888) {
+                const uint8_t r = (px >> 11) & 0x1F;
+                const uint8_t g = (px >> 5) & 0x3F;
+                const uint8_t b = px & 0x1F;
+                uint8_t *dst = fb + out * 3;
+                dst[0] = (uint8_t)((b << 3) | (b >> 2));
+                dst[1] = (uint8_t)((g << 2) | (g >> 4));
+                dst[2] = (uint8_t)((r << 3) | (r >> 2));
+            } else {
+                ((uint16_t *)fb)[out] = px;
+            }
+            out += step_x;
+        }
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static inline uint32_t lvgl_port_blit_fb_width(const lvgl_port_blit_cfg_t *cfg)
+{
+    return (cfg->rotation == LVGL_PORT_ROTATE_90 || cfg->rotation == LVGL_PORT_ROTATE_270 ? cfg->vres : cfg->hres);
+}
+
+static void lvgl_port_blit_point(const lvgl_port_blit_cfg_t *cfg, int32_t x, int32_t y, int32_t *out_x, int32_t *out_y)
+{
+    const bool swap_xy = (cfg->rotation == LVGL_PORT_ROTATE_90 || cfg->rotation == LVGL_PORT_ROTATE_270);
+    const int32_t fb_w = (int32_t)(swap_xy ? cfg->vres : cfg->hres);
+    const int32_t fb_h = (int32_t)(swap_xy ? cfg->hres : cfg->vres);
+    int32_t ox = x;
+    int32_t oy = y;
+
+    switch (cfg->rotation) {
+    case LVGL_PORT_ROTATE_90:
+        ox = y;
+        oy = (int32_t)cfg->hres - 1 - x;
+        break;
+    case LVGL_PORT_ROTATE_180:
+        ox = (int32_t)cfg->hres - 1 - x;
+        oy = (int32_t)cfg->vres - 1 - y;
+        break;
+    case LVGL_PORT_ROTATE_270:
+        ox = (int32_t)cfg->vres - 1 - y;
+        oy = x;
+        break;
+    default:
+        break;
+    }
+
+    if (cfg->mirror_x) {
+        ox = fb_w - 1 - ox;
+    }
+    if (cfg->mirror_y) {
+        oy = fb_h - 1 - oy;
+    }
+
+    *out_x = ox;
+    *out_y = oy;
+}
@@ -0,0 +1,373 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "esp_lvgl_port_cmdq.h"
+
+#define LVGL_PORT_CMDQ_DEFAULT_SIZE     (32)
+#define LVGL_PORT_CMDQ_DEFAULT_DATA     (16)
+/* Alignment of parameter data in command slot */
+#define LVGL_PORT_CMDQ_ALIGN            (8)
+#define LVGL_PORT_CMDQ_ALIGN_UP(x)      (((x) + LVGL_PORT_CMDQ_ALIGN - 1) & ~(size_t)(LVGL_PORT_CMDQ_ALIGN - 1))
+#define LVGL_PORT_CMDQ_DATA_OFFSET      LVGL_PORT_CMDQ_ALIGN_UP(sizeof(lvgl_port_cmdq_slot_t))
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+/* Cell of bounded MPMC ring (D. Vyukov), seq tells whether the cell is free for push or pop of position */
+typedef struct {
+    _Atomic uint32_t seq;
+    uint32_t value;
+} lvgl_port_ring_cell_t;
+
+typedef struct {
+    lvgl_port_ring_cell_t *cells;
+    uint32_t mask;
+    _Atomic uint32_t head;      /* Next push position */
+    _Atomic uint32_t tail;      /* Next pop position */
+} lvgl_port_ring_t;
+
+/* Command slot, followed by parameter data (aligned) */
+typedef struct {
+    lvgl_port_cmd_cb_t cb;
+    void *user_data;
+    size_t len;
+} lvgl_port_cmdq_slot_t;
+
+struct lvgl_port_cmdq_s {
+    _Atomic uint32_t *free;             /* Bitmap of free slots */
+    uint32_t free_words;                /* Count of words in free bitmap */
+    lvgl_port_ring_t queue;             /* Indexes of queued slots in post order */
+    uint8_t *slots;                     /* Command slots */
+    size_t stride;                      /* Size of one slot with data */
+    size_t data_size;
+    uint32_t size;                      /* Count of slots */
+    lvgl_port_cmd_overflow_t overflow;
+    uint32_t merge_keys;
+    _Atomic uint32_t *mailbox;          /* Slot index + 1 of the newest command per key (0: empty) */
+    _Atomic uint32_t dirty;             /* Bitmask of keys with command in mailbox */
+    /* Statistics */
+    _Atomic uint32_t posted;
+    _Atomic uint32_t applied;
+    _Atomic uint32_t merged;
+    _Atomic uint32_t dropped;
+    _Atomic uint32_t depth;
+    _Atomic uint32_t max_depth;
+    uint32_t batches;                   /* Changed only by consumer */
+    uint32_t max_batch;                 /* Changed only by consumer */
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static bool lvgl_port_ring_init(lvgl_port_ring_t *ring, uint32_t size);
+static bool lvgl_port_ring_push(lvgl_port_ring_t *ring, uint32_t value);
+static bool lvgl_port_ring_pop(lvgl_port_ring_t *ring, uint32_t *value);
+static bool lvgl_port_cmdq_alloc(lvgl_port_cmdq_t *queue, uint32_t *idx, bool *dropped);
+static bool lvgl_port_cmdq_take_free(lvgl_port_cmdq_t *queue, uint32_t *idx);
+static void lvgl_port_cmdq_free(lvgl_port_cmdq_t *queue, uint32_t idx);
+static void lvgl_port_cmdq_apply(lvgl_port_cmdq_t *queue, uint32_t idx);
+
+static inline lvgl_port_cmdq_slot_t *lvgl_port_cmdq_slot(lvgl_port_cmdq_t *queue, uint32_t idx)
+{
+    return (lvgl_port_cmdq_slot_t *)(queue->slots + idx * queue->stride);
+}
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+lvgl_port_cmdq_t *lvgl_port_cmdq_create(const lvgl_port_cmd_queue_cfg_t *cfg)
+{
+    if (cfg->merge_keys > LVGL_PORT_CMD_MERGE_KEYS_MAX) {
+        return NULL;
+    }
+
+    lvgl_port_cmdq_t *queue = calloc(1, sizeof(lvgl_port_cmdq_t));
+    if (queue == NULL) {
+        return NULL;
+    }
+
+    /* Ring positions are masked, size must be power of two. The ring has twice more cells than slots,
+       so push fails only if more tasks were preempted between claiming and releasing a cell */
+    uint32_t size = 2;
+    while (size < (cfg->queue_size ? cfg->queue_size : LVGL_PORT_CMDQ_DEFAULT_SIZE)) {
+        size <<= 1;
+    }
+    queue->size = size;
+    queue->data_size = (cfg->data_size ? cfg->data_size : LVGL_PORT_CMDQ_DEFAULT_DATA);
+    queue->stride = LVGL_PORT_CMDQ_DATA_OFFSET + LVGL_PORT_CMDQ_ALIGN_UP(queue->data_size);
+    queue->overflow = cfg->overflow;
+    queue->merge_keys = cfg->merge_keys;
+
+    queue->slots = calloc(size, queue->stride);
+    queue->free_words = (size + 31) / 32;
+    queue->free = calloc(queue->free_words, sizeof(_Atomic uint32_t));
+    if (queue->slots == NULL || queue->free == NULL || !lvgl_port_ring_init(&queue->queue, size * 2)) {
+        goto err;
+    }
+    for (uint32_t i = 0; i < queue->free_words; i++) {
+        atomic_init(&queue->free[i], (size - i * 32 >= 32) ? UINT32_MAX : ((1u << (size - i * 32)) - 1));
+    }
+    if (queue->merge_keys) {
+        queue->mailbox = calloc(queue->merge_keys, sizeof(_Atomic uint32_t));
+        if (queue->mailbox == NULL) {
+            goto err;
+        }
+        for (uint32_t i = 0; i < queue->merge_keys; i++) {
+            atomic_init(&queue->mailbox[i], 0);
+        }
+    }
+    return queue;
+
+err:
+    lvgl_port_cmdq_delete(queue);
+    return NULL;
+}
+
+void lvgl_port_cmdq_delete(lvgl_port_cmdq_t *queue)
+{
+    if (queue == NULL) {
+        return;
+    }
+    free(queue->mailbox);
+    free(queue->free);
+    free(queue->queue.cells);
+    free(queue->slots);
+    free(queue);
+}
+
+lvgl_port_cmdq_result_t lvgl_port_cmdq_post(lvgl_port_cmdq_t *queue, uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len)
+{
+    uint32_t idx;
+    bool dropped = false;
+
+    atomic_fetch_add_explicit(&queue->posted, 1, memory_order_relaxed);
+    if (!lvgl_port_cmdq_alloc(queue, &idx, &dropped)) {
+        atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+        return LVGL_PORT_CMDQ_FULL;
+    }
+
+    lvgl_port_cmdq_slot_t *slot = lvgl_port_cmdq_slot(queue, idx);
+    slot->cb = cb;
+    slot->user_data = user_data;
+    slot->len = (data ? len : 0);
+    if (slot->len) {
+        memcpy((uint8_t *)slot + LVGL_PORT_CMDQ_DATA_OFFSET, data, len);
+    }
+
+    if (key == 0) {
+        if (!lvgl_port_ring_push(&queue->queue, idx)) {
+            /* Only when the ring is blocked by preempted tasks dropping the oldest commands */
+            lvgl_port_cmdq_free(queue, idx);
+            atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+            return LVGL_PORT_CMDQ_FULL;
+        }
+    } else {
+        /* The newest command wins, the replaced one is freed (release: slot is filled before publishing) */
+        const uint32_t old = atomic_exchange_explicit(&queue->mailbox[key - 1], idx + 1, memory_order_acq_rel);
+        if (old) {
+            lvgl_port_cmdq_free(queue, old - 1);
+            atomic_fetch_add_explicit(&queue->merged, 1, memory_order_relaxed);
+            return (dropped ? LVGL_PORT_CMDQ_DROPPED : LVGL_PORT_CMDQ_MERGED);
+        }
+        atomic_fetch_or_explicit(&queue->dirty, 1u << (key - 1), memory_order_release);
+    }
+
+    return (dropped ? LVGL_PORT_CMDQ_DROPPED : LVGL_PORT_CMDQ_POSTED);
+}
+
+uint32_t lvgl_port_cmdq_run(lvgl_port_cmdq_t *queue)
+{
+    uint32_t count = 0;
+    uint32_t idx;
+
+    /* Limited, callbacks can post new commands */
+    while (count < queue->size && lvgl_port_ring_pop(&queue->queue, &idx)) {
+        lvgl_port_cmdq_apply(queue, idx);
+        count++;
+    }
+
+    /* Merged commands, new ones posted meanwhile are applied in the next batch */
+    uint32_t keys = atomic_exchange_explicit(&queue->dirty, 0, memory_order_acquire);
+    while (keys) {
+        const uint32_t key = __builtin_ctz(keys);
+        keys &= keys - 1;
+        const uint32_t value = atomic_exchange_explicit(&queue->mailbox[key], 0, memory_order_acq_rel);
+        if (value) {
+            lvgl_port_cmdq_apply(queue, value - 1);
+            count++;
+        }
+    }
+
+    if (count) {
+        queue->batches++;
+        if (count > queue->max_batch) {
+            queue->max_batch = count;
+        }
+    }
+
+    return count;
+}
+
+void lvgl_port_cmdq_get_stats(lvgl_port_cmdq_t *queue, lvgl_port_cmd_stats_t *stats, bool reset)
+{
+    if (reset) {
+        stats->posted = atomic_exchange_explicit(&queue->posted, 0, memory_order_relaxed);
+        stats->applied = atomic_exchange_explicit(&queue->applied, 0, memory_order_relaxed);
+        stats->merged = atomic_exchange_explicit(&queue->merged, 0, memory_order_relaxed);
+        stats->dropped = atomic_exchange_explicit(&queue->dropped, 0, memory_order_relaxed);
+        stats->depth = atomic_load_explicit(&queue->depth, memory_order_relaxed);
+        stats->max_depth = atomic_exchange_explicit(&queue->max_depth, stats->depth, memory_order_relaxed);
+    } else {
+        stats->posted = atomic_load_explicit(&queue->posted, memory_order_relaxed);
+        stats->applied = atomic_load_explicit(&queue->applied, memory_order_relaxed);
+        stats->merged = atomic_load_explicit(&queue->merged, memory_order_relaxed);
+        stats->dropped = atomic_load_explicit(&queue->dropped, memory_order_relaxed);
+        stats->depth = atomic_load_explicit(&queue->depth, memory_order_relaxed);
+        stats->max_depth = atomic_load_explicit(&queue->max_depth, memory_order_relaxed);
+    }
+    /* Batch counters are changed by consumer only, they may be off by one batch when read from other task */
+    stats->batches = queue->batches;
+    stats->max_batch = queue->max_batch;
+    if (reset) {
+        queue->batches = 0;
+        queue->max_batch = 0;
+    }
+}
+
+size_t lvgl_port_cmdq_get_data_size(const lvgl_port_cmdq_t *queue)
+{
+    return queue->data_size;
+}
+
+uint32_t lvgl_port_cmdq_get_merge_keys(const lvgl_port_cmdq_t *queue)
+{
+    return queue->merge_keys;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static bool lvgl_port_ring_init(lvgl_port_ring_t *ring, uint32_t size)
+{
+    ring->cells = calloc(size, sizeof(lvgl_port_ring_cell_t));
+    if (ring->cells == NULL) {
+        return false;
+    }
+    ring->mask = size - 1;
+    for (uint32_t i = 0; i < size; i++) {
+        atomic_init(&ring->cells[i].seq, i);
+    }
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return true;
+}
+
+static bool lvgl_port_ring_push(lvgl_port_ring_t *ring, uint32_t value)
+{
+    uint32_t pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+
+    while (1) {
+        lvgl_port_ring_cell_t *cell = &ring->cells[pos & ring->mask];
+        const uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - pos);
+        if (diff == 0) {
+            /* Cell is free for this position, claim it */
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                cell->value = value;
+                atomic_store_explicit(&cell->seq, pos + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            /* Full */
+            return false;
+        } else {
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+}
+
+static bool lvgl_port_ring_pop(lvgl_port_ring_t *ring, uint32_t *value)
+{
+    uint32_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+
+    while (1) {
+        lvgl_port_ring_cell_t *cell = &ring->cells[pos & ring->mask];
+        const uint32_t seq = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        const int32_t diff = (int32_t)(seq - (pos + 1));
+        if (diff == 0) {
+            /* Cell is filled for this position, claim it */
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                *value = cell->value;
+                atomic_store_explicit(&cell->seq, pos + ring->mask + 1, memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            /* Empty */
+            return false;
+        } else {
+            pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+}
+
+static bool lvgl_port_cmdq_alloc(lvgl_port_cmdq_t *queue, uint32_t *idx, bool *dropped)
+{
+    if (!lvgl_port_cmdq_take_free(queue, idx)) {
+        /* The oldest queued command gives its slot (merged commands are never dropped) */
+        if (queue->overflow != LVGL_PORT_CMD_OVERFLOW_DROP_OLDEST || !lvgl_port_ring_pop(&queue->queue, idx)) {
+            return false;
+        }
+        atomic_fetch_add_explicit(&queue->dropped, 1, memory_order_relaxed);
+        *dropped = true;
+        return true;
+    }
+
+    /* Depth is count of used slots */
+    const uint32_t depth = atomic_fetch_add_explicit(&queue->depth, 1, memory_order_relaxed) + 1;
+    uint32_t max = atomic_load_explicit(&queue->max_depth, memory_order_relaxed);
+    while (depth > max && !atomic_compare_exchange_weak_explicit(&queue->max_depth, &max, depth, memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return true;
+}
+
+static bool lvgl_port_cmdq_take_free(lvgl_port_cmdq_t *queue, uint32_t *idx)
+{
+    for (uint32_t i = 0; i < queue->free_words; i++) {
+        uint32_t bits = atomic_load_explicit(&queue->free[i], memory_order_relaxed);
+        /* Failed exchange reloads bits */
+        while (bits) {
+            const uint32_t bit = __builtin_ctz(bits);
+            if (atomic_compare_exchange_weak_explicit(&queue->free[i], &bits, bits & ~(1u << bit), memory_order_acquire, memory_order_relaxed)) {
+                *idx = i * 32 + bit;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void lvgl_port_cmdq_free(lvgl_port_cmdq_t *queue, uint32_t idx)
+{
+    atomic_fetch_sub_explicit(&queue->depth, 1, memory_order_relaxed);
+    /* Release: slot is not used after this */
+    atomic_fetch_or_explicit(&queue->free[idx / 32], 1u << (idx % 32), memory_order_release);
+}
+
+static void lvgl_port_cmdq_apply(lvgl_port_cmdq_t *queue, uint32_t idx)
+{
+    lvgl_port_cmdq_slot_t *slot = lvgl_port_cmdq_slot(queue, idx);
+
+    slot->cb(slot->user_data, slot->len ? (const void *)((uint8_t *)slot + LVGL_PORT_CMDQ_DATA_OFFSET) : NULL, slot->len);
+    atomic_fetch_add_explicit(&queue->applied, 1, memory_order_relaxed);
+    lvgl_port_cmdq_free(queue, idx);
+}
@@ -0,0 +1,205 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <math.h>
+#include "esp_lvgl_port_gesture.h"
+
+#define LVGL_PORT_GESTURE_PI    (3.14159265f)
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+
+static const lvgl_port_gesture_cfg_t lvgl_port_gesture_default_cfg = {
+    .track_dist = 80,
+    .pinch_permille = 100,
+    .rotate_decideg = 100,
+    .scroll_dist = 20,
+};
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint8_t lvgl_port_gesture_new_id(lvgl_port_gesture_tracker_t *tracker, const lvgl_port_gesture_point_t *points, uint8_t cnt);
+static void lvgl_port_gesture_two_fingers(lvgl_port_gesture_tracker_t *tracker);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_gesture_init(lvgl_port_gesture_tracker_t *tracker, const lvgl_port_gesture_cfg_t *cfg)
+{
+    memset(tracker, 0, sizeof(lvgl_port_gesture_tracker_t));
+    tracker->cfg = (cfg ? *cfg : lvgl_port_gesture_default_cfg);
+    tracker->gesture.scale = 1.0f;
+}
+
+uint8_t lvgl_port_gesture_update(lvgl_port_gesture_tracker_t *tracker, const uint16_t *x, const uint16_t *y, uint8_t cnt,
+                                 lvgl_port_gesture_point_t *out)
+{
+    lvgl_port_gesture_point_t points[LVGL_PORT_GESTURE_POINTS_MAX];
+    int8_t match[LVGL_PORT_GESTURE_POINTS_MAX];
+    bool taken[LVGL_PORT_GESTURE_POINTS_MAX] = {0};
+    const uint64_t max_dist2 = (uint64_t)tracker->cfg.track_dist * tracker->cfg.track_dist;
+    uint8_t pressed = 0;
+    uint8_t n = 0;
+
+    if (cnt > LVGL_PORT_GESTURE_POINTS_MAX) {
+        cnt = LVGL_PORT_GESTURE_POINTS_MAX;
+    }
+
+    /* Match the closest pair first, until there is no pair within track_dist (at most 10x10 pairs) */
+    memset(match, -1, sizeof(match));
+    while (true) {
+        uint64_t best = UINT64_MAX;
+        int best_old = -1;
+        int best_new = -1;
+        for (int i = 0; i < tracker->count; i++) {
+            if (match[i] >= 0) {
+                continue;
+            }
+            for (int j = 0; j < cnt; j++) {
+                if (taken[j]) {
+                    continue;
+                }
+                const int64_t dx = (int64_t)x[j] - tracker->points[i].x;
+                const int64_t dy = (int64_t)y[j] - tracker->points[i].y;
+                const uint64_t dist2 = (uint64_t)(dx * dx + dy * dy);
+                if (dist2 <= max_dist2 && dist2 < best) {
+                    best = dist2;
+                    best_old = i;
+                    best_new = j;
+                }
+            }
+        }
+        if (best_old < 0) {
+            break;
+        }
+        match[best_old] = best_new;
+        taken[best_new] = true;
+    }
+
+    /* Moved points keep their order and ID, new points are added after them */
+    for (int i = 0; i < tracker->count; i++) {
+        if (match[i] >= 0) {
+            points[pressed].x = x[match[i]];
+            points[pressed].y = y[match[i]];
+            points[pressed].id = tracker->points[i].id;
+            points[pressed].pressed = true;
+            pressed++;
+        }
+    }
+    for (int j = 0; j < cnt; j++) {
+        if (!taken[j]) {
+            points[pressed].x = x[j];
+            points[pressed].y = y[j];
+            points[pressed].id = lvgl_port_gesture_new_id(tracker, points, pressed);
+            points[pressed].pressed = true;
+            pressed++;
+        }
+    }
+
+    memcpy(out, points, pressed * sizeof(lvgl_port_gesture_point_t));
+    n = pressed;
+    for (int i = 0; i < tracker->count; i++) {
+        if (match[i] < 0) {
+            out[n] = tracker->points[i];
+            out[n].pressed = false;
+            n++;
+        }
+    }
+
+    memcpy(tracker->points, points, pressed * sizeof(lvgl_port_gesture_point_t));
+    tracker->count = pressed;
+    lvgl_port_gesture_two_fingers(tracker);
+
+    return n;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint8_t lvgl_port_gesture_new_id(lvgl_port_gesture_tracker_t *tracker, const lvgl_port_gesture_point_t *points, uint8_t cnt)
+{
+    /* IDs of previous points (also released in this read) and of new points are skipped, at most 20 of 256 are used */
+    while (true) {
+        const uint8_t id = tracker->next_id++;
+        bool used = false;
+        for (int i = 0; i < tracker->count && !used; i++) {
+            used = (tracker->points[i].id == id);
+        }
+        for (int i = 0; i < cnt && !used; i++) {
+            used = (points[i].id == id);
+        }
+        if (!used) {
+            return id;
+        }
+    }
+}
+
+static void lvgl_port_gesture_two_fingers(lvgl_port_gesture_tracker_t *tracker)
+{
+    lvgl_port_gesture_t *gesture = &tracker->gesture;
+
+    /* Gesture ends with release or a third finger, the last values are kept */
+    if (tracker->count != 2) {
+        gesture->active = false;
+        return;
+    }
+
+    const lvgl_port_gesture_point_t *a = &tracker->points[0];
+    const lvgl_port_gesture_point_t *b = &tracker->points[1];
+    const float dx = (float)(b->x - a->x);
+    const float dy = (float)(b->y - a->y);
+    const float dist = sqrtf(dx * dx + dy * dy);
+    const float angle = atan2f(dy, dx);
+    const int32_t center_x = (a->x + b->x) / 2;
+    const int32_t center_y = (a->y + b->y) / 2;
+
+    if (!gesture->active || tracker->start.id[0] != a->id || tracker->start.id[1] != b->id) {
+        tracker->start.id[0] = a->id;
+        tracker->start.id[1] = b->id;
+        tracker->start.dist = dist;
+        tracker->start.angle = angle;
+        tracker->start.center_x = center_x;
+        tracker->start.center_y = center_y;
+        memset(gesture, 0, sizeof(lvgl_port_gesture_t));
+        gesture->active = true;
+        gesture->scale = 1.0f;
+        gesture->center_x = center_x;
+        gesture->center_y = center_y;
+        return;
+    }
+
+    float rotation = angle - tracker->start.angle;
+    if (rotation > LVGL_PORT_GESTURE_PI) {
+        rotation -= 2 * LVGL_PORT_GESTURE_PI;
+    } else if (rotation < -LVGL_PORT_GESTURE_PI) {
+        rotation += 2 * LVGL_PORT_GESTURE_PI;
+    }
+
+    /* Fingers pressed at the same position have no start distance, scale is not known */
+    gesture->scale = (tracker->start.dist >= 1.0f ? dist / tracker->start.dist : 1.0f);
+    gesture->rotation = rotation * 180.0f / LVGL_PORT_GESTURE_PI;
+    gesture->scroll_x = center_x - tracker->start.center_x;
+    gesture->scroll_y = center_y - tracker->start.center_y;
+    gesture->center_x = center_x;
+    gesture->center_y = center_y;
+
+    if (fabsf(gesture->scale - 1.0f) * 1000.0f >= tracker->cfg.pinch_permille) {
+        gesture->recognized |= LVGL_PORT_GESTURE_PINCH;
+    }
+    if (fabsf(gesture->rotation) * 10.0f >= tracker->cfg.rotate_decideg) {
+        gesture->recognized |= LVGL_PORT_GESTURE_ROTATE;
+    }
+    const uint64_t scroll2 = (uint64_t)((int64_t)gesture->scroll_x * gesture->scroll_x + (int64_t)gesture->scroll_y * gesture->scroll_y);
+    if (scroll2 >= (uint64_t)tracker->cfg.scroll_dist * tracker->cfg.scroll_dist) {
+        gesture->recognized |= LVGL_PORT_GESTURE_SCROLL;
+    }
+}
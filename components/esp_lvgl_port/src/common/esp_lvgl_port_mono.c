@@ -0,0 +1,124 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_lvgl_port_mono.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static inline uint64_t lvgl_port_mono_transpose8(uint64_t x);
+static inline uint8_t lvgl_port_mono_reverse8(uint8_t b);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_mono_rgb565_to_pages(uint8_t *dst, const uint16_t *src, uint32_t src_w, uint32_t src_h)
+{
+    for (uint32_t page_y = 0; page_y < src_h; page_y += 8) {
+        const uint32_t lines = (src_h - page_y < 8 ? src_h - page_y : 8);
+
+        /* Source is read line by line, whole page (src_w bytes) stays in cache */
+        for (uint32_t x = 0; x < src_w; x++) {
+            dst[x] = (uint8_t)!LVGL_PORT_MONO_RGB565_LIGHT(src[x]);
+        }
+        src += src_w;
+        for (uint32_t bit = 1; bit < lines; bit++) {
+            /* Without branches, the loop can be vectorized */
+            for (uint32_t x = 0; x < src_w; x++) {
+                dst[x] |= (uint8_t)(!LVGL_PORT_MONO_RGB565_LIGHT(src[x]) << bit);
+            }
+            src += src_w;
+        }
+        dst += src_w;
+    }
+}
+
+void lvgl_port_mono_rgb565_to_pages_swap_xy(uint8_t *dst, const uint16_t *src, uint32_t src_w, uint32_t src_h)
+{
+    /* Destination is src_h wide, every page contains 8 source columns */
+    for (uint32_t page_x = 0; page_x < src_w; page_x += 8) {
+        const uint32_t cols = (src_w - page_x < 8 ? src_w - page_x : 8);
+        const uint16_t *line = src + page_x;
+
+        for (uint32_t y = 0; y < src_h; y++) {
+            uint8_t out = 0;
+            for (uint32_t bit = 0; bit < cols; bit++) {
+                out |= (uint8_t)(!LVGL_PORT_MONO_RGB565_LIGHT(line[bit]) << bit);
+            }
+            *dst++ = out;
+            line += src_w;
+        }
+    }
+}
+
+void lvgl_port_mono_i1_to_pages(uint8_t *dst, const uint8_t *src, uint32_t src_stride, uint32_t src_w, uint32_t src_h)
+{
+    for (uint32_t page_y = 0; page_y < src_h; page_y += 8) {
+        const uint32_t lines = (src_h - page_y < 8 ? src_h - page_y : 8);
+
+        for (uint32_t bx = 0; bx < src_stride && bx * 8 < src_w; bx++) {
+            const uint32_t cols = (src_w - bx * 8 < 8 ? src_w - bx * 8 : 8);
+            const uint8_t *in = src + bx;
+
+            /* Line N is byte N, missing lines are light */
+            uint64_t block = UINT64_MAX;
+            for (uint32_t line = 0; line < lines; line++) {
+                block &= ~((uint64_t)(uint8_t)~in[line * src_stride] << (line * 8));
+            }
+
+            /* After transposition, byte N contains column 7-N (MSB is the left pixel) */
+            block = ~lvgl_port_mono_transpose8(block);
+            for (uint32_t col = 0; col < cols; col++) {
+                *dst++ = (uint8_t)(block >> ((7 - col) * 8));
+            }
+        }
+        src += src_stride * lines;
+    }
+}
+
+void lvgl_port_mono_i1_to_pages_swap_xy(uint8_t *dst, const uint8_t *src, uint32_t src_stride, uint32_t src_w, uint32_t src_h)
+{
+    /* Destination is src_h wide, every page is one source byte column */
+    for (uint32_t bx = 0; bx < src_stride && bx * 8 < src_w; bx++) {
+        const uint32_t cols = (src_w - bx * 8 < 8 ? src_w - bx * 8 : 8);
+        const uint8_t mask = (uint8_t)(0xFF >> (8 - cols));
+        const uint8_t *in = src + bx;
+
+        for (uint32_t y = 0; y < src_h; y++) {
+            *dst++ = (uint8_t)~lvgl_port_mono_reverse8(*in) & mask;
+            in += src_stride;
+        }
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Transpose 8x8 bit matrix, byte N is line N and bit M is column M (Hacker's Delight, 7-3) */
+static inline uint64_t lvgl_port_mono_transpose8(uint64_t x)
+{
+    uint64_t t;
+
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+
+    return x;
+}
+
+static inline uint8_t lvgl_port_mono_reverse8(uint8_t b)
+{
+    b = (uint8_t)((b & 0xF0) >> 4 | (b & 0x0F) << 4);
+    b = (uint8_t)((b & 0xCC) >> 2 | (b & 0x33) << 2);
+    b = (uint8_t)((b & 0xAA) >> 1 | (b & 0x55) << 1);
+    return b;
+}
@@ -0,0 +1,87 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_lvgl_port_rotate.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static inline void lvgl_port_rotate_tiled(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile, const uint32_t px_size) __attribute__((always_inline));
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_rotate_rgb565(uint16_t *dst, const uint16_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile)
+{
+    lvgl_port_rotate_tiled((uint8_t *)dst, (const uint8_t *)src, w, h, rotation, tile, sizeof(uint16_t));
+}
+
+void lvgl_port_rotate_rgb888(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile)
+{
+    lvgl_port_rotate_tiled(dst, src, w, h, rotation, tile, 3);
+}
+
+void lvgl_port_rotate_argb8888(uint32_t *dst, const uint32_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile)
+{
+    lvgl_port_rotate_tiled((uint8_t *)dst, (const uint8_t *)src, w, h, rotation, tile, sizeof(uint32_t));
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Pixel size is constant after inlining, so the copy of one pixel is only load and store */
+static inline void lvgl_port_rotate_tiled(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t tile, const uint32_t px_size)
+{
+    /* Destination index of pixel [x, y] is origin + x * step_x + y * step_y */
+    int32_t origin;
+    int32_t step_x;
+    int32_t step_y;
+
+    switch (rotation) {
+    case LVGL_PORT_ROTATE_90:
+        origin = (int32_t)((w - 1) * h);
+        step_x = -(int32_t)h;
+        step_y = 1;
+        break;
+    case LVGL_PORT_ROTATE_180:
+        origin = (int32_t)(w * h - 1);
+        step_x = -1;
+        step_y = -(int32_t)w;
+        break;
+    case LVGL_PORT_ROTATE_270:
+        origin = (int32_t)(h - 1);
+        step_x = (int32_t)h;
+        step_y = -1;
+        break;
+    default:
+        memcpy(dst, src, w * h * px_size);
+        return;
+    }
+
+    if (tile == 0) {
+        tile = LVGL_PORT_ROTATE_TILE;
+    }
+
+    for (uint32_t ty = 0; ty < h; ty += tile) {
+        const uint32_t ty2 = (ty + tile < h ? ty + tile : h);
+        for (uint32_t tx = 0; tx < w; tx += tile) {
+            const uint32_t tx2 = (tx + tile < w ? tx + tile : w);
+            for (uint32_t y = ty; y < ty2; y++) {
+                const uint8_t *in = src + (y * w + tx) * px_size;
+                int32_t out = origin + (int32_t)tx * step_x + (int32_t)y * step_y;
+                for (uint32_t x = tx; x < tx2; x++) {
+                    memcpy(dst + out * (int32_t)px_size, in, px_size);
+                    in += px_size;
+                    out += step_x;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_lvgl_port_stats.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t lvgl_port_stats_div10(uint64_t value, uint64_t divider);
+static bool lvgl_port_lock_stats_worse(const lvgl_port_lock_task_stats_t *a, const lvgl_port_lock_task_stats_t *b);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_stats_add_latency(lvgl_port_disp_stats_t *stats, uint32_t latency_us)
+{
+    uint32_t bucket = 0;
+
+    /* Bucket i: latency < 2^i ms */
+    while (bucket < LVGL_PORT_STATS_LATENCY_BUCKETS - 1 && latency_us >= (1000u << bucket)) {
+        bucket++;
+    }
+
+    stats->latency_hist[bucket]++;
+    stats->latency_sum_us += latency_us;
+    if (latency_us > stats->latency_max_us) {
+        stats->latency_max_us = latency_us;
+    }
+}
+
+int lvgl_port_stats_format(const lvgl_port_disp_stats_t *stats, char *buf, size_t len)
+{
+    uint32_t latencies = 0;
+    for (int i = 0; i < LVGL_PORT_STATS_LATENCY_BUCKETS; i++) {
+        latencies += stats->latency_hist[i];
+    }
+
+    /* Values with one decimal place are multiplied by 10 (printing of floats is not always available) */
+    const uint32_t fps = lvgl_port_stats_div10(stats->frames * 1000000ULL, stats->elapsed_us);
+    const uint32_t areas = lvgl_port_stats_div10(stats->areas, stats->frames);
+    const uint32_t render = lvgl_port_stats_div10(stats->render_us, stats->frames * 1000ULL);
+    const uint32_t wait = lvgl_port_stats_div10(stats->flush_wait_us, stats->frames * 1000ULL);
+    /* Bytes per microsecond are MB/s */
+    const uint32_t bus = lvgl_port_stats_div10(stats->bytes, stats->bus_busy_us);
+    const uint32_t busy = (stats->elapsed_us ? (uint32_t)(stats->bus_busy_us * 100 / stats->elapsed_us) : 0);
+    const uint32_t latency_avg = lvgl_port_stats_div10(stats->latency_sum_us, latencies * 1000ULL);
+    const uint32_t latency_max = lvgl_port_stats_div10(stats->latency_max_us, 1000);
+
+    return snprintf(buf, len, "frames %" PRIu32 " (%" PRIu32 ".%" PRIu32 " fps), areas %" PRIu32 ".%" PRIu32 "/frame, px %" PRIu32 "/frame, "
+                    "render %" PRIu32 ".%" PRIu32 " ms/frame, wait %" PRIu32 ".%" PRIu32 " ms/frame, bus %" PRIu32 ".%" PRIu32 " MB/s (%" PRIu32 "%% busy), "
+                    "latency avg %" PRIu32 ".%" PRIu32 " ms max %" PRIu32 ".%" PRIu32 " ms, hist %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32 " %" PRIu32,
+                    stats->frames, fps / 10, fps % 10, areas / 10, areas % 10, (uint32_t)(stats->frames ? stats->pixels / stats->frames : 0),
+                    render / 10, render % 10, wait / 10, wait % 10, bus / 10, bus % 10, busy,
+                    latency_avg / 10, latency_avg % 10, latency_max / 10, latency_max % 10,
+                    stats->latency_hist[0], stats->latency_hist[1], stats->latency_hist[2], stats->latency_hist[3],
+                    stats->latency_hist[4], stats->latency_hist[5], stats->latency_hist[6], stats->latency_hist[7]);
+}
+
+int lvgl_port_lock_stats_task(lvgl_port_lock_stats_t *stats, const void *task, const char *name)
+{
+    for (uint32_t i = 0; i < stats->task_cnt; i++) {
+        if (stats->tasks[i].task == task) {
+            return i;
+        }
+    }
+
+    if (stats->task_cnt >= LVGL_PORT_LOCK_STATS_TASKS) {
+        stats->dropped++;
+        return -1;
+    }
+
+    lvgl_port_lock_task_stats_t *entry = &stats->tasks[stats->task_cnt];
+    memset(entry, 0, sizeof(lvgl_port_lock_task_stats_t));
+    entry->task = task;
+    if (name) {
+        strncpy(entry->name, name, sizeof(entry->name) - 1);
+    }
+    return stats->task_cnt++;
+}
+
+void lvgl_port_lock_stats_add_wait(lvgl_port_lock_stats_t *stats, int idx, uint32_t wait_us, bool locked, int owner, bool lvgl_task)
+{
+    if (idx < 0 || (uint32_t)idx >= stats->task_cnt) {
+        return;
+    }
+
+    lvgl_port_lock_task_stats_t *entry = &stats->tasks[idx];
+    entry->waits++;
+    entry->wait_us += wait_us;
+    if (wait_us > entry->wait_max_us) {
+        entry->wait_max_us = wait_us;
+    }
+    if (!locked) {
+        entry->timeouts++;
+    }
+
+    /* LVGL task waiting for another task means delayed frame, it is blamed on the owner */
+    if (lvgl_task && owner != idx) {
+        stats->starved++;
+        stats->starved_us += wait_us;
+        if (owner >= 0 && (uint32_t)owner < stats->task_cnt) {
+            stats->tasks[owner].starved++;
+            stats->tasks[owner].starved_us += wait_us;
+        }
+    }
+}
+
+void lvgl_port_lock_stats_add_hold(lvgl_port_lock_stats_t *stats, int idx, uint32_t hold_us, const void *caller)
+{
+    if (idx < 0 || (uint32_t)idx >= stats->task_cnt) {
+        return;
+    }
+
+    lvgl_port_lock_task_stats_t *entry = &stats->tasks[idx];
+    entry->locks++;
+    entry->hold_us += hold_us;
+    if (hold_us >= entry->hold_max_us) {
+        entry->hold_max_us = hold_us;
+        entry->hold_max_caller = caller;
+    }
+}
+
+void lvgl_port_lock_stats_sort(lvgl_port_lock_stats_t *stats)
+{
+    /* Insertion sort, the table is small */
+    for (uint32_t i = 1; i < stats->task_cnt; i++) {
+        const lvgl_port_lock_task_stats_t entry = stats->tasks[i];
+        uint32_t j = i;
+        while (j > 0 && lvgl_port_lock_stats_worse(&entry, &stats->tasks[j - 1])) {
+            stats->tasks[j] = stats->tasks[j - 1];
+            j--;
+        }
+        stats->tasks[j] = entry;
+    }
+}
+
+int lvgl_port_lock_stats_format(const lvgl_port_lock_task_stats_t *task, uint64_t elapsed_us, char *buf, size_t len)
+{
+    const uint32_t wait = lvgl_port_stats_div10(task->wait_us, 1000);
+    const uint32_t wait_max = lvgl_port_stats_div10(task->wait_max_us, 1000);
+    const uint32_t hold = lvgl_port_stats_div10(task->hold_us, 1000);
+    const uint32_t hold_max = lvgl_port_stats_div10(task->hold_max_us, 1000);
+    const uint32_t busy = (elapsed_us ? (uint32_t)(task->hold_us * 100 / elapsed_us) : 0);
+    const uint32_t starved = lvgl_port_stats_div10(task->starved_us, 1000);
+
+    return snprintf(buf, len, "%s: locks %" PRIu32 ", wait %" PRIu32 ".%" PRIu32 " ms (max %" PRIu32 ".%" PRIu32 " ms, %" PRIu32 " timeouts), "
+                    "hold %" PRIu32 ".%" PRIu32 " ms (%" PRIu32 "%%, max %" PRIu32 ".%" PRIu32 " ms at %p), starved LVGL %" PRIu32 " times %" PRIu32 ".%" PRIu32 " ms",
+                    task->name, task->locks, wait / 10, wait % 10, wait_max / 10, wait_max % 10, task->timeouts,
+                    hold / 10, hold % 10, busy, hold_max / 10, hold_max % 10, task->hold_max_caller,
+                    task->starved, starved / 10, starved % 10);
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+/* Rounded value * 10 / divider, zero for empty divider */
+static uint32_t lvgl_port_stats_div10(uint64_t value, uint64_t divider)
+{
+    if (divider == 0) {
+        return 0;
+    }
+    return (uint32_t)((value * 10 + divider / 2) / divider);
+}
+
+/* Task a hurts LVGL more than task b */
+static bool lvgl_port_lock_stats_worse(const lvgl_port_lock_task_stats_t *a, const lvgl_port_lock_task_stats_t *b)
+{
+    if (a->starved_us != b->starved_us) {
+        return a->starved_us > b->starved_us;
+    }
+    return a->hold_us > b->hold_us;
+}
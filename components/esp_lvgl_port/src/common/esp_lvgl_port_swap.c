@@ -0,0 +1,35 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_lvgl_port_swap.h"
+
+/* Pixels in one block, loops with fixed count are vectorized by the compiler also with its cheap cost model (-O2) */
+#define LVGL_PORT_SWAP_BLOCK_PX     (16)
+
+#define LVGL_PORT_SWAP_PIXEL(p)     ((uint16_t)(((p) << 8) | ((p) >> 8)))
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_rgb565_swap(uint16_t *dst, const uint16_t *src, uint32_t len)
+{
+    uint16_t block[LVGL_PORT_SWAP_BLOCK_PX];
+
+    /* Whole block is read before it is written, so buffers can be the same without runtime check of overlapping */
+    for (; len >= LVGL_PORT_SWAP_BLOCK_PX; len -= LVGL_PORT_SWAP_BLOCK_PX, dst += LVGL_PORT_SWAP_BLOCK_PX, src += LVGL_PORT_SWAP_BLOCK_PX) {
+        for (uint32_t i = 0; i < LVGL_PORT_SWAP_BLOCK_PX; i++) {
+            block[i] = LVGL_PORT_SWAP_PIXEL(src[i]);
+        }
+        for (uint32_t i = 0; i < LVGL_PORT_SWAP_BLOCK_PX; i++) {
+            dst[i] = block[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i] = LVGL_PORT_SWAP_PIXEL(src[i]);
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_lvgl_port_tracebuf.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint32_t lvgl_port_trace_round_entries(uint32_t entries);
+static const char *lvgl_port_trace_event_name(uint8_t event);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+size_t lvgl_port_trace_ring_size(uint32_t entries)
+{
+    return sizeof(lvgl_port_trace_ring_t) + lvgl_port_trace_round_entries(entries) * sizeof(lvgl_port_trace_entry_t);
+}
+
+lvgl_port_trace_ring_t *lvgl_port_trace_ring_init(void *mem, uint32_t entries)
+{
+    lvgl_port_trace_ring_t *ring = (lvgl_port_trace_ring_t *)mem;
+
+    ring->mask = lvgl_port_trace_round_entries(entries) - 1;
+    atomic_init(&ring->head, 0);
+
+    return ring;
+}
+
+void lvgl_port_trace_ring_clear(lvgl_port_trace_ring_t *ring)
+{
+    atomic_store_explicit(&ring->head, 0, memory_order_relaxed);
+}
+
+uint32_t lvgl_port_trace_ring_first(lvgl_port_trace_ring_t *ring, uint32_t *count)
+{
+    const uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    /* Older records were overwritten */
+    *count = (head > ring->mask + 1 ? ring->mask + 1 : head);
+    return head - *count;
+}
+
+const lvgl_port_trace_entry_t *lvgl_port_trace_ring_get(const lvgl_port_trace_ring_t *ring, uint32_t idx)
+{
+    return &ring->entries[idx & ring->mask];
+}
+
+int lvgl_port_trace_format(const lvgl_port_trace_entry_t *entry, uint32_t ts_base, char *buf, size_t len)
+{
+    char args[64] = "";
+
+    /* Record overwritten while it was read */
+    if (entry->phase != LVGL_PORT_TRACE_BEGIN && entry->phase != LVGL_PORT_TRACE_END && entry->phase != LVGL_PORT_TRACE_INSTANT) {
+        buf[0] = '\0';
+        return 0;
+    }
+
+    switch (entry->event) {
+    case LVGL_PORT_TRACE_TIMER_HANDLER:
+        if (entry->phase == LVGL_PORT_TRACE_END) {
+            snprintf(args, sizeof(args), ",\"args\":{\"next_ms\":%" PRIu32 "}", entry->arg0);
+        }
+        break;
+    case LVGL_PORT_TRACE_FLUSH:
+        snprintf(args, sizeof(args), ",\"args\":{\"x1\":%d,\"y1\":%d,\"x2\":%d,\"y2\":%d}",
+                 (int16_t)(entry->arg0 & 0xffff), (int16_t)(entry->arg0 >> 16), (int16_t)(entry->arg1 & 0xffff), (int16_t)(entry->arg1 >> 16));
+        break;
+    case LVGL_PORT_TRACE_TOUCH_READ:
+        if (entry->phase == LVGL_PORT_TRACE_END) {
+            snprintf(args, sizeof(args), ",\"args\":{\"points\":%" PRIu32 "}", entry->arg0);
+        }
+        break;
+    case LVGL_PORT_TRACE_EVENT:
+        snprintf(args, sizeof(args), ",\"args\":{\"type\":%" PRIu32 "}", entry->arg0);
+        break;
+    default:
+        break;
+    }
+
+    /* Instant events are drawn only in their thread */
+    return snprintf(buf, len, "{\"name\":\"%s\",\"cat\":\"lvgl\",\"ph\":\"%c\",%s\"ts\":%" PRIu32 ",\"pid\":1,\"tid\":%" PRIu32 "%s}",
+                    lvgl_port_trace_event_name(entry->event), entry->phase, (entry->phase == LVGL_PORT_TRACE_INSTANT ? "\"s\":\"t\"," : ""),
+                    entry->ts - ts_base, entry->tid, args);
+}
+
+int lvgl_port_trace_format_thread(uint32_t tid, const char *name, char *buf, size_t len)
+{
+    return snprintf(buf, len, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu32 ",\"args\":{\"name\":\"%s\"}}", tid, name);
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint32_t lvgl_port_trace_round_entries(uint32_t entries)
+{
+    uint32_t count = 1;
+
+    while (count < entries && count < (1u << 31)) {
+        count <<= 1;
+    }
+    return count;
+}
+
+static const char *lvgl_port_trace_event_name(uint8_t event)
+{
+    switch (event) {
+    case LVGL_PORT_TRACE_TIMER_HANDLER:
+        return "lv_timer_handler";
+    case LVGL_PORT_TRACE_FLUSH:
+        return "flush";
+    case LVGL_PORT_TRACE_FLUSH_READY:
+        return "flush ready";
+    case LVGL_PORT_TRACE_TOUCH_READ:
+        return "touch read";
+    case LVGL_PORT_TRACE_LOCK:
+        return "lvgl lock";
+    case LVGL_PORT_TRACE_EVENT:
+        return "event";
+    default:
+        return "unknown";
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stddef.h>
+#include "esp_lvgl_port_txfifo.h"
+
+#define LVGL_PORT_TXFIFO_ROUND(len)     (((len) + LVGL_PORT_TXFIFO_ALIGN - 1) & ~(uint32_t)(LVGL_PORT_TXFIFO_ALIGN - 1))
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void lvgl_port_txfifo_init(lvgl_port_txfifo_t *fifo, uint8_t *buf, uint32_t size)
+{
+    fifo->buf = buf;
+    fifo->size = size & ~(uint32_t)(LVGL_PORT_TXFIFO_ALIGN - 1);
+    fifo->head = 0;
+    fifo->tail = 0;
+    fifo->end = fifo->size;
+    fifo->count = 0;
+}
+
+uint8_t *lvgl_port_txfifo_alloc(lvgl_port_txfifo_t *fifo, uint32_t len)
+{
+    uint32_t offset;
+
+    len = LVGL_PORT_TXFIFO_ROUND(len);
+    if (len == 0 || len > fifo->size) {
+        return NULL;
+    }
+
+    if (fifo->count == 0) {
+        /* Empty FIFO starts from the beginning, the whole memory is free */
+        fifo->head = 0;
+        fifo->tail = 0;
+        fifo->end = fifo->size;
+        offset = 0;
+    } else if (fifo->head > fifo->tail) {
+        /* Free space is after the head and before the tail */
+        if (fifo->size - fifo->head >= len) {
+            offset = fifo->head;
+        } else if (fifo->tail >= len) {
+            /* Rest of memory is skipped until the tail wraps too */
+            fifo->end = fifo->head;
+            offset = 0;
+        } else {
+            return NULL;
+        }
+    } else if (fifo->tail - fifo->head >= len) {
+        /* Wrapped, free space is between the head and the tail */
+        offset = fifo->head;
+    } else {
+        return NULL;
+    }
+
+    fifo->head = offset + len;
+    fifo->count++;
+
+    return fifo->buf + offset;
+}
+
+void lvgl_port_txfifo_free(lvgl_port_txfifo_t *fifo, const uint8_t *data, uint32_t len)
+{
+    if (fifo->count == 0) {
+        return;
+    }
+
+    fifo->tail = (uint32_t)(data - fifo->buf) + LVGL_PORT_TXFIFO_ROUND(len);
+    fifo->count--;
+    if (fifo->count == 0) {
+        fifo->head = 0;
+        fifo->tail = 0;
+        fifo->end = fifo->size;
+    } else if (fifo->tail >= fifo->end) {
+        /* The last block before the skipped space, the next one is at the beginning */
+        fifo->tail = 0;
+        fifo->end = fifo->size;
+    }
+}
+
+uint32_t lvgl_port_txfifo_used(const lvgl_port_txfifo_t *fifo)
+{
+    if (fifo->count == 0) {
+        return 0;
+    }
+    if (fifo->head > fifo->tail) {
+        return fifo->head - fifo->tail;
+    }
+    return fifo->end - fifo->tail + fifo->head;
+}
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -31,8 +33,20 @@ typedef struct lvgl_port_ctx_s {
     SemaphoreHandle_t   task_mux;
     esp_timer_handle_t  tick_timer;
     bool                running;
+    bool                tickless;       /* LVGL tick is counted from esp_timer_get_time(), no periodic timer */
+    int64_t             tick_last_us;   /* Time of the last LVGL tick increment (only in tickless mode) */
     int                 task_max_sleep_ms;
     int                 timer_period_ms;
+    /* Lock owner, changed only by the task holding the lock */
+    int                 lock_depth;     /* Nesting of recursive lock */
+    int                 lock_owner;     /* Index of the owner in lock_stats (-1: not recorded) */
+    int64_t             lock_taken;     /* Time of the outermost lock (0: not recorded) */
+    const void          *lock_caller;   /* Caller of the outermost lock */
+    /* Lock statistics (protected by lock_stats_lock, allocated on the first enable) */
+    portMUX_TYPE        lock_stats_lock;
+    bool                lock_stats_on;
+    int64_t             lock_stats_start;
+    lvgl_port_lock_stats_t *lock_stats;
 } lvgl_port_ctx_t;
 
 /*******************************************************************************
@@ -45,7 +59,10 @@ static lvgl_port_ctx_t lvgl_port_ctx;
 *******************************************************************************/
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
+static void lvgl_port_tick_update(void);
 static void lvgl_port_task_deinit(void);
+static bool lvgl_port_lock_recorded(TickType_t timeout_ticks, const void *caller);
+static const void *lvgl_port_lock_caller(const void *addr);
 
 /*******************************************************************************
 * Public API functions
@@ -58,11 +75,14 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
 
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+    portMUX_INITIALIZE(&lvgl_port_ctx.lock_stats_lock);
+    lvgl_port_ctx.lock_owner = -1;
 
     /* LVGL init */
     lv_init();
     /* Tick init */
     lvgl_port_ctx.timer_period_ms = cfg->timer_period_ms;
+    lvgl_port_ctx.tickless = cfg->tickless;
     ESP_RETURN_ON_ERROR(lvgl_port_tick_init(), TAG, "");
     /* Create task */
     lvgl_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms;
@@ -96,7 +116,10 @@ esp_err_t lvgl_port_resume(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
-    if (lvgl_port_ctx.tick_timer != NULL) {
+    if (lvgl_port_ctx.tickless && lvgl_port_ctx.lvgl_task) {
+        lv_timer_enable(true);
+        ret = ESP_OK;
+    } else if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
     }
@@ -108,7 +131,10 @@ esp_err_t lvgl_port_stop(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
-    if (lvgl_port_ctx.tick_timer != NULL) {
+    if (lvgl_port_ctx.tickless && lvgl_port_ctx.lvgl_task) {
+        lv_timer_enable(false);
+        ret = ESP_OK;
+    } else if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
@@ -147,15 +173,111 @@ bool lvgl_port_lock(uint32_t timeout_ms)
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
 
     const TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
-    return xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE;
+    if (lvgl_port_ctx.lock_stats_on) {
+        if (!lvgl_port_lock_recorded(timeout_ticks, lvgl_port_lock_caller(__builtin_return_address(0)))) {
+            return false;
+        }
+    } else if (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) != pdTRUE) {
+        return false;
+    } else {
+        lvgl_port_ctx.lock_depth++;
+    }
+
+    /* LVGL8 cannot read the time by itself, update the tick before any LVGL call */
+    if (lvgl_port_ctx.tickless) {
+        lvgl_port_tick_update();
+    }
+
+    return true;
 }
 
 void lvgl_port_unlock(void)
 {
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
+
+    /* Hold time is measured from the outermost lock to the last unlock */
+    if (--lvgl_port_ctx.lock_depth == 0 && lvgl_port_ctx.lock_taken) {
+        const uint32_t hold_us = esp_timer_get_time() - lvgl_port_ctx.lock_taken;
+        portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (lvgl_port_ctx.lock_stats_on) {
+            lvgl_port_lock_stats_add_hold(lvgl_port_ctx.lock_stats, lvgl_port_ctx.lock_owner, hold_us, lvgl_port_ctx.lock_caller);
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        lvgl_port_ctx.lock_taken = 0;
+        lvgl_port_ctx.lock_owner = -1;
+    }
     xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
 }
 
+esp_err_t lvgl_port_lock_stats_enable(bool enable)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_INVALID_STATE, TAG, "LVGL port is not initialized");
+
+    if (enable && !lvgl_port_ctx.lock_stats) {
+        lvgl_port_lock_stats_t *stats = calloc(1, sizeof(lvgl_port_lock_stats_t));
+        ESP_RETURN_ON_FALSE(stats, ESP_ERR_NO_MEM, TAG, "Not enough memory for lock statistics!");
+        lvgl_port_ctx.lock_stats = stats;
+    }
+
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    if (enable && !lvgl_port_ctx.lock_stats_on) {
+        memset(lvgl_port_ctx.lock_stats, 0, sizeof(lvgl_port_lock_stats_t));
+        lvgl_port_ctx.lock_stats_start = esp_timer_get_time();
+    }
+    lvgl_port_ctx.lock_stats_on = enable;
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_lock_get_stats(lvgl_port_lock_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lock_stats, ESP_ERR_INVALID_STATE, TAG, "Lock statistics are not enabled");
+
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    memcpy(stats, lvgl_port_ctx.lock_stats, sizeof(lvgl_port_lock_stats_t));
+    stats->elapsed_us = now - lvgl_port_ctx.lock_stats_start;
+    if (reset) {
+        /* Tasks keep their indexes, the owner of the lock can be recorded now */
+        for (uint32_t i = 0; i < lvgl_port_ctx.lock_stats->task_cnt; i++) {
+            lvgl_port_lock_task_stats_t *task = &lvgl_port_ctx.lock_stats->tasks[i];
+            memset(&task->locks, 0, sizeof(lvgl_port_lock_task_stats_t) - offsetof(lvgl_port_lock_task_stats_t, locks));
+        }
+        lvgl_port_ctx.lock_stats->starved = 0;
+        lvgl_port_ctx.lock_stats->starved_us = 0;
+        lvgl_port_ctx.lock_stats->dropped = 0;
+        lvgl_port_ctx.lock_stats_start = now;
+    }
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    /* Sorted only in the copy, indexes of tasks are used while recording */
+    lvgl_port_lock_stats_sort(stats);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_lock_log_stats(bool reset)
+{
+    lvgl_port_lock_stats_t *stats = malloc(sizeof(lvgl_port_lock_stats_t));
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_NO_MEM, TAG, "Not enough memory for lock statistics!");
+    char line[160];
+
+    esp_err_t ret = lvgl_port_lock_get_stats(stats, reset);
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Lock statistics for %" PRIu32 " ms: LVGL task starved %" PRIu32 " times for %" PRIu32 " ms, %" PRIu32 " locks not recorded",
+                 (uint32_t)(stats->elapsed_us / 1000), stats->starved, (uint32_t)(stats->starved_us / 1000), stats->dropped);
+        for (uint32_t i = 0; i < stats->task_cnt; i++) {
+            lvgl_port_lock_stats_format(&stats->tasks[i], stats->elapsed_us, line, sizeof(line));
+            ESP_LOGI(TAG, "%" PRIu32 ". %s", i + 1, line);
+        }
+    }
+    free(stats);
+
+    return ret;
+}
+
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
 {
     ESP_LOGE(TAG, "Task wake is not supported, when used LVGL8!");
@@ -215,6 +337,7 @@ static void lvgl_port_task(void *arg)
 
 static void lvgl_port_task_deinit(void)
 {
+    free(lvgl_port_ctx.lock_stats);
     if (lvgl_port_ctx.lvgl_mux) {
         vSemaphoreDelete(lvgl_port_ctx.lvgl_mux);
     }
@@ -228,14 +351,80 @@ static void lvgl_port_task_deinit(void)
 #endif
 }
 
+static bool lvgl_port_lock_recorded(TickType_t timeout_ticks, const void *caller)
+{
+    const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    const int64_t start = esp_timer_get_time();
+    int owner = -1;
+
+    /* The lock is free or already taken by this task */
+    bool locked = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, 0) == pdTRUE);
+    const bool waited = !locked;
+    if (waited) {
+        owner = lvgl_port_ctx.lock_owner;
+        locked = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE);
+    }
+    const bool outermost = (locked && lvgl_port_ctx.lock_depth == 0);
+
+    int idx = -1;
+    if (waited || outermost) {
+        const int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (lvgl_port_ctx.lock_stats_on) {
+            idx = lvgl_port_lock_stats_task(lvgl_port_ctx.lock_stats, task, pcTaskGetName(task));
+            if (waited) {
+                lvgl_port_lock_stats_add_wait(lvgl_port_ctx.lock_stats, idx, now - start, locked, owner, task == lvgl_port_ctx.lvgl_task);
+            }
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (outermost) {
+            lvgl_port_ctx.lock_owner = idx;
+            lvgl_port_ctx.lock_taken = now;
+            lvgl_port_ctx.lock_caller = caller;
+        }
+    }
+
+    if (locked) {
+        lvgl_port_ctx.lock_depth++;
+    }
+    return locked;
+}
+
+static const void *lvgl_port_lock_caller(const void *addr)
+{
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    /* Windowed ABI stores the call size in two upper bits of the return address */
+    return (const void *)(((uintptr_t)addr & 0x3fffffff) | 0x40000000);
+#else
+    return addr;
+#endif
+}
+
 static void lvgl_port_tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
     lv_tick_inc(lvgl_port_ctx.timer_period_ms);
 }
 
+static void lvgl_port_tick_update(void)
+{
+    /* Called with taken LVGL mutex, the remainder under 1 ms is kept for the next update */
+    const int64_t now = esp_timer_get_time();
+    const uint32_t elapsed_ms = (uint32_t)((now - lvgl_port_ctx.tick_last_us) / 1000);
+
+    if (elapsed_ms > 0) {
+        lv_tick_inc(elapsed_ms);
+        lvgl_port_ctx.tick_last_us += (int64_t)elapsed_ms * 1000;
+    }
+}
+
 static esp_err_t lvgl_port_tick_init(void)
 {
+    if (lvgl_port_ctx.tickless) {
+        lvgl_port_ctx.tick_last_us = esp_timer_get_time();
+        return ESP_OK;
+    }
+
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lvgl_port_tick_increment,
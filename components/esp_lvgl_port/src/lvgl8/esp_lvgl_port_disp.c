@@ -97,6 +97,8 @@ lv_disp_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
 
 lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_display_dsi_cfg_t *dsi_cfg)
 {
+    ESP_RETURN_ON_FALSE(dsi_cfg == NULL || !dsi_cfg->flags.use_ppa, NULL, TAG, "PPA is supported only with LVGL9!");
+
     lv_disp_t *disp = lvgl_port_add_disp_priv(disp_cfg, NULL);
 
     if (disp != NULL) {
@@ -121,6 +123,7 @@ lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, co
 lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_display_rgb_cfg_t *rgb_cfg)
 {
     assert(rgb_cfg != NULL);
+    ESP_RETURN_ON_FALSE(!rgb_cfg->flags.nonblocking && !rgb_cfg->flags.triple_buffer, NULL, TAG, "Non-blocking tear-free mode is supported only with LVGL9!");
     const lvgl_port_disp_priv_cfg_t priv_cfg = {
         .avoid_tearing = rgb_cfg->flags.avoid_tearing,
     };
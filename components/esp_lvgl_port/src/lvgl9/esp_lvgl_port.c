@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <stdlib.h>
 #include <string.h>
+#include <inttypes.h>
 #include "esp_system.h"
 #include "esp_log.h"
 #include "esp_err.h"
@@ -16,11 +18,19 @@
 #include "freertos/semphr.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_tracebuf.h"
 #include "lvgl.h"
 
 static const char *TAG = "LVGL";
 
 #define ESP_LVGL_PORT_TASK_MUX_DELAY_MS    10000
+/* Count of different input devices remembered for reading in one LVGL task pass, more means read all */
+#define ESP_LVGL_PORT_PENDING_INDEVS       4
+
+/* Pending events of the LVGL task (bitmask) */
+#define LVGL_PORT_PENDING_DISPLAY   (1 << 0)
+#define LVGL_PORT_PENDING_TOUCH     (1 << 1)
+#define LVGL_PORT_PENDING_USER      (1 << 2)
 
 /*******************************************************************************
 * Types definitions
@@ -29,12 +39,34 @@ static const char *TAG = "LVGL";
 typedef struct lvgl_port_ctx_s {
     TaskHandle_t        lvgl_task;
     SemaphoreHandle_t   lvgl_mux;
-    QueueHandle_t       lvgl_queue;
     SemaphoreHandle_t   task_init_mux;
     esp_timer_handle_t  tick_timer;
     bool                running;
+    bool                tickless;       /* LVGL tick is read from esp_timer_get_time(), no periodic timer */
+    bool                stopped;        /* LVGL timers stopped by lvgl_port_stop (only in tickless mode) */
     int                 task_max_sleep_ms;
+    int                 task_affinity;
     int                 timer_period_ms;
+    /* Events merged until the next LVGL task pass (protected by pending_lock) */
+    portMUX_TYPE        pending_lock;
+    struct {
+        uint32_t    events;         /* Bitmask of pending events (LVGL_PORT_PENDING_*) */
+        uint32_t    count;          /* Count of events merged into this pass */
+        bool        all_indevs;     /* Read all input devices */
+        uint8_t     indev_cnt;      /* Count of input devices in indevs */
+        lv_indev_t  *indevs[ESP_LVGL_PORT_PENDING_INDEVS];
+    } pending;
+    lvgl_port_task_stats_t stats;
+    /* Lock owner, changed only by the task holding the lock */
+    int                 lock_depth;     /* Nesting of recursive lock */
+    int                 lock_owner;     /* Index of the owner in lock_stats (-1: not recorded) */
+    int64_t             lock_taken;     /* Time of the outermost lock (0: not recorded) */
+    const void          *lock_caller;   /* Caller of the outermost lock */
+    /* Lock statistics (protected by lock_stats_lock, allocated on the first enable) */
+    portMUX_TYPE        lock_stats_lock;
+    bool                lock_stats_on;
+    int64_t             lock_stats_start;
+    lvgl_port_lock_stats_t *lock_stats;
 } lvgl_port_ctx_t;
 
 /*******************************************************************************
@@ -47,7 +79,12 @@ static lvgl_port_ctx_t lvgl_port_ctx;
 *******************************************************************************/
 static void lvgl_port_task(void *arg);
 static esp_err_t lvgl_port_tick_init(void);
+static uint32_t lvgl_port_tick_get_cb(void);
 static void lvgl_port_task_deinit(void);
+static bool lvgl_port_task_add_pending(lvgl_port_event_type_t event, void *param);
+static void lvgl_port_task_read_indevs(uint32_t events, bool all_indevs, lv_indev_t **indevs, uint8_t indev_cnt);
+static bool lvgl_port_lock_recorded(TickType_t timeout_ticks, const void *caller);
+static const void *lvgl_port_lock_caller(const void *addr);
 
 /*******************************************************************************
 * Public API functions
@@ -60,14 +97,19 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     ESP_GOTO_ON_FALSE(cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, err, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
 
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
+    portMUX_INITIALIZE(&lvgl_port_ctx.pending_lock);
+    portMUX_INITIALIZE(&lvgl_port_ctx.lock_stats_lock);
+    lvgl_port_ctx.lock_owner = -1;
 
     /* LVGL init */
     lv_init();
     /* Tick init */
     lvgl_port_ctx.timer_period_ms = cfg->timer_period_ms;
+    lvgl_port_ctx.tickless = cfg->tickless;
     ESP_RETURN_ON_ERROR(lvgl_port_tick_init(), TAG, "");
     /* Create task */
     lvgl_port_ctx.task_max_sleep_ms = cfg->task_max_sleep_ms;
+    lvgl_port_ctx.task_affinity = cfg->task_affinity;
     if (lvgl_port_ctx.task_max_sleep_ms == 0) {
         lvgl_port_ctx.task_max_sleep_ms = 500;
     }
@@ -77,9 +119,6 @@ esp_err_t lvgl_port_init(const lvgl_port_cfg_t *cfg)
     /* Task init semaphore */
     lvgl_port_ctx.task_init_mux = xSemaphoreCreateMutex();
     ESP_GOTO_ON_FALSE(lvgl_port_ctx.task_init_mux, ESP_ERR_NO_MEM, err, TAG, "Create LVGL task sem fail!");
-    /* Task queue */
-    lvgl_port_ctx.lvgl_queue = xQueueCreate(100, sizeof(lvgl_port_event_t));
-    ESP_GOTO_ON_FALSE(lvgl_port_ctx.lvgl_queue, ESP_ERR_NO_MEM, err, TAG, "Create LVGL queue fail!");
 
     BaseType_t res;
     if (cfg->task_affinity < 0) {
@@ -101,7 +140,12 @@ esp_err_t lvgl_port_resume(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
-    if (lvgl_port_ctx.tick_timer != NULL) {
+    if (lvgl_port_ctx.tickless && lvgl_port_ctx.stopped) {
+        lvgl_port_ctx.stopped = false;
+        lv_timer_enable(true);
+        /* LVGL task may sleep without timeout */
+        ret = lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+    } else if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(true);
         ret = esp_timer_start_periodic(lvgl_port_ctx.tick_timer, lvgl_port_ctx.timer_period_ms * 1000);
     }
@@ -113,7 +157,11 @@ esp_err_t lvgl_port_stop(void)
 {
     esp_err_t ret = ESP_ERR_INVALID_STATE;
 
-    if (lvgl_port_ctx.tick_timer != NULL) {
+    if (lvgl_port_ctx.tickless && lvgl_port_ctx.lvgl_task && !lvgl_port_ctx.stopped) {
+        lv_timer_enable(false);
+        lvgl_port_ctx.stopped = true;
+        ret = ESP_OK;
+    } else if (lvgl_port_ctx.tick_timer != NULL) {
         lv_timer_enable(false);
         ret = esp_timer_stop(lvgl_port_ctx.tick_timer);
     }
@@ -152,62 +200,194 @@ bool lvgl_port_lock(uint32_t timeout_ms)
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
 
     const TickType_t timeout_ticks = (timeout_ms == 0) ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
-    return xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE;
+    bool locked = false;
+    if (lvgl_port_ctx.lock_stats_on) {
+        locked = lvgl_port_lock_recorded(timeout_ticks, lvgl_port_lock_caller(__builtin_return_address(0)));
+    } else if (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE) {
+        lvgl_port_ctx.lock_depth++;
+        locked = true;
+    }
+    if (locked && lvgl_port_ctx.lock_depth == 1) {
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_LOCK, LVGL_PORT_TRACE_BEGIN, 0, 0);
+    }
+    return locked;
 }
 
 void lvgl_port_unlock(void)
 {
     assert(lvgl_port_ctx.lvgl_mux && "lvgl_port_init must be called first");
+
+    if (lvgl_port_ctx.lock_depth == 1) {
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_LOCK, LVGL_PORT_TRACE_END, 0, 0);
+    }
+
+    /* Hold time is measured from the outermost lock to the last unlock */
+    if (--lvgl_port_ctx.lock_depth == 0 && lvgl_port_ctx.lock_taken) {
+        const uint32_t hold_us = esp_timer_get_time() - lvgl_port_ctx.lock_taken;
+        portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (lvgl_port_ctx.lock_stats_on) {
+            lvgl_port_lock_stats_add_hold(lvgl_port_ctx.lock_stats, lvgl_port_ctx.lock_owner, hold_us, lvgl_port_ctx.lock_caller);
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        lvgl_port_ctx.lock_taken = 0;
+        lvgl_port_ctx.lock_owner = -1;
+    }
     xSemaphoreGiveRecursive(lvgl_port_ctx.lvgl_mux);
 }
 
+esp_err_t lvgl_port_lock_stats_enable(bool enable)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lvgl_mux, ESP_ERR_INVALID_STATE, TAG, "LVGL port is not initialized");
+
+    if (enable && !lvgl_port_ctx.lock_stats) {
+        lvgl_port_lock_stats_t *stats = calloc(1, sizeof(lvgl_port_lock_stats_t));
+        ESP_RETURN_ON_FALSE(stats, ESP_ERR_NO_MEM, TAG, "Not enough memory for lock statistics!");
+        lvgl_port_ctx.lock_stats = stats;
+    }
+
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    if (enable && !lvgl_port_ctx.lock_stats_on) {
+        memset(lvgl_port_ctx.lock_stats, 0, sizeof(lvgl_port_lock_stats_t));
+        lvgl_port_ctx.lock_stats_start = esp_timer_get_time();
+    }
+    lvgl_port_ctx.lock_stats_on = enable;
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_lock_get_stats(lvgl_port_lock_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lock_stats, ESP_ERR_INVALID_STATE, TAG, "Lock statistics are not enabled");
+
+    const int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+    memcpy(stats, lvgl_port_ctx.lock_stats, sizeof(lvgl_port_lock_stats_t));
+    stats->elapsed_us = now - lvgl_port_ctx.lock_stats_start;
+    if (reset) {
+        /* Tasks keep their indexes, the owner of the lock can be recorded now */
+        for (uint32_t i = 0; i < lvgl_port_ctx.lock_stats->task_cnt; i++) {
+            lvgl_port_lock_task_stats_t *task = &lvgl_port_ctx.lock_stats->tasks[i];
+            memset(&task->locks, 0, sizeof(lvgl_port_lock_task_stats_t) - offsetof(lvgl_port_lock_task_stats_t, locks));
+        }
+        lvgl_port_ctx.lock_stats->starved = 0;
+        lvgl_port_ctx.lock_stats->starved_us = 0;
+        lvgl_port_ctx.lock_stats->dropped = 0;
+        lvgl_port_ctx.lock_stats_start = now;
+    }
+    portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+
+    /* Sorted only in the copy, indexes of tasks are used while recording */
+    lvgl_port_lock_stats_sort(stats);
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_lock_log_stats(bool reset)
+{
+    lvgl_port_lock_stats_t *stats = malloc(sizeof(lvgl_port_lock_stats_t));
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_NO_MEM, TAG, "Not enough memory for lock statistics!");
+    char line[160];
+
+    esp_err_t ret = lvgl_port_lock_get_stats(stats, reset);
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Lock statistics for %" PRIu32 " ms: LVGL task starved %" PRIu32 " times for %" PRIu32 " ms, %" PRIu32 " locks not recorded",
+                 (uint32_t)(stats->elapsed_us / 1000), stats->starved, (uint32_t)(stats->starved_us / 1000), stats->dropped);
+        for (uint32_t i = 0; i < stats->task_cnt; i++) {
+            lvgl_port_lock_stats_format(&stats->tasks[i], stats->elapsed_us, line, sizeof(line));
+            ESP_LOGI(TAG, "%" PRIu32 ". %s", i + 1, line);
+        }
+    }
+    free(stats);
+
+    return ret;
+}
+
 esp_err_t lvgl_port_task_wake(lvgl_port_event_type_t event, void *param)
 {
-    if (!lvgl_port_ctx.lvgl_queue) {
+    if (!lvgl_port_ctx.lvgl_task) {
         return ESP_ERR_INVALID_STATE;
     }
 
-    lvgl_port_event_t ev = {
-        .type = event,
-        .param = param,
-    };
+    LVGL_PORT_TRACE(LVGL_PORT_TRACE_EVENT, LVGL_PORT_TRACE_INSTANT, event, 0);
 
-    if (xPortInIsrContext() == pdTRUE) {
-        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-        xQueueSendFromISR(lvgl_port_ctx.lvgl_queue, &ev, &xHigherPriorityTaskWoken);
-        if (xHigherPriorityTaskWoken) {
-            portYIELD_FROM_ISR( );
+    /* Display invalidated inside LVGL task is handled by the running pass, lv_timer_handler counts with refresh timer */
+    if (event == LVGL_PORT_EVENT_DISPLAY && xPortInIsrContext() != pdTRUE && xTaskGetCurrentTaskHandle() == lvgl_port_ctx.lvgl_task) {
+        portENTER_CRITICAL(&lvgl_port_ctx.pending_lock);
+        lvgl_port_ctx.stats.events++;
+        lvgl_port_ctx.stats.coalesced++;
+        portEXIT_CRITICAL(&lvgl_port_ctx.pending_lock);
+        return ESP_OK;
+    }
+
+    /* The task is notified only by the first event, next ones are merged until the task takes them */
+    if (lvgl_port_task_add_pending(event, param)) {
+        if (lvgl_port_task_notify(LVGL_PORT_NOTIFY_WAKE)) {
+            portYIELD_FROM_ISR();
         }
-    } else {
-        xQueueSend(lvgl_port_ctx.lvgl_queue, &ev, 0);
     }
 
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_task_get_stats(lvgl_port_task_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_ctx.lvgl_task, ESP_ERR_INVALID_STATE, TAG, "LVGL task is not running");
+
+    portENTER_CRITICAL(&lvgl_port_ctx.pending_lock);
+    memcpy(stats, &lvgl_port_ctx.stats, sizeof(lvgl_port_task_stats_t));
+    if (reset) {
+        memset(&lvgl_port_ctx.stats, 0, sizeof(lvgl_port_task_stats_t));
+    }
+    portEXIT_CRITICAL(&lvgl_port_ctx.pending_lock);
+
+    return ESP_OK;
+}
+
 IRAM_ATTR bool lvgl_port_task_notify(uint32_t value)
 {
     BaseType_t need_yield = pdFALSE;
 
     // Notify LVGL task
     if (xPortInIsrContext() == pdTRUE) {
-        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, value, eNoAction, &need_yield);
+        xTaskNotifyFromISR(lvgl_port_ctx.lvgl_task, value, eSetBits, &need_yield);
     } else {
-        xTaskNotify(lvgl_port_ctx.lvgl_task, value, eNoAction);
+        xTaskNotify(lvgl_port_ctx.lvgl_task, value, eSetBits);
     }
 
     return (need_yield == pdTRUE);
 }
 
+int lvgl_port_task_get_affinity(void)
+{
+    return lvgl_port_ctx.task_affinity;
+}
+
+void *lvgl_port_task_get_handle(void)
+{
+    return lvgl_port_ctx.lvgl_task;
+}
+
+void lvgl_port_task_wait_notify(uint32_t value)
+{
+    uint32_t bits = 0;
+
+    /* Other bits stay set, they are handled by the LVGL task loop */
+    while ((bits & value) == 0) {
+        xTaskNotifyWait(0, value, &bits, portMAX_DELAY);
+    }
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
 
 static void lvgl_port_task(void *arg)
 {
-    lvgl_port_event_t event;
     uint32_t task_delay_ms = 0;
-    lv_indev_t *indev = NULL;
+    lv_indev_t *indevs[ESP_LVGL_PORT_PENDING_INDEVS];
 
     /* Take the task semaphore */
     if (xSemaphoreTake(lvgl_port_ctx.task_init_mux, 0) != pdTRUE) {
@@ -219,38 +399,65 @@ static void lvgl_port_task(void *arg)
     ESP_LOGI(TAG, "Starting LVGL task");
     lvgl_port_ctx.running = true;
     while (lvgl_port_ctx.running) {
-        /* Wait for queue or timeout (sleep task) */
-        TickType_t wait = (pdMS_TO_TICKS(task_delay_ms) >= 1 ? pdMS_TO_TICKS(task_delay_ms) : 1);
-        xQueueReceive(lvgl_port_ctx.lvgl_queue, &event, wait);
+        /* Sleep until the next LVGL timer, unless some event came during the last pass (rounded up, LVGL timer must be ready after wake) */
+        bool timeout = false;
+        if (lvgl_port_ctx.pending.events == 0) {
+            TickType_t wait = portMAX_DELAY;
+            if (task_delay_ms != LV_NO_TIMER_READY && !lvgl_port_ctx.stopped) {
+                wait = ((uint64_t)task_delay_ms * configTICK_RATE_HZ + 999) / 1000;
+                /* Timer is already due (0 ms), the task blocks at least one tick to not starve IDLE and lower priority tasks */
+                if (wait == 0) {
+                    wait = 1;
+                }
+            }
+            timeout = (xTaskNotifyWait(0, LVGL_PORT_NOTIFY_WAKE, NULL, wait) != pdTRUE);
+        }
+
+        /* Take all pending events at once */
+        portENTER_CRITICAL(&lvgl_port_ctx.pending_lock);
+        const uint32_t events = lvgl_port_ctx.pending.events;
+        const bool all_indevs = lvgl_port_ctx.pending.all_indevs;
+        const uint8_t indev_cnt = lvgl_port_ctx.pending.indev_cnt;
+        memcpy(indevs, lvgl_port_ctx.pending.indevs, sizeof(indevs));
+        if (events) {
+            lvgl_port_ctx.stats.wakeups++;
+            if (lvgl_port_ctx.pending.count > lvgl_port_ctx.stats.max_batch) {
+                lvgl_port_ctx.stats.max_batch = lvgl_port_ctx.pending.count;
+            }
+        }
+        if (timeout) {
+            lvgl_port_ctx.stats.timeouts++;
+        }
+        lvgl_port_ctx.stats.passes++;
+        memset(&lvgl_port_ctx.pending, 0, sizeof(lvgl_port_ctx.pending));
+        portEXIT_CRITICAL(&lvgl_port_ctx.pending_lock);
 
         if (lv_display_get_default() && lvgl_port_lock(0)) {
+            /* Apply UI commands posted without LVGL mutex */
+            lvgl_port_cmd_queue_run();
 
             /* Call read input devices */
-            if (event.type == LVGL_PORT_EVENT_TOUCH) {
-                if (event.param != NULL) {
-                    lv_indev_read(event.param);
-                } else {
-                    indev = lv_indev_get_next(NULL);
-                    while (indev != NULL) {
-                        lv_indev_read(indev);
-                        indev = lv_indev_get_next(indev);
-                    }
-                }
-            }
+            lvgl_port_task_read_indevs(events, all_indevs, indevs, indev_cnt);
+
+            /* Refresh period by activity */
+            lvgl_port_governor_update();
 
             /* Handle LVGL */
+            LVGL_PORT_TRACE(LVGL_PORT_TRACE_TIMER_HANDLER, LVGL_PORT_TRACE_BEGIN, 0, 0);
             task_delay_ms = lv_timer_handler();
+            LVGL_PORT_TRACE(LVGL_PORT_TRACE_TIMER_HANDLER, LVGL_PORT_TRACE_END, task_delay_ms, 0);
             lvgl_port_unlock();
         } else {
             task_delay_ms = 1; /*Keep trying*/
         }
 
-        if (task_delay_ms == LV_NO_TIMER_READY) {
+        /* In tickless mode, the task sleeps without limit, LVGL tick does not depend on it */
+        if (lvgl_port_ctx.tickless) {
+            continue;
+        }
+        if (task_delay_ms == LV_NO_TIMER_READY || task_delay_ms > (uint32_t)lvgl_port_ctx.task_max_sleep_ms) {
             task_delay_ms = lvgl_port_ctx.task_max_sleep_ms;
         }
-
-        /* Minimal dealy for the task. When there is too much events, it takes time for other tasks and interrupts. */
-        vTaskDelay(1);
     }
 
     /* Give semaphore back */
@@ -262,15 +469,17 @@ static void lvgl_port_task(void *arg)
 
 static void lvgl_port_task_deinit(void)
 {
+    /* Command queue is unpublished with taken LVGL mutex, before lock statistics are freed */
+    lvgl_port_cmd_queue_deinit();
+    free(lvgl_port_ctx.lock_stats);
+    lvgl_port_governor_deinit();
+    lvgl_port_trace_deinit();
     if (lvgl_port_ctx.lvgl_mux) {
         vSemaphoreDelete(lvgl_port_ctx.lvgl_mux);
     }
     if (lvgl_port_ctx.task_init_mux) {
         vSemaphoreDelete(lvgl_port_ctx.task_init_mux);
     }
-    if (lvgl_port_ctx.lvgl_queue) {
-        vQueueDelete(lvgl_port_ctx.lvgl_queue);
-    }
     memset(&lvgl_port_ctx, 0, sizeof(lvgl_port_ctx));
 #if LV_ENABLE_GC || !LV_MEM_CUSTOM
     /* Deinitialize LVGL */
@@ -278,14 +487,141 @@ static void lvgl_port_task_deinit(void)
 #endif
 }
 
+static bool lvgl_port_task_add_pending(lvgl_port_event_type_t event, void *param)
+{
+    bool merged = false;
+    uint32_t bit = LVGL_PORT_PENDING_DISPLAY;
+
+    if (event == LVGL_PORT_EVENT_TOUCH) {
+        bit = LVGL_PORT_PENDING_TOUCH;
+    } else if (event == LVGL_PORT_EVENT_USER) {
+        bit = LVGL_PORT_PENDING_USER;
+    }
+
+    portENTER_CRITICAL_SAFE(&lvgl_port_ctx.pending_lock);
+    const bool was_pending = (lvgl_port_ctx.pending.events != 0);
+    if (lvgl_port_ctx.pending.events & bit) {
+        merged = true;
+    }
+    if (event == LVGL_PORT_EVENT_TOUCH) {
+        /* Each input device is read only once per pass */
+        merged = lvgl_port_ctx.pending.all_indevs;
+        if (param == NULL) {
+            lvgl_port_ctx.pending.all_indevs = true;
+        } else if (!merged) {
+            for (int i = 0; i < lvgl_port_ctx.pending.indev_cnt; i++) {
+                if (lvgl_port_ctx.pending.indevs[i] == param) {
+                    merged = true;
+                    break;
+                }
+            }
+            if (!merged) {
+                if (lvgl_port_ctx.pending.indev_cnt < ESP_LVGL_PORT_PENDING_INDEVS) {
+                    lvgl_port_ctx.pending.indevs[lvgl_port_ctx.pending.indev_cnt++] = param;
+                } else {
+                    lvgl_port_ctx.pending.all_indevs = true;
+                }
+            }
+        }
+    }
+    lvgl_port_ctx.pending.events |= bit;
+    lvgl_port_ctx.pending.count++;
+    lvgl_port_ctx.stats.events++;
+    if (merged) {
+        lvgl_port_ctx.stats.coalesced++;
+    }
+    portEXIT_CRITICAL_SAFE(&lvgl_port_ctx.pending_lock);
+
+    return !was_pending;
+}
+
+static void lvgl_port_task_read_indevs(uint32_t events, bool all_indevs, lv_indev_t **indevs, uint8_t indev_cnt)
+{
+    if ((events & LVGL_PORT_PENDING_TOUCH) == 0) {
+        return;
+    }
+
+    if (all_indevs) {
+        lv_indev_t *indev = lv_indev_get_next(NULL);
+        while (indev != NULL) {
+            lv_indev_read(indev);
+            indev = lv_indev_get_next(indev);
+        }
+    } else {
+        for (int i = 0; i < indev_cnt; i++) {
+            lv_indev_read(indevs[i]);
+        }
+    }
+}
+
+static bool lvgl_port_lock_recorded(TickType_t timeout_ticks, const void *caller)
+{
+    const TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    const int64_t start = esp_timer_get_time();
+    int owner = -1;
+
+    /* The lock is free or already taken by this task */
+    bool locked = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, 0) == pdTRUE);
+    const bool waited = !locked;
+    if (waited) {
+        owner = lvgl_port_ctx.lock_owner;
+        locked = (xSemaphoreTakeRecursive(lvgl_port_ctx.lvgl_mux, timeout_ticks) == pdTRUE);
+    }
+    const bool outermost = (locked && lvgl_port_ctx.lock_depth == 0);
+
+    int idx = -1;
+    if (waited || outermost) {
+        const int64_t now = esp_timer_get_time();
+        portENTER_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (lvgl_port_ctx.lock_stats_on) {
+            idx = lvgl_port_lock_stats_task(lvgl_port_ctx.lock_stats, task, pcTaskGetName(task));
+            if (waited) {
+                lvgl_port_lock_stats_add_wait(lvgl_port_ctx.lock_stats, idx, now - start, locked, owner, task == lvgl_port_ctx.lvgl_task);
+            }
+        }
+        portEXIT_CRITICAL(&lvgl_port_ctx.lock_stats_lock);
+        if (outermost) {
+            lvgl_port_ctx.lock_owner = idx;
+            lvgl_port_ctx.lock_taken = now;
+            lvgl_port_ctx.lock_caller = caller;
+        }
+    }
+
+    if (locked) {
+        lvgl_port_ctx.lock_depth++;
+    }
+    return locked;
+}
+
+static const void *lvgl_port_lock_caller(const void *addr)
+{
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    /* Windowed ABI stores the call size in two upper bits of the return address */
+    return (const void *)(((uintptr_t)addr & 0x3fffffff) | 0x40000000);
+#else
+    return addr;
+#endif
+}
+
 static void lvgl_port_tick_increment(void *arg)
 {
     /* Tell LVGL how many milliseconds have elapsed */
     lv_tick_inc(lvgl_port_ctx.timer_period_ms);
 }
 
+static uint32_t lvgl_port_tick_get_cb(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
 static esp_err_t lvgl_port_tick_init(void)
 {
+    if (lvgl_port_ctx.tickless) {
+        /* LVGL reads time when needed, no interrupts while idle */
+        lv_tick_set_cb(lvgl_port_tick_get_cb);
+        return ESP_OK;
+    }
+
     // Tick interface for LVGL (using esp_timer to generate 2ms periodic event)
     const esp_timer_create_args_t lvgl_tick_timer_args = {
         .callback = &lvgl_port_tick_increment,
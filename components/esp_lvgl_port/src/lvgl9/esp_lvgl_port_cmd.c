@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_cmdq.h"
+
+static const char *TAG = "LVGL";
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static lvgl_port_cmdq_t *lvgl_port_cmdq;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static esp_err_t lvgl_port_cmd_post_priv(uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_cmd_queue_init(const lvgl_port_cmd_queue_cfg_t *cfg)
+{
+    const lvgl_port_cmd_queue_cfg_t default_cfg = {0};
+
+    ESP_RETURN_ON_FALSE(lvgl_port_cmdq == NULL, ESP_ERR_INVALID_STATE, TAG, "Command queue already exists!");
+    ESP_RETURN_ON_FALSE(cfg == NULL || cfg->merge_keys <= LVGL_PORT_CMD_MERGE_KEYS_MAX, ESP_ERR_INVALID_ARG, TAG, "Maximum count of merge keys is %d", LVGL_PORT_CMD_MERGE_KEYS_MAX);
+
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq_create(cfg ? cfg : &default_cfg);
+    ESP_RETURN_ON_FALSE(queue, ESP_ERR_NO_MEM, TAG, "Not enough memory for command queue!");
+
+    /* Published under the lock, the LVGL task reads it there */
+    lvgl_port_lock(0);
+    lvgl_port_cmdq = queue;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_cmd_post(lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len)
+{
+    return lvgl_port_cmd_post_priv(0, cb, user_data, data, len);
+}
+
+esp_err_t lvgl_port_cmd_post_merge(uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len)
+{
+    /* No logs here, it can be called from interrupt (upper limit of the key is checked with the queue) */
+    if (key == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return lvgl_port_cmd_post_priv(key, cb, user_data, data, len);
+}
+
+esp_err_t lvgl_port_cmd_get_stats(lvgl_port_cmd_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_cmdq, ESP_ERR_INVALID_STATE, TAG, "Command queue is not created!");
+
+    lvgl_port_cmdq_get_stats(lvgl_port_cmdq, stats, reset);
+
+    return ESP_OK;
+}
+
+void lvgl_port_cmd_queue_run(void)
+{
+    if (lvgl_port_cmdq) {
+        lvgl_port_cmdq_run(lvgl_port_cmdq);
+    }
+}
+
+void lvgl_port_cmd_queue_deinit(void)
+{
+    if (lvgl_port_cmdq == NULL) {
+        return;
+    }
+
+    /* Unpublished under the lock as in init, producers must stop posting before (they do not take the lock) */
+    lvgl_port_lock(0);
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq;
+    lvgl_port_cmdq = NULL;
+    lvgl_port_unlock();
+
+    lvgl_port_cmdq_delete(queue);
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static esp_err_t lvgl_port_cmd_post_priv(uint32_t key, lvgl_port_cmd_cb_t cb, void *user_data, const void *data, size_t len)
+{
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq;
+
+    /* No logs here, it can be called from interrupt */
+    if (queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (cb == NULL || (data && len > lvgl_port_cmdq_get_data_size(queue)) || key > lvgl_port_cmdq_get_merge_keys(queue)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const lvgl_port_cmdq_result_t res = lvgl_port_cmdq_post(queue, key, cb, user_data, data, len);
+    if (res == LVGL_PORT_CMDQ_FULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    /* Merged command does not need a new wake, the previous one is still pending */
+    if (res != LVGL_PORT_CMDQ_MERGED) {
+        lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+    }
+
+    return ESP_OK;
+}
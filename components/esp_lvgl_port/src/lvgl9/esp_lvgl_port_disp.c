@@ -5,17 +5,29 @@
  */
 
 #include <string.h>
+#include <sys/cdefs.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_timer.h"
 #include "esp_heap_caps.h"
 #include "esp_idf_version.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lvgl_port.h"
 #include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_area.h"
+#include "esp_lvgl_port_swap.h"
+#include "esp_lvgl_port_mono.h"
+#include "esp_lvgl_port_rotate.h"
+#include "esp_lvgl_port_blit.h"
+#include "esp_lvgl_port_txfifo.h"
+#include "esp_lvgl_port_tracebuf.h"
+#include "src/display/lv_display_private.h"
 
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 #include "esp_lcd_panel_rgb.h"
@@ -25,31 +37,186 @@
 #include "esp_lcd_mipi_dsi.h"
 #endif
 
+/* Copy into the frame buffer by 2D engine (PPA) is supported on ESP32P4 from IDF 5.4 */
+#if CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 4, 0)
+#define LVGL_PORT_PPA 1
+#include "driver/ppa.h"
+#include "esp_cache.h"
+#else
+#define LVGL_PORT_PPA 0
+#endif
+
 #if (ESP_IDF_VERSION < ESP_IDF_VERSION_VAL(4, 4, 4)) || (ESP_IDF_VERSION == ESP_IDF_VERSION_VAL(5, 0, 0))
 #define LVGL_PORT_HANDLE_FLUSH_READY 0
 #else
 #define LVGL_PORT_HANDLE_FLUSH_READY 1
 #endif
 
+/* Monochrome rendering in LVGL I1 format is supported from LVGL 9.2 */
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 2)
+#define LVGL_PORT_MONO_I1 1
+/* Palette at the beginning of the I1 buffer */
+#define LVGL_PORT_MONO_I1_PALETTE_SIZE  (LV_COLOR_INDEXED_PALETTE_SIZE(LV_COLOR_FORMAT_I1) * sizeof(lv_color32_t))
+#else
+#define LVGL_PORT_MONO_I1 0
+#endif
+
+/* LVGL sends events around waiting for flush ready from LVGL 9.1 */
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 1)
+#define LVGL_PORT_STATS_FLUSH_WAIT 1
+#else
+#define LVGL_PORT_STATS_FLUSH_WAIT 0
+#endif
+
+/* Display gets buffers as LVGL draw buffers (lv_draw_buf_t) from LVGL 9.1 */
+#if LVGL_VERSION_MAJOR > 9 || (LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 1)
+#define LVGL_PORT_DRAW_BUFS 1
+#else
+#define LVGL_PORT_DRAW_BUFS 0
+#endif
+
+/* Display refresh (normally called by its refresh timer) is in private header from LVGL 9.2 */
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR < 2
+#define lvgl_port_disp_refr_timer       _lv_display_refr_timer
+#else
+#include "src/core/lv_refr_private.h"
+#define lvgl_port_disp_refr_timer       lv_display_refr_timer
+#endif
+
+/* Defaults of display render task */
+#define LVGL_PORT_DISP_TASK_PRIORITY    (4)
+#define LVGL_PORT_DISP_TASK_STACK       (6144)
+#define LVGL_PORT_DISP_TASK_STOP_MS     (10000)
+
+/* Defaults of display transmit task */
+#define LVGL_PORT_DISP_TX_PRIORITY      (5)
+#define LVGL_PORT_DISP_TX_STACK         (3072)
+#define LVGL_PORT_DISP_TX_PENDING       (4)
+
+/* Maximum count of areas changed since the last frame in one RGB frame buffer */
+#define LVGL_PORT_RGB_STALE_MAX         (LV_INV_BUF_SIZE)
+/* Whole RGB frame buffer is changed since the last frame in it */
+#define LVGL_PORT_RGB_STALE_FULL        (0xFF)
+/* Maximum count of RGB frame buffers */
+#define LVGL_PORT_RGB_FBS_MAX           (3)
+
+/* Count of chunks for swapping bytes overlapped with the transfer */
+#define LVGL_PORT_SWAP_CHUNKS           (4)
+/* Minimal size of one chunk in pixels (smaller chunks cost more on the transfer overhead) */
+#define LVGL_PORT_SWAP_CHUNK_MIN_PX     (2048)
+
 static const char *TAG = "LVGL";
 
 /*******************************************************************************
 * Types definitions
 *******************************************************************************/
 
+/* Transfer sent by transmit task (data NULL: stop the task) */
+typedef struct {
+    uint8_t                   *data;          /* Copy of area in transmit FIFO */
+    uint32_t                  len;            /* Size of data in bytes */
+    int32_t                   x1;
+    int32_t                   y1;
+    int32_t                   x2;             /* End of area (exclusive) */
+    int32_t                   y2;             /* End of area (exclusive) */
+} lvgl_port_tx_item_t;
+
 typedef struct {
     lvgl_port_disp_type_t     disp_type;    /* Display type */
     esp_lcd_panel_io_handle_t io_handle;      /* LCD panel IO handle */
     esp_lcd_panel_handle_t    panel_handle;   /* LCD panel handle */
     esp_lcd_panel_handle_t    control_handle; /* LCD panel control handle */
     lvgl_port_rotation_cfg_t  rotation;       /* Default values of the screen rotation */
-    lv_color_t                *draw_buffs[2]; /* Display draw buffers */
+    lv_color_t                *draw_buffs[LVGL_PORT_DISP_BUFFERS_MAX]; /* Display draw buffers */
+    uint8_t                   *mono_buf;      /* Buffer in page layout for monochrome display */
+    uint8_t                   *rotate_buf;    /* Buffer for software rotation */
     lv_display_t              *disp_drv;      /* LVGL display driver */
+    volatile bool             removing;       /* Display is being removed, flush callback sends nothing */
+    uint8_t                   coalesce_overdraw; /* Allowed overdraw for merging invalidated areas in percent */
+    lvgl_port_coalesce_stats_t coalesce_stats;   /* Statistics of merging invalidated areas */
+    volatile uint32_t         trans_pending;  /* Count of not finished transfers of the current flush */
+    uint8_t                   *trans_buf[2];  /* Buffers in SRAM send to driver (ping-pong) */
+    uint8_t                   trans_buf_idx;  /* Index of the next used transport buffer */
+    uint32_t                  trans_size;     /* Maximum size for one transport in pixels */
+    SemaphoreHandle_t         trans_sem;      /* Count of free transport buffers */
+#if LVGL_PORT_PPA
+    ppa_client_handle_t       ppa_client;     /* PPA client for copy into the frame buffer */
+    uint8_t                   *ppa_fb;        /* Frame buffer of the MIPI-DSI panel */
+#endif
+    struct {
+        QueueHandle_t         free;           /* Indexes of free draw buffers */
+        uint8_t               render;         /* Index of draw buffer used by LVGL for rendering */
+        struct {
+            uint8_t           buf;            /* Index of flushed draw buffer */
+            uint32_t          pending;        /* Count of not finished transfers of this flush */
+        } in_flight[LVGL_PORT_DISP_BUFFERS_MAX];
+        volatile uint32_t     head;           /* The oldest flush in flight (moved only in ready callback) */
+        volatile uint32_t     tail;           /* The newest flush in flight (moved only in flush callback) */
+        lvgl_port_buffer_stats_t stats;       /* Statistics of draw buffers ring */
+    } ring;
+    struct {
+#if LVGL_PORT_DRAW_BUFS
+        lv_draw_buf_t         bufs[LVGL_PORT_DISP_BUFFERS_MAX]; /* LVGL draw buffer for each memory of ring or RGB frame buffers */
+#else
+        void                  *data[LVGL_PORT_DISP_BUFFERS_MAX]; /* Memory of ring or RGB frame buffers */
+        uint32_t              size;           /* Size of one buffer in bytes */
+        lv_display_render_mode_t mode;        /* Render mode of the display */
+#endif
+    } render;
+    struct {
+        uint8_t               *fbs[LVGL_PORT_RGB_FBS_MAX]; /* RGB frame buffers */
+        uint8_t               count;          /* Count of used RGB frame buffers */
+        uint8_t               render;         /* Index of frame buffer used by LVGL for rendering */
+        uint8_t               latest;         /* Index of frame buffer with the latest rendered frame */
+        volatile int8_t       queued;         /* Index of frame buffer waiting for VSYNC (-1: none, cleared in VSYNC interrupt) */
+        volatile uint8_t      scan;           /* Index of frame buffer scanned by the panel (set in VSYNC interrupt) */
+        lv_area_t             stale[LVGL_PORT_RGB_FBS_MAX][LVGL_PORT_RGB_STALE_MAX]; /* Areas changed since the last frame in each frame buffer */
+        uint8_t               stale_cnt[LVGL_PORT_RGB_FBS_MAX]; /* Count of changed areas (LVGL_PORT_RGB_STALE_FULL: whole screen) */
+    } rgb;
+    struct {
+        lvgl_port_disp_stats_t data;          /* Collected statistics */
+        int64_t               start;          /* Time of enabling or reset of statistics */
+        int64_t               render_start;   /* Start of rendering of the current frame */
+        int64_t               wait_start;     /* Start of waiting for flush ready */
+        int64_t               frame_wait;     /* Time of waiting for flush ready in the current frame */
+        volatile int64_t      inv_start;      /* The first invalidation for the next frame (0: none) */
+        volatile int64_t      latency_start;  /* The first invalidation of the flushed frame (0: none) */
+        volatile int64_t      busy_start;     /* Start of pending transfers (0: bus is idle) */
+    } stats;
+    struct {
+        TaskHandle_t          handle;         /* Own render task of the display */
+        SemaphoreHandle_t     done;           /* Given by render task, when it is stopped */
+        volatile bool         running;        /* Render task refreshes the display */
+        volatile bool         requested;      /* Refresh timer requested refresh of the display */
+    } task;
+    struct {
+        TaskHandle_t          handle;         /* Transmit task, which calls esp_lcd_panel_draw_bitmap */
+        QueueHandle_t         queue;          /* Transfers for transmit task */
+        SemaphoreHandle_t     space;          /* Given when a transfer is finished */
+        SemaphoreHandle_t     done;           /* Given by transmit task, when it is stopped */
+        bool                  stopping;       /* Stop request is queued */
+        bool                  stopped;        /* Transmit task is stopped, its last transfers can still be on the bus */
+        lvgl_port_txfifo_t    fifo;           /* Copies of flushed areas (allocated and freed in flush callback) */
+        lvgl_port_tx_item_t   items[LVGL_PORT_DISP_TX_PENDING_MAX]; /* Queued transfers, freed in the same order */
+        uint8_t               max_pending;    /* Maximum count of queued transfers */
+        uint32_t              queued;         /* Count of queued transfers (moved only in flush callback) */
+        uint32_t              freed;          /* Count of transfers freed in FIFO (moved only in flush callback) */
+        volatile uint32_t     finished;       /* Count of finished transfers (moved only in ready callback) */
+        lvgl_port_tx_stats_t  stats;          /* Statistics of transmit task */
+    } tx;
     struct {
         unsigned int monochrome: 1;  /* True, if display is monochrome and using 1bit for 1px */
+        unsigned int mono_i1: 1;     /* Monochrome display is rendered by LVGL in I1 format */
         unsigned int swap_bytes: 1;  /* Swap bytes in RGB656 (16-bit) before send to LCD driver */
         unsigned int full_refresh: 1;   /* Always make the whole screen redrawn */
         unsigned int direct_mode: 1;    /* Use screen-sized buffers and draw to absolute coordinates */
+        unsigned int coalesce: 1;       /* Merge invalidated areas before rendering */
+        unsigned int ring: 1;           /* Use ring of draw buffers */
+        unsigned int sw_rotate: 1;      /* Rotate in software, display stays in default orientation */
+        unsigned int ppa: 1;            /* Copy into the frame buffer by PPA, display stays in default orientation */
+        unsigned int fb_rgb888: 1;      /* Frame buffer is in RGB888 format */
+        unsigned int rgb_async: 1;      /* RGB frame buffers are switched in VSYNC interrupt without blocking LVGL task */
+        unsigned int stats: 1;          /* Collect statistics */
     } flags;
 } lvgl_port_display_ctx_t;
 
@@ -61,15 +228,55 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
 static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx);
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
 static bool lvgl_port_flush_vsync_ready_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
+static bool lvgl_port_flush_vsync_switch_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx);
 #endif
 #if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
 static bool lvgl_port_flush_panel_ready_callback(esp_lcd_panel_handle_t panel_io, esp_lcd_dpi_panel_event_data_t *edata, void *user_ctx);
 #endif
 #endif
 static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_monochrome(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map);
+static uint8_t *lvgl_port_flush_rotate(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map, lv_area_t *rotated_area);
+#if LVGL_PORT_PPA
+static esp_err_t lvgl_port_ppa_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_dsi_cfg_t *dsi_cfg);
+static bool lvgl_port_flush_ppa_ready_callback(ppa_client_handle_t ppa_client, ppa_event_data_t *event_data, void *user_data);
+static void lvgl_port_flush_ppa(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map);
+#endif
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static void lvgl_port_flush_swap_chunked(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_bounce(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map);
+static void lvgl_port_flush_trans_begin(lvgl_port_display_ctx_t *disp_ctx, uint32_t count);
+static void lvgl_port_ring_flush_end(lvgl_port_display_ctx_t *disp_ctx);
+static bool lvgl_port_ring_trans_done(lvgl_port_display_ctx_t *disp_ctx);
+static esp_err_t lvgl_port_tx_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg, lv_color_format_t color_format);
+static esp_err_t lvgl_port_tx_deinit(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_tx_task(void *arg);
+static void lvgl_port_flush_tx(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map);
+static uint8_t *lvgl_port_tx_alloc(lvgl_port_display_ctx_t *disp_ctx, uint32_t len);
+static bool lvgl_port_tx_done(lvgl_port_display_ctx_t *disp_ctx);
+#endif
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+static void lvgl_port_flush_rgb_async(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_rgb_render_start_callback(lv_event_t *e);
+static void lvgl_port_rgb_wait_vsync(lvgl_port_display_ctx_t *disp_ctx);
+static bool lvgl_port_rgb_take_free(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_rgb_mark_stale(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_rgb_sync(lvgl_port_display_ctx_t *disp_ctx, uint8_t dst);
+#endif
+static void lvgl_port_disp_init_render_bufs(lvgl_port_display_ctx_t *disp_ctx, lv_display_t *disp, void *const *bufs, uint8_t count, uint32_t size);
+static void lvgl_port_disp_set_render_buf(lvgl_port_display_ctx_t *disp_ctx, uint8_t idx);
+static void lvgl_port_stats_flush(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area);
+static void lvgl_port_stats_ready(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_display_stats_callback(lv_event_t *e);
 static void lvgl_port_disp_size_update_callback(lv_event_t *e);
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx);
 static void lvgl_port_display_invalidate_callback(lv_event_t *e);
+static void lvgl_port_display_render_start_callback(lv_event_t *e);
+static esp_err_t lvgl_port_disp_task_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg);
+static esp_err_t lvgl_port_disp_task_deinit(lvgl_port_display_ctx_t *disp_ctx);
+static void lvgl_port_disp_task(void *arg);
+static void lvgl_port_disp_refr_request_callback(lv_timer_t *timer);
+static bool lvgl_port_disp_notify(lvgl_port_display_ctx_t *disp_ctx, uint32_t value);
 
 /*******************************************************************************
 * Public API functions
@@ -105,6 +312,19 @@ lv_display_t *lvgl_port_add_disp(const lvgl_port_display_cfg_t *disp_cfg)
 
 lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_display_dsi_cfg_t *dsi_cfg)
 {
+    ESP_RETURN_ON_FALSE(disp_cfg->buffer_count == 0, NULL, TAG, "Draw buffers ring is supported only on I2C/SPI/I8080 displays!");
+    ESP_RETURN_ON_FALSE(disp_cfg->trans_size == 0, NULL, TAG, "Transport buffer is supported only on I2C/SPI/I8080 displays!");
+    ESP_RETURN_ON_FALSE(disp_cfg->tx_task.size == 0, NULL, TAG, "Transmit task is supported only on I2C/SPI/I8080 displays!");
+    if (dsi_cfg && dsi_cfg->flags.use_ppa) {
+#if LVGL_PORT_PPA
+        /* PPA reads RGB565 draw buffers and makes the rotation, the panel stays in default orientation */
+        ESP_RETURN_ON_FALSE(disp_cfg->color_format == 0 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB565, NULL, TAG, "PPA can be used only in display color format RGB565!");
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.sw_rotate && !disp_cfg->rotation.swap_xy, NULL, TAG, "PPA cannot be used with monochrome display, software rotation or swapped X and Y!");
+#else
+        ESP_RETURN_ON_FALSE(false, NULL, TAG, "PPA is supported only on ESP32P4 and from IDF 5.4!");
+#endif
+    }
+
     lvgl_port_lock(0);
     lv_disp_t *disp = lvgl_port_add_disp_priv(disp_cfg, NULL);
 
@@ -120,6 +340,15 @@ lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, co
         /* Register done callback */
         esp_lcd_dpi_panel_register_event_callbacks(disp_ctx->panel_handle, &cbs, disp);
 
+#if LVGL_PORT_PPA
+        if (dsi_cfg && dsi_cfg->flags.use_ppa && lvgl_port_ppa_init(disp_ctx, dsi_cfg) != ESP_OK) {
+            /* Render task finishes its refresh with LVGL mutex before the display is removed */
+            lvgl_port_unlock();
+            lvgl_port_remove_disp(disp);
+            return NULL;
+        }
+#endif
+
         /* Apply rotation from initial display configuration */
         lvgl_port_disp_rotation_update(disp_ctx);
 #else
@@ -133,10 +362,16 @@ lv_display_t *lvgl_port_add_disp_dsi(const lvgl_port_display_cfg_t *disp_cfg, co
 
 lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, const lvgl_port_display_rgb_cfg_t *rgb_cfg)
 {
+    ESP_RETURN_ON_FALSE(disp_cfg->buffer_count == 0, NULL, TAG, "Draw buffers ring is supported only on I2C/SPI/I8080 displays!");
+    ESP_RETURN_ON_FALSE(disp_cfg->trans_size == 0, NULL, TAG, "Transport buffer is supported only on I2C/SPI/I8080 displays!");
+    ESP_RETURN_ON_FALSE(disp_cfg->tx_task.size == 0, NULL, TAG, "Transmit task is supported only on I2C/SPI/I8080 displays!");
+
     lvgl_port_lock(0);
     assert(rgb_cfg != NULL);
     const lvgl_port_disp_priv_cfg_t priv_cfg = {
         .avoid_tearing = rgb_cfg->flags.avoid_tearing,
+        .nonblocking = rgb_cfg->flags.nonblocking,
+        .triple_buffer = rgb_cfg->flags.triple_buffer,
     };
     lv_disp_t *disp = lvgl_port_add_disp_priv(disp_cfg, &priv_cfg);
 
@@ -157,7 +392,19 @@ lv_display_t *lvgl_port_add_disp_rgb(const lvgl_port_display_cfg_t *disp_cfg, co
 #endif
         };
 
-        if (rgb_cfg->flags.bb_mode && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2))) {
+        /* Frame buffers are switched in interrupt, LVGL task is notified only when it waits for a free frame buffer */
+        const bool bb_frame_cb = (rgb_cfg->flags.bb_mode && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)));
+        const esp_lcd_rgb_panel_event_callbacks_t async_cbs = {
+            .on_vsync = (bb_frame_cb ? NULL : lvgl_port_flush_vsync_switch_callback),
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2)
+            .on_bounce_frame_finish = (bb_frame_cb ? lvgl_port_flush_vsync_switch_callback : NULL),
+#endif
+        };
+
+        if (disp_ctx->flags.rgb_async) {
+            ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &async_cbs, disp_ctx));
+            lv_display_add_event_cb(disp, lvgl_port_rgb_render_start_callback, LV_EVENT_RENDER_START, disp_ctx);
+        } else if (rgb_cfg->flags.bb_mode && (ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 1, 2))) {
             ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &bb_cbs, &disp_ctx->disp_drv));
         } else {
             ESP_ERROR_CHECK(esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &vsync_cbs, &disp_ctx->disp_drv));
@@ -179,27 +426,205 @@ esp_err_t lvgl_port_remove_disp(lv_display_t *disp)
     assert(disp);
     lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
 
+    /* Flush callback runs with LVGL mutex, no transfer is started after this */
+    lvgl_port_lock(0);
+    disp_ctx->removing = true;
+    lvgl_port_unlock();
+
+    /* Render task must not touch the display anymore, the refresh timer is handled in LVGL task until removing */
+    if (disp_ctx->task.handle) {
+        ESP_RETURN_ON_ERROR(lvgl_port_disp_task_deinit(disp_ctx), TAG, "Display is not removed, render task is not stopped!");
+    }
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    /* Queued transfers are sent and finished before the display is removed, their ready callback uses the display */
+    ESP_RETURN_ON_ERROR(lvgl_port_tx_deinit(disp_ctx), TAG, "Display is not removed, transmit task is not stopped!");
+#endif
+
     lvgl_port_lock(0);
+    /* Ready callbacks must not get the removed display */
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER) {
+        const esp_lcd_panel_io_callbacks_t io_cbs = { 0 };
+        esp_lcd_panel_io_register_event_callbacks(disp_ctx->io_handle, &io_cbs, NULL);
+    }
+#endif
+#if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_DSI) {
+        const esp_lcd_dpi_panel_event_callbacks_t dpi_cbs = { 0 };
+        esp_lcd_dpi_panel_register_event_callbacks(disp_ctx->panel_handle, &dpi_cbs, NULL);
+    }
+#endif
+#if (CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0))
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB) {
+        const esp_lcd_rgb_panel_event_callbacks_t rgb_cbs = { 0 };
+        esp_lcd_rgb_panel_register_event_callbacks(disp_ctx->panel_handle, &rgb_cbs, NULL);
+    }
+#endif
     lv_disp_remove(disp);
     lvgl_port_unlock();
 
-    if (disp_ctx->draw_buffs[0]) {
-        free(disp_ctx->draw_buffs[0]);
+    for (int i = 0; i < LVGL_PORT_DISP_BUFFERS_MAX; i++) {
+        if (disp_ctx->draw_buffs[i]) {
+            free(disp_ctx->draw_buffs[i]);
+        }
+    }
+
+    if (disp_ctx->ring.free) {
+        vQueueDelete(disp_ctx->ring.free);
+    }
+
+    if (disp_ctx->mono_buf) {
+        free(disp_ctx->mono_buf);
+    }
+
+    if (disp_ctx->rotate_buf) {
+        free(disp_ctx->rotate_buf);
     }
 
-    if (disp_ctx->draw_buffs[1]) {
-        free(disp_ctx->draw_buffs[1]);
+    if (disp_ctx->trans_buf[0]) {
+        free(disp_ctx->trans_buf[0]);
     }
 
+    if (disp_ctx->trans_buf[1]) {
+        free(disp_ctx->trans_buf[1]);
+    }
+
+    if (disp_ctx->trans_sem) {
+        vSemaphoreDelete(disp_ctx->trans_sem);
+    }
+
+#if LVGL_PORT_PPA
+    if (disp_ctx->ppa_client) {
+        ppa_unregister_client(disp_ctx->ppa_client);
+    }
+#endif
+
     free(disp_ctx);
 
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_disp_get_coalesce_stats(lv_display_t *disp, lvgl_port_coalesce_stats_t *stats, bool reset)
+{
+    assert(disp);
+    assert(stats);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx && disp_ctx->flags.coalesce, ESP_ERR_INVALID_STATE, TAG, "Coalescing is not enabled!");
+
+    lvgl_port_lock(0);
+    memcpy(stats, &disp_ctx->coalesce_stats, sizeof(lvgl_port_coalesce_stats_t));
+    if (reset) {
+        memset(&disp_ctx->coalesce_stats, 0, sizeof(lvgl_port_coalesce_stats_t));
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_get_tx_stats(lv_display_t *disp, lvgl_port_tx_stats_t *stats, bool reset)
+{
+    assert(disp);
+    assert(stats);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx && disp_ctx->tx.handle, ESP_ERR_INVALID_STATE, TAG, "Transmit task is not enabled!");
+
+    /* Counted in flush callback, which runs with LVGL mutex */
+    lvgl_port_lock(0);
+    memcpy(stats, &disp_ctx->tx.stats, sizeof(lvgl_port_tx_stats_t));
+    if (reset) {
+        memset(&disp_ctx->tx.stats, 0, sizeof(lvgl_port_tx_stats_t));
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_get_buffer_stats(lv_display_t *disp, lvgl_port_buffer_stats_t *stats, bool reset)
+{
+    assert(disp);
+    assert(stats);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx && disp_ctx->flags.ring, ESP_ERR_INVALID_STATE, TAG, "Draw buffers ring is not enabled!");
+
+    lvgl_port_lock(0);
+    memcpy(stats, &disp_ctx->ring.stats, sizeof(lvgl_port_buffer_stats_t));
+    if (reset) {
+        memset(&disp_ctx->ring.stats, 0, sizeof(lvgl_port_buffer_stats_t));
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_stats_enable(lv_display_t *disp, bool enable)
+{
+    assert(disp);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx, ESP_ERR_INVALID_STATE, TAG, "Display was not added by LVGL port!");
+
+    lvgl_port_lock(0);
+    if (enable && !disp_ctx->flags.stats) {
+        memset(&disp_ctx->stats, 0, sizeof(disp_ctx->stats));
+        disp_ctx->stats.start = esp_timer_get_time();
+        /* Render time is measured only when enabled, no event callbacks are called otherwise */
+        lv_display_add_event_cb(disp, lvgl_port_display_stats_callback, LV_EVENT_RENDER_START, disp_ctx);
+        lv_display_add_event_cb(disp, lvgl_port_display_stats_callback, LV_EVENT_RENDER_READY, disp_ctx);
+#if LVGL_PORT_STATS_FLUSH_WAIT
+        lv_display_add_event_cb(disp, lvgl_port_display_stats_callback, LV_EVENT_FLUSH_WAIT_START, disp_ctx);
+        lv_display_add_event_cb(disp, lvgl_port_display_stats_callback, LV_EVENT_FLUSH_WAIT_FINISH, disp_ctx);
+#endif
+        disp_ctx->flags.stats = 1;
+    } else if (!enable && disp_ctx->flags.stats) {
+        disp_ctx->flags.stats = 0;
+        lv_display_remove_event_cb_with_user_data(disp, lvgl_port_display_stats_callback, disp_ctx);
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_get_stats(lv_display_t *disp, lvgl_port_disp_stats_t *stats, bool reset)
+{
+    assert(disp);
+    assert(stats);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+    ESP_RETURN_ON_FALSE(disp_ctx && disp_ctx->flags.stats, ESP_ERR_INVALID_STATE, TAG, "Statistics are not enabled!");
+
+    lvgl_port_lock(0);
+    const int64_t now = esp_timer_get_time();
+    memcpy(stats, &disp_ctx->stats.data, sizeof(lvgl_port_disp_stats_t));
+    stats->elapsed_us = now - disp_ctx->stats.start;
+    if (reset) {
+        /* Pending frame and transfers are kept, they are counted into the next period */
+        memset(&disp_ctx->stats.data, 0, sizeof(lvgl_port_disp_stats_t));
+        disp_ctx->stats.start = now;
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_disp_log_stats(lv_display_t *disp, bool reset)
+{
+    lvgl_port_disp_stats_t stats;
+    char line[192];
+
+    ESP_RETURN_ON_ERROR(lvgl_port_disp_get_stats(disp, &stats, reset), TAG, "Get statistics failed");
+    lvgl_port_stats_format(&stats, line, sizeof(line));
+    ESP_LOGI(TAG, "Display %p: %s", disp, line);
+
+    return ESP_OK;
+}
+
 void lvgl_port_flush_ready(lv_display_t *disp)
 {
     assert(disp);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
     lv_disp_flush_ready(disp);
+    if (disp_ctx && disp_ctx->task.handle && lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_FLUSH)) {
+        portYIELD_FROM_ISR();
+    }
 }
 
 /*******************************************************************************
@@ -212,7 +637,10 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     lv_display_t *disp = NULL;
     lv_color_t *buf1 = NULL;
     lv_color_t *buf2 = NULL;
+    uint8_t *mono_buf = NULL;
     uint32_t buffer_size = 0;
+    uint32_t buffer_bytes = 0;
+    uint32_t buff_caps = MALLOC_CAP_DEFAULT;
     assert(disp_cfg != NULL);
     assert(disp_cfg->panel_handle != NULL);
     assert(disp_cfg->buffer_size > 0);
@@ -222,15 +650,69 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     buffer_size = disp_cfg->buffer_size;
 
     /* Check supported display color formats */
-    ESP_RETURN_ON_FALSE(disp_cfg->color_format == 0 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB565 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB888 || disp_cfg->color_format == LV_COLOR_FORMAT_XRGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_ARGB8888, NULL, TAG, "Not supported display color format!");
+    ESP_RETURN_ON_FALSE(disp_cfg->color_format == 0 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB565 || disp_cfg->color_format == LV_COLOR_FORMAT_RGB888 || disp_cfg->color_format == LV_COLOR_FORMAT_XRGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_ARGB8888 || disp_cfg->color_format == LV_COLOR_FORMAT_I1, NULL, TAG, "Not supported display color format!");
 
     lv_color_format_t display_color_format = (disp_cfg->color_format != 0 ? disp_cfg->color_format : LV_COLOR_FORMAT_RGB565);
+    buffer_bytes = buffer_size * sizeof(lv_color_t);
+    if (display_color_format == LV_COLOR_FORMAT_I1) {
+        /* I1 format can be used only for monochrome displays */
+        ESP_RETURN_ON_FALSE(disp_cfg->monochrome, NULL, TAG, "Color format I1 can be used only for monochrome display!");
+#if LVGL_PORT_MONO_I1
+        /* Rendered area is rounded to whole pages (8 lines) and whole bytes (8 columns) */
+        ESP_RETURN_ON_FALSE(buffer_size >= disp_cfg->hres * 8 && buffer_size >= disp_cfg->vres * 8, NULL, TAG, "Monochromatic display in I1 format must use buffer for at least 8 lines!");
+        buffer_bytes = lv_draw_buf_width_to_stride(disp_cfg->hres, LV_COLOR_FORMAT_I1) * (buffer_size / disp_cfg->hres) + LVGL_PORT_MONO_I1_PALETTE_SIZE;
+#else
+        ESP_RETURN_ON_FALSE(false, NULL, TAG, "Color format I1 is supported from LVGL 9.2!");
+#endif
+    }
     if (disp_cfg->flags.swap_bytes) {
         /* Swap bytes can be used only in RGB656 color format */
         ESP_RETURN_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565, NULL, TAG, "Swap bytes can be used only in display color format RGB565!");
     }
 
-    if (disp_cfg->flags.buff_dma) {
+    if (disp_cfg->buffer_count > 0) {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        /* LVGL renders into one buffer of the ring, the others are waiting for transfer or free */
+        ESP_RETURN_ON_FALSE(disp_cfg->buffer_count >= 2 && disp_cfg->buffer_count <= LVGL_PORT_DISP_BUFFERS_MAX, NULL, TAG, "Count of draw buffers in ring must be from 2 to %d!", LVGL_PORT_DISP_BUFFERS_MAX);
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.full_refresh && !disp_cfg->flags.direct_mode, NULL, TAG, "Draw buffers ring can be used only in partial mode!");
+#else
+        ESP_RETURN_ON_FALSE(false, NULL, TAG, "Draw buffers ring is not supported in this IDF version!");
+#endif
+    }
+
+    if (disp_cfg->flags.sw_rotate) {
+        /* Rotated area is sent from rotation buffer, so the draw buffer must contain only the flushed area */
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && !disp_cfg->flags.direct_mode && disp_cfg->buffer_count == 0 && !(priv_cfg && priv_cfg->avoid_tearing), NULL, TAG, "Software rotation cannot be used with monochrome display, direct mode, draw buffers ring or avoid tearing!");
+    }
+
+    if (disp_cfg->trans_size > 0) {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        /* Draw buffer is copied into transport buffers by whole lines */
+        ESP_RETURN_ON_FALSE(disp_cfg->trans_size >= LV_MAX(disp_cfg->hres, disp_cfg->vres), NULL, TAG, "Transport buffer must be bigger than one line!");
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && disp_cfg->buffer_count == 0, NULL, TAG, "Transport buffer cannot be used with monochrome display or draw buffers ring!");
+#else
+        ESP_RETURN_ON_FALSE(false, NULL, TAG, "Transport buffer is not supported in this IDF version!");
+#endif
+    }
+
+    if (disp_cfg->tx_task.size > 0) {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        /* Flushed areas are copied into transmit FIFO by whole lines */
+        ESP_RETURN_ON_FALSE(disp_cfg->tx_task.size >= LV_MAX(disp_cfg->hres, disp_cfg->vres), NULL, TAG, "Transmit FIFO must be bigger than one line!");
+        ESP_RETURN_ON_FALSE(disp_cfg->tx_task.max_pending <= LVGL_PORT_DISP_TX_PENDING_MAX, NULL, TAG, "Maximum count of pending transfers is %d!", LVGL_PORT_DISP_TX_PENDING_MAX);
+        ESP_RETURN_ON_FALSE(!disp_cfg->monochrome && disp_cfg->trans_size == 0 && disp_cfg->buffer_count == 0, NULL, TAG, "Transmit task cannot be used with monochrome display, transport buffer or draw buffers ring!");
+#else
+        ESP_RETURN_ON_FALSE(false, NULL, TAG, "Transmit task is not supported in this IDF version!");
+#endif
+    }
+
+    if (priv_cfg && (priv_cfg->nonblocking || priv_cfg->triple_buffer)) {
+        /* Whole frames are switched, the frame buffer with the previous frame is released in VSYNC interrupt */
+        ESP_RETURN_ON_FALSE(priv_cfg->avoid_tearing && priv_cfg->nonblocking, NULL, TAG, "Non-blocking mode and triple buffer can be used only with avoid tearing!");
+        ESP_RETURN_ON_FALSE(disp_cfg->flags.full_refresh || disp_cfg->flags.direct_mode, NULL, TAG, "Non-blocking mode can be used only with full refresh or direct mode!");
+    }
+
+    if (disp_cfg->flags.buff_dma && disp_cfg->trans_size == 0 && disp_cfg->tx_task.size == 0) {
         /* DMA buffer can be used only in RGB656 color format */
         ESP_RETURN_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565, NULL, TAG, "DMA buffer can be used only in display color format RGB565 (not alligned copy)!");
     }
@@ -246,42 +728,103 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     disp_ctx->rotation.mirror_x = disp_cfg->rotation.mirror_x;
     disp_ctx->rotation.mirror_y = disp_cfg->rotation.mirror_y;
     disp_ctx->flags.swap_bytes = disp_cfg->flags.swap_bytes;
+    disp_ctx->trans_size = disp_cfg->trans_size;
 
     /* Use RGB internal buffers for avoid tearing effect */
     if (priv_cfg && priv_cfg->avoid_tearing) {
 #if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
         buffer_size = disp_cfg->hres * disp_cfg->vres;
-        ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
+        if (priv_cfg->triple_buffer) {
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 3, (void *)&disp_ctx->rgb.fbs[0], (void *)&disp_ctx->rgb.fbs[1], (void *)&disp_ctx->rgb.fbs[2]), err, TAG, "Get RGB buffers failed");
+            disp_ctx->rgb.count = 3;
+        } else {
+            ESP_GOTO_ON_ERROR(esp_lcd_rgb_panel_get_frame_buffer(disp_cfg->panel_handle, 2, (void *)&buf1, (void *)&buf2), err, TAG, "Get RGB buffers failed");
+            disp_ctx->rgb.fbs[0] = (uint8_t *)buf1;
+            disp_ctx->rgb.fbs[1] = (uint8_t *)buf2;
+            disp_ctx->rgb.count = 2;
+        }
+
+        if (priv_cfg->nonblocking) {
+            /* Panel starts with the first frame buffer, LVGL gets only one buffer and renders into the next one */
+            disp_ctx->rgb.scan = 0;
+            disp_ctx->rgb.queued = -1;
+            disp_ctx->rgb.render = 1;
+            disp_ctx->rgb.latest = 0;
+            disp_ctx->flags.rgb_async = 1;
+            buf1 = (lv_color_t *)disp_ctx->rgb.fbs[1];
+            buf2 = NULL;
+        }
 #endif
     } else {
-        uint32_t buff_caps = MALLOC_CAP_DEFAULT;
-        if (disp_cfg->flags.buff_dma && disp_cfg->flags.buff_spiram) {
+        if (disp_cfg->flags.buff_dma && disp_cfg->flags.buff_spiram && (0 == disp_cfg->trans_size) && (0 == disp_cfg->tx_task.size)) {
             ESP_GOTO_ON_FALSE(false, ESP_ERR_NOT_SUPPORTED, err, TAG, "Alloc DMA capable buffer in SPIRAM is not supported!");
-        } else if (disp_cfg->flags.buff_dma) {
-            buff_caps = MALLOC_CAP_DMA;
         } else if (disp_cfg->flags.buff_spiram) {
+            /* With transport buffers or transmit FIFO, only they must be DMA capable */
             buff_caps = MALLOC_CAP_SPIRAM;
+        } else if (disp_cfg->flags.buff_dma) {
+            buff_caps = MALLOC_CAP_DMA;
+        }
+
+        if (disp_cfg->trans_size) {
+            /* Two buffers, the next one is filled during the transfer of the previous one */
+            const uint32_t trans_bytes = disp_cfg->trans_size * lv_color_format_get_size(display_color_format);
+            for (int i = 0; i < 2; i++) {
+                disp_ctx->trans_buf[i] = heap_caps_malloc(trans_bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+                ESP_GOTO_ON_FALSE(disp_ctx->trans_buf[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for buffer(transport) allocation!");
+            }
+
+            disp_ctx->trans_sem = xSemaphoreCreateCounting(2, 2);
+            ESP_GOTO_ON_FALSE(disp_ctx->trans_sem, ESP_ERR_NO_MEM, err, TAG, "Failed to create transport counting Semaphore");
         }
 
         /* alloc draw buffers used by LVGL */
         /* it's recommended to choose the size of the draw buffer(s) to be at least 1/10 screen sized */
-        buf1 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+        buf1 = heap_caps_malloc(buffer_bytes, buff_caps);
         ESP_GOTO_ON_FALSE(buf1, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf1) allocation!");
-        if (disp_cfg->double_buffer) {
-            buf2 = heap_caps_malloc(buffer_size * sizeof(lv_color_t), buff_caps);
+        disp_ctx->draw_buffs[0] = buf1;
+        if (disp_cfg->buffer_count > 0) {
+            /* LVGL gets only one buffer, the others are swapped in flush callback */
+            for (int i = 1; i < disp_cfg->buffer_count; i++) {
+                disp_ctx->draw_buffs[i] = heap_caps_malloc(buffer_bytes, buff_caps);
+                ESP_GOTO_ON_FALSE(disp_ctx->draw_buffs[i], ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (ring) allocation!");
+            }
+        } else if (disp_cfg->double_buffer) {
+            buf2 = heap_caps_malloc(buffer_bytes, buff_caps);
             ESP_GOTO_ON_FALSE(buf2, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for LVGL buffer (buf2) allocation!");
+            disp_ctx->draw_buffs[1] = buf2;
         }
 
-        disp_ctx->draw_buffs[0] = buf1;
-        disp_ctx->draw_buffs[1] = buf2;
+        if (disp_cfg->flags.sw_rotate) {
+            /* Allocated once, every flushed area is rotated into this buffer */
+            disp_ctx->rotate_buf = heap_caps_malloc(buffer_bytes, buff_caps);
+            ESP_GOTO_ON_FALSE(disp_ctx->rotate_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for rotation buffer allocation!");
+            disp_ctx->flags.sw_rotate = 1;
+        }
     }
 
     disp = lv_display_create(disp_cfg->hres, disp_cfg->vres);
 
     /* Monochrome display settings */
-    if (disp_cfg->monochrome) {
+    if (disp_cfg->monochrome && display_color_format == LV_COLOR_FORMAT_I1) {
+        /* Converted data in page layout are sent from separate buffer, one more page line for areas cut on the bottom edge */
+        mono_buf = heap_caps_malloc(buffer_bytes + LV_MAX(disp_cfg->hres, disp_cfg->vres), buff_caps);
+        ESP_GOTO_ON_FALSE(mono_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for monochrome buffer allocation!");
+        disp_ctx->mono_buf = mono_buf;
+
+        disp_ctx->flags.monochrome = 1;
+        disp_ctx->flags.mono_i1 = 1;
+        disp_ctx->flags.full_refresh = disp_cfg->flags.full_refresh;
+        lv_display_set_color_format(disp, display_color_format);
+        lv_display_set_buffers(disp, buf1, buf2, buffer_bytes, (disp_cfg->flags.full_refresh ? LV_DISPLAY_RENDER_MODE_FULL : LV_DISPLAY_RENDER_MODE_PARTIAL));
+    } else if (disp_cfg->monochrome) {
         /* When using monochromatic display, there must be used full bufer! */
         ESP_GOTO_ON_FALSE((disp_cfg->hres * disp_cfg->vres == buffer_size), ESP_ERR_INVALID_ARG, err, TAG, "Monochromatic display must using full buffer!");
+        ESP_GOTO_ON_FALSE(display_color_format == LV_COLOR_FORMAT_RGB565, ESP_ERR_INVALID_ARG, err, TAG, "Monochromatic display must use color format RGB565!");
+
+        /* Converted data in page layout are sent from separate buffer */
+        mono_buf = heap_caps_malloc(lvgl_port_mono_pages_size(disp_cfg->hres, disp_cfg->vres), buff_caps);
+        ESP_GOTO_ON_FALSE(mono_buf, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for monochrome buffer allocation!");
+        disp_ctx->mono_buf = mono_buf;
 
         disp_ctx->flags.monochrome = 1;
         lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_FULL);
@@ -299,9 +842,31 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
         lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_FULL);
     } else {
         lv_display_set_buffers(disp, buf1, buf2, buffer_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+
+        if (disp_cfg->buffer_count > 0) {
+            disp_ctx->ring.free = xQueueCreate(LVGL_PORT_DISP_BUFFERS_MAX, sizeof(uint8_t));
+            ESP_GOTO_ON_FALSE(disp_ctx->ring.free, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for draw buffers ring allocation!");
+            for (uint8_t i = 1; i < disp_cfg->buffer_count; i++) {
+                xQueueSend(disp_ctx->ring.free, &i, 0);
+            }
+            disp_ctx->ring.render = 0;
+            disp_ctx->flags.ring = 1;
+        }
+
+        /* Merging of invalidated areas makes sense only in partial mode */
+        if (disp_cfg->coalesce_overdraw > 0) {
+            disp_ctx->flags.coalesce = 1;
+            disp_ctx->coalesce_overdraw = disp_cfg->coalesce_overdraw;
+            lv_display_add_event_cb(disp, lvgl_port_display_render_start_callback, LV_EVENT_RENDER_START, disp_ctx);
+        }
     }
 
     lv_display_set_color_format(disp, display_color_format);
+    if (disp_ctx->flags.ring) {
+        lvgl_port_disp_init_render_bufs(disp_ctx, disp, (void *const *)disp_ctx->draw_buffs, disp_cfg->buffer_count, buffer_size * sizeof(lv_color_t));
+    } else if (disp_ctx->flags.rgb_async) {
+        lvgl_port_disp_init_render_bufs(disp_ctx, disp, (void *const *)disp_ctx->rgb.fbs, disp_ctx->rgb.count, buffer_size * sizeof(lv_color_t));
+    }
     lv_display_set_flush_cb(disp, lvgl_port_flush_callback);
     lv_display_add_event_cb(disp, lvgl_port_disp_size_update_callback, LV_EVENT_RESOLUTION_CHANGED, disp_ctx);
     lv_display_add_event_cb(disp, lvgl_port_display_invalidate_callback, LV_EVENT_INVALIDATE_AREA, disp_ctx);
@@ -310,15 +875,50 @@ static lv_display_t *lvgl_port_add_disp_priv(const lvgl_port_display_cfg_t *disp
     lv_display_set_user_data(disp, disp_ctx);
     disp_ctx->disp_drv = disp;
 
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    if (disp_cfg->tx_task.size > 0) {
+        ESP_GOTO_ON_ERROR(lvgl_port_tx_init(disp_ctx, disp_cfg, display_color_format), err, TAG, "Create display transmit task failed!");
+    }
+#endif
+
+    if (disp_cfg->flags.own_task) {
+        ESP_GOTO_ON_ERROR(lvgl_port_disp_task_init(disp_ctx, disp_cfg), err, TAG, "Create display render task failed!");
+    }
+
 err:
     if (ret != ESP_OK) {
-        if (buf1) {
-            free(buf1);
+        if (disp) {
+            lv_display_delete(disp);
+            disp = NULL;
         }
-        if (buf2) {
-            free(buf2);
+        if (mono_buf) {
+            free(mono_buf);
         }
         if (disp_ctx) {
+            /* RGB frame buffers are not stored in context */
+            for (int i = 0; i < LVGL_PORT_DISP_BUFFERS_MAX; i++) {
+                if (disp_ctx->draw_buffs[i]) {
+                    free(disp_ctx->draw_buffs[i]);
+                }
+            }
+            if (disp_ctx->ring.free) {
+                vQueueDelete(disp_ctx->ring.free);
+            }
+            if (disp_ctx->rotate_buf) {
+                free(disp_ctx->rotate_buf);
+            }
+            if (disp_ctx->trans_buf[0]) {
+                free(disp_ctx->trans_buf[0]);
+            }
+            if (disp_ctx->trans_buf[1]) {
+                free(disp_ctx->trans_buf[1]);
+            }
+            if (disp_ctx->trans_sem) {
+                vSemaphoreDelete(disp_ctx->trans_sem);
+            }
+#if LVGL_PORT_HANDLE_FLUSH_READY
+            lvgl_port_tx_deinit(disp_ctx);
+#endif
             free(disp_ctx);
         }
     }
@@ -331,8 +931,44 @@ static bool lvgl_port_flush_io_ready_callback(esp_lcd_panel_io_handle_t panel_io
 {
     lv_display_t *disp_drv = (lv_display_t *)user_ctx;
     assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp_drv);
+    assert(disp_ctx != NULL);
+
+    LVGL_PORT_TRACE(LVGL_PORT_TRACE_FLUSH_READY, LVGL_PORT_TRACE_INSTANT, 0, 0);
+
+    /* Copy in transmit FIFO is sent, LVGL got the draw buffer back in flush callback */
+    if (disp_ctx->tx.handle) {
+        return lvgl_port_tx_done(disp_ctx);
+    }
+
+    /* Transport buffer is free, the draw buffer was released in flush callback */
+    if (disp_ctx->trans_sem) {
+        BaseType_t need_yield = pdFALSE;
+        xSemaphoreGiveFromISR(disp_ctx->trans_sem, &need_yield);
+        /* Both transport buffers are free, nothing is pending */
+        if (disp_ctx->flags.stats && uxSemaphoreGetCountFromISR(disp_ctx->trans_sem) == 2) {
+            lvgl_port_stats_ready(disp_ctx);
+        }
+        return (need_yield == pdTRUE);
+    }
+
+    /* Flush was already finished for LVGL, only the draw buffer is released */
+    if (disp_ctx->flags.ring) {
+        return lvgl_port_ring_trans_done(disp_ctx);
+    }
+
+    /* Flush is divided into more transfers, wait for the last one */
+    if (disp_ctx->trans_pending > 1) {
+        disp_ctx->trans_pending--;
+        return false;
+    }
+    disp_ctx->trans_pending = 0;
+
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
     lv_disp_flush_ready(disp_drv);
-    return false;
+    return (disp_ctx->task.handle && lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_FLUSH));
 }
 
 #if (CONFIG_IDF_TARGET_ESP32P4 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 3, 0))
@@ -340,8 +976,13 @@ static bool lvgl_port_flush_panel_ready_callback(esp_lcd_panel_handle_t panel_io
 {
     lv_display_t *disp_drv = (lv_display_t *)user_ctx;
     assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp_drv);
+    LVGL_PORT_TRACE(LVGL_PORT_TRACE_FLUSH_READY, LVGL_PORT_TRACE_INSTANT, 0, 0);
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
     lv_disp_flush_ready(disp_drv);
-    return false;
+    return (disp_ctx->task.handle && lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_FLUSH));
 }
 #endif
 
@@ -352,7 +993,12 @@ static bool lvgl_port_flush_vsync_ready_callback(esp_lcd_panel_handle_t panel_io
 
     lv_display_t *disp_drv = (lv_display_t *)user_ctx;
     assert(disp_drv != NULL);
-    need_yield = lvgl_port_task_notify(ULONG_MAX);
+    /* Registered with pointer to display handle in the context */
+    lvgl_port_display_ctx_t *disp_ctx = __containerof(user_ctx, lvgl_port_display_ctx_t, disp_drv);
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
+    need_yield = lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_VSYNC);
     lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, disp_drv);
 
     return (need_yield == pdTRUE);
@@ -360,83 +1006,910 @@ static bool lvgl_port_flush_vsync_ready_callback(esp_lcd_panel_handle_t panel_io
 #endif
 #endif
 
-static void _lvgl_port_transform_monochrome(lv_display_t *display, const lv_area_t *area, uint8_t *color_map)
+#if LVGL_PORT_PPA
+static esp_err_t lvgl_port_ppa_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_dsi_cfg_t *dsi_cfg)
 {
-    uint8_t *buf = color_map;
-    lv_color_t *color = (lv_color_t *)color_map;
-    uint16_t hor_res = lv_display_get_physical_horizontal_resolution(display);
-    uint16_t ver_res = lv_display_get_physical_vertical_resolution(display);
-    uint16_t res = hor_res;
-    bool swap_xy = (lv_display_get_rotation(display) == LV_DISPLAY_ROTATION_90 || lv_display_get_rotation(display) == LV_DISPLAY_ROTATION_270);
+    void *fb = NULL;
 
-    int x1 = area->x1;
-    int x2 = area->x2;
-    int y1 = area->y1;
-    int y2 = area->y2;
+    ESP_RETURN_ON_ERROR(esp_lcd_dpi_panel_get_frame_buffer(disp_ctx->panel_handle, 1, &fb), TAG, "Get MIPI-DSI frame buffer failed");
 
-    int out_x, out_y;
-    for (int y = y1; y <= y2; y++) {
-        for (int x = x1; x <= x2; x++) {
-            bool chroma_color = (color[hor_res * y + x].blue > 16);
+    const ppa_client_config_t ppa_cfg = {
+        .oper_type = PPA_OPERATION_SRM,
+        /* LVGL waits for flush ready, so only one copy is pending */
+        .max_pending_trans_num = 1,
+    };
+    ESP_RETURN_ON_ERROR(ppa_register_client(&ppa_cfg, &disp_ctx->ppa_client), TAG, "PPA client register failed");
 
-            if (swap_xy) {
-                out_x = y;
-                out_y = x;
-                res = ver_res;
-            } else {
-                out_x = x;
-                out_y = y;
-                res = hor_res;
-            }
+    const ppa_event_callbacks_t cbs = {
+        .on_trans_done = lvgl_port_flush_ppa_ready_callback,
+    };
+    ESP_RETURN_ON_ERROR(ppa_client_register_event_callbacks(disp_ctx->ppa_client, &cbs), TAG, "PPA callback register failed");
 
-            /* Write to the buffer as required for the display.
-            * It writes only 1-bit for monochrome displays mapped vertically.*/
-            buf = color_map + res * (out_y >> 3) + (out_x);
-            if (chroma_color) {
-                (*buf) &= ~(1 << (out_y % 8));
-            } else {
-                (*buf) |= (1 << (out_y % 8));
-            }
-        }
+    disp_ctx->ppa_fb = fb;
+    disp_ctx->flags.ppa = 1;
+    disp_ctx->flags.fb_rgb888 = dsi_cfg->flags.fb_rgb888;
+
+    return ESP_OK;
+}
+
+static bool lvgl_port_flush_ppa_ready_callback(ppa_client_handle_t ppa_client, ppa_event_data_t *event_data, void *user_data)
+{
+    lv_display_t *disp_drv = (lv_display_t *)user_data;
+    assert(disp_drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp_drv);
+    LVGL_PORT_TRACE(LVGL_PORT_TRACE_FLUSH_READY, LVGL_PORT_TRACE_INSTANT, 0, 0);
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
     }
+    lv_disp_flush_ready(disp_drv);
+    return (disp_ctx->task.handle && lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_FLUSH));
 }
 
-static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+static void lvgl_port_flush_ppa(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map)
 {
-    assert(drv != NULL);
-    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(drv);
-    assert(disp_ctx != NULL);
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const lvgl_port_blit_cfg_t cfg = {
+        .hres = lv_display_get_horizontal_resolution(disp),
+        .vres = lv_display_get_vertical_resolution(disp),
+        /* LVGL rotations are in the same order (0, 90, 180, 270) */
+        .rotation = (lvgl_port_rotate_t)lv_display_get_rotation(disp),
+        .mirror_x = disp_ctx->rotation.mirror_x,
+        .mirror_y = disp_ctx->rotation.mirror_y,
+        .swap_bytes = disp_ctx->flags.swap_bytes,
+        .rgb888 = disp_ctx->flags.fb_rgb888,
+    };
+    const bool swap_xy = (cfg.rotation == LVGL_PORT_ROTATE_90 || cfg.rotation == LVGL_PORT_ROTATE_270);
+    const uint32_t fb_w = (swap_xy ? cfg.vres : cfg.hres);
+    const uint32_t fb_h = (swap_xy ? cfg.hres : cfg.vres);
+    const uint32_t fb_px_size = (cfg.rgb888 ? 3 : 2);
+    const lvgl_port_area_t src_area = {area->x1, area->y1, area->x2, area->y2};
+    lvgl_port_area_t fb_area;
+
+    lvgl_port_blit_get_area(&cfg, &src_area, &fb_area);
+
+    /* In direct mode, the area is a block of the screen sized buffer */
+    const bool direct = disp_ctx->flags.direct_mode;
+    const uint32_t src_w = (direct ? cfg.hres : lvgl_port_area_get_width(&src_area));
+    const uint32_t src_h = (direct ? cfg.vres : lvgl_port_area_get_height(&src_area));
+    const uint32_t src_x = (direct ? area->x1 : 0);
+    const uint32_t src_y = (direct ? area->y1 : 0);
+
+    static const ppa_srm_rotation_angle_t angles[] = {
+        PPA_SRM_ROTATION_ANGLE_0, PPA_SRM_ROTATION_ANGLE_90, PPA_SRM_ROTATION_ANGLE_180, PPA_SRM_ROTATION_ANGLE_270,
+    };
+    const ppa_srm_oper_config_t srm_cfg = {
+        .in = {
+            .buffer = color_map,
+            .pic_w = src_w,
+            .pic_h = src_h,
+            .block_w = lvgl_port_area_get_width(&src_area),
+            .block_h = lvgl_port_area_get_height(&src_area),
+            .block_offset_x = src_x,
+            .block_offset_y = src_y,
+            .srm_cm = PPA_SRM_COLOR_MODE_RGB565,
+        },
+        .out = {
+            .buffer = disp_ctx->ppa_fb,
+            .buffer_size = fb_w * fb_h * fb_px_size,
+            .pic_w = fb_w,
+            .pic_h = fb_h,
+            .block_offset_x = fb_area.x1,
+            .block_offset_y = fb_area.y1,
+            .srm_cm = (cfg.rgb888 ? PPA_SRM_COLOR_MODE_RGB888 : PPA_SRM_COLOR_MODE_RGB565),
+        },
+        /* Both PPA and LVGL rotate counterclockwise, mirroring is made after rotation (same as lvgl_port_blit_rgb565) */
+        .rotation_angle = angles[cfg.rotation],
+        .scale_x = 1.0f,
+        .scale_y = 1.0f,
+        .mirror_x = cfg.mirror_x,
+        .mirror_y = cfg.mirror_y,
+        .byte_swap = cfg.swap_bytes,
+        .mode = PPA_TRANS_MODE_NON_BLOCKING,
+        .user_data = disp,
+    };
 
-    if (disp_ctx->flags.swap_bytes) {
-        size_t len = lv_area_get_size(area);
-        lv_draw_sw_rgb565_swap(color_map, len);
+    if (ppa_do_scale_rotate_mirror(disp_ctx->ppa_client, &srm_cfg) == ESP_OK) {
+        return;
     }
 
-    /* Transfor data in buffer for monochromatic screen */
-    if (disp_ctx->flags.monochrome) {
-        _lvgl_port_transform_monochrome(drv, area, color_map);
+    /* Copy by CPU, when the PPA transaction cannot be started */
+    ESP_LOGW(TAG, "PPA copy failed, copying by CPU");
+    lvgl_port_blit_rgb565(&cfg, disp_ctx->ppa_fb, (const uint16_t *)color_map + src_y * src_w + src_x, src_w, &src_area);
+    uint8_t *rows = disp_ctx->ppa_fb + fb_area.y1 * fb_w * fb_px_size;
+    esp_cache_msync(rows, lvgl_port_area_get_height(&fb_area) * fb_w * fb_px_size, ESP_CACHE_MSYNC_FLAG_DIR_C2M | ESP_CACHE_MSYNC_FLAG_UNALIGNED);
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
     }
+    lv_disp_flush_ready(disp);
+}
+#endif
 
-    const int offsetx1 = area->x1;
-    const int offsetx2 = area->x2;
-    const int offsety1 = area->y1;
-    const int offsety2 = area->y2;
+static uint8_t *lvgl_port_flush_rotate(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map, lv_area_t *rotated_area)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const uint32_t width = lv_area_get_width(area);
+    const uint32_t height = lv_area_get_height(area);
+    /* LVGL rotations are in the same order (0, 90, 180, 270) */
+    const lvgl_port_rotate_t rotation = (lvgl_port_rotate_t)lv_display_get_rotation(disp);
+
+    switch (lv_display_get_color_format(disp)) {
+    case LV_COLOR_FORMAT_RGB565:
+        lvgl_port_rotate_rgb565((uint16_t *)disp_ctx->rotate_buf, (const uint16_t *)color_map, width, height, rotation, LVGL_PORT_ROTATE_TILE);
+        break;
+    case LV_COLOR_FORMAT_RGB888:
+        lvgl_port_rotate_rgb888(disp_ctx->rotate_buf, color_map, width, height, rotation, LVGL_PORT_ROTATE_TILE);
+        break;
+    default:
+        lvgl_port_rotate_argb8888((uint32_t *)disp_ctx->rotate_buf, (const uint32_t *)color_map, width, height, rotation, LVGL_PORT_ROTATE_TILE);
+        break;
+    }
 
-    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB && (disp_ctx->flags.full_refresh || disp_ctx->flags.direct_mode)) {
-        if (lv_disp_flush_is_last(drv)) {
-            /* If the interface is I80 or SPI, this step cannot be used for drawing. */
+    /* Area on the display in default orientation */
+    lvgl_port_area_t tmp = {area->x1, area->y1, area->x2, area->y2};
+    lvgl_port_rotate_area(&tmp, lv_display_get_horizontal_resolution(disp), lv_display_get_vertical_resolution(disp), rotation);
+    rotated_area->x1 = tmp.x1;
+    rotated_area->y1 = tmp.y1;
+    rotated_area->x2 = tmp.x2;
+    rotated_area->y2 = tmp.y2;
+
+    return disp_ctx->rotate_buf;
+}
+
+static void lvgl_port_flush_monochrome(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map)
+{
+    const int32_t width = lv_area_get_width(area);
+    const int32_t height = lv_area_get_height(area);
+    const lv_display_rotation_t rotation = lv_display_get_rotation(disp_ctx->disp_drv);
+    const bool swap_xy = (rotation == LV_DISPLAY_ROTATION_90 || rotation == LV_DISPLAY_ROTATION_270);
+
+    /* Data are converted into separate buffer in page layout of the display (8 vertical pixels in one byte) */
+#if LVGL_PORT_MONO_I1
+    if (disp_ctx->flags.mono_i1) {
+        const uint32_t stride = lv_draw_buf_width_to_stride(width, LV_COLOR_FORMAT_I1);
+        /* Skip palette */
+        color_map += LVGL_PORT_MONO_I1_PALETTE_SIZE;
+        if (swap_xy) {
+            lvgl_port_mono_i1_to_pages_swap_xy(disp_ctx->mono_buf, color_map, stride, width, height);
+        } else {
+            lvgl_port_mono_i1_to_pages(disp_ctx->mono_buf, color_map, stride, width, height);
+        }
+    } else
+#endif
+    {
+        if (swap_xy) {
+            lvgl_port_mono_rgb565_to_pages_swap_xy(disp_ctx->mono_buf, (const uint16_t *)color_map, width, height);
+        } else {
+            lvgl_port_mono_rgb565_to_pages(disp_ctx->mono_buf, (const uint16_t *)color_map, width, height);
+        }
+    }
+
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, area->x1, area->y1, area->x2 + 1, area->y2 + 1, disp_ctx->mono_buf);
+}
+
+static void lvgl_port_flush_callback(lv_display_t *drv, const lv_area_t *area, uint8_t *color_map)
+{
+    assert(drv != NULL);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(drv);
+    assert(disp_ctx != NULL);
+
+    /* Display is being removed, its transfers are not sent anymore */
+    if (disp_ctx->removing) {
+        lv_disp_flush_ready(drv);
+        return;
+    }
+
+    LVGL_PORT_TRACE(LVGL_PORT_TRACE_FLUSH, LVGL_PORT_TRACE_INSTANT, LVGL_PORT_TRACE_XY(area->x1, area->y1), LVGL_PORT_TRACE_XY(area->x2, area->y2));
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_flush(disp_ctx, area);
+    }
+
+    /* Rotate area into rotation buffer, the rest of the flush works with rotated area */
+    lv_area_t rotated_area;
+    if (disp_ctx->flags.sw_rotate && lv_display_get_rotation(drv) != LV_DISPLAY_ROTATION_0) {
+        color_map = lvgl_port_flush_rotate(disp_ctx, area, color_map, &rotated_area);
+        area = &rotated_area;
+    }
+
+#if LVGL_PORT_PPA
+    /* PPA writes directly into the frame buffer, flush is finished in the PPA done callback */
+    if (disp_ctx->flags.ppa) {
+        lvgl_port_flush_ppa(disp_ctx, area, color_map);
+        return;
+    }
+#endif
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    /* Copy into transmit FIFO, transmit task sends it (bytes are swapped during copy) */
+    if (disp_ctx->tx.handle) {
+        lvgl_port_flush_tx(disp_ctx, area, color_map);
+        return;
+    }
+
+    /* Send through SRAM transport buffers (bytes are swapped during copy) */
+    if (disp_ctx->trans_size && disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER) {
+        lvgl_port_flush_bounce(disp_ctx, area, color_map);
+        return;
+    }
+
+    /* Swap bytes in chunks, the next chunk is swapped while the previous one is transferred */
+    if (disp_ctx->flags.swap_bytes && !disp_ctx->flags.monochrome && disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER) {
+        lvgl_port_flush_swap_chunked(disp_ctx, area, color_map);
+        if (disp_ctx->flags.ring) {
+            lvgl_port_ring_flush_end(disp_ctx);
+        }
+        return;
+    }
+#endif
+
+    /* Transform data for monochromatic screen (bytes are not swapped, output has 1 bit per pixel) */
+    if (disp_ctx->flags.monochrome) {
+        lvgl_port_flush_monochrome(disp_ctx, area, color_map);
+        return;
+    }
+
+    if (disp_ctx->flags.swap_bytes) {
+        size_t len = lv_area_get_size(area);
+        lvgl_port_rgb565_swap((uint16_t *)color_map, (uint16_t *)color_map, len);
+    }
+
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    /* LVGL task waits only when no frame buffer is free */
+    if (disp_ctx->flags.rgb_async) {
+        lvgl_port_flush_rgb_async(disp_ctx);
+        return;
+    }
+#endif
+
+    const int offsetx1 = area->x1;
+    const int offsetx2 = area->x2;
+    const int offsety1 = area->y1;
+    const int offsety2 = area->y2;
+
+    if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB && (disp_ctx->flags.full_refresh || disp_ctx->flags.direct_mode)) {
+        if (lv_disp_flush_is_last(drv)) {
+            /* If the interface is I80 or SPI, this step cannot be used for drawing. */
             esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
             /* Waiting for the last frame buffer to complete transmission */
-            ulTaskNotifyValueClear(NULL, ULONG_MAX);
-            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            ulTaskNotifyValueClear(NULL, LVGL_PORT_NOTIFY_VSYNC);
+            lvgl_port_task_wait_notify(LVGL_PORT_NOTIFY_VSYNC);
         }
     } else {
+#if LVGL_PORT_HANDLE_FLUSH_READY
+        if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_OTHER) {
+            lvgl_port_flush_trans_begin(disp_ctx, 1);
+        }
+#endif
         esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
     }
 
     if (disp_ctx->disp_type == LVGL_PORT_DISP_TYPE_RGB) {
+        /* Copied into frame buffer or shown after VSYNC */
+        if (disp_ctx->flags.stats) {
+            lvgl_port_stats_ready(disp_ctx);
+        }
         lv_disp_flush_ready(drv);
     }
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+    if (disp_ctx->flags.ring) {
+        lvgl_port_ring_flush_end(disp_ctx);
+    }
+#endif
+}
+
+#if LVGL_PORT_HANDLE_FLUSH_READY
+static void lvgl_port_flush_swap_chunked(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map)
+{
+    const int32_t width = lv_area_get_width(area);
+    const int32_t height = lv_area_get_height(area);
+    uint16_t *buf = (uint16_t *)color_map;
+
+    /* Divide area into chunks of whole lines */
+    int32_t chunk_lines = (height + LVGL_PORT_SWAP_CHUNKS - 1) / LVGL_PORT_SWAP_CHUNKS;
+    if (chunk_lines * width < LVGL_PORT_SWAP_CHUNK_MIN_PX) {
+        chunk_lines = (LVGL_PORT_SWAP_CHUNK_MIN_PX + width - 1) / width;
+    }
+    if (chunk_lines > height) {
+        chunk_lines = height;
+    }
+
+    lvgl_port_flush_trans_begin(disp_ctx, (height + chunk_lines - 1) / chunk_lines);
+
+    for (int32_t y1 = area->y1; y1 <= area->y2; y1 += chunk_lines) {
+        const int32_t y2 = (y1 + chunk_lines - 1 < area->y2 ? y1 + chunk_lines - 1 : area->y2);
+        const uint32_t len = (uint32_t)(y2 - y1 + 1) * width;
+
+        lvgl_port_rgb565_swap(buf, buf, len);
+        /* Transfer is queued in the panel IO, the next chunk is swapped during this transfer */
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, area->x1, y1, area->x2 + 1, y2 + 1, buf);
+        buf += len;
+    }
+}
+
+static void lvgl_port_flush_bounce(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map)
+{
+    const int32_t width = lv_area_get_width(area);
+    const int32_t height = lv_area_get_height(area);
+    const uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(disp_ctx->disp_drv));
+    const int32_t max_lines = LV_MIN((int32_t)(disp_ctx->trans_size / width), height);
+    const uint8_t *from = color_map;
+
+    for (int32_t y1 = area->y1; y1 <= area->y2; y1 += max_lines) {
+        const int32_t y2 = LV_MIN(y1 + max_lines - 1, area->y2);
+        const uint32_t len = (uint32_t)(y2 - y1 + 1) * width;
+        /* Buffers are used in turns, so the free one is always the one transferred earlier */
+        uint8_t *to = disp_ctx->trans_buf[disp_ctx->trans_buf_idx];
+        disp_ctx->trans_buf_idx ^= 1;
+
+        /* Wait for the transfer from this buffer, the other buffer is being transferred meanwhile */
+        xSemaphoreTake(disp_ctx->trans_sem, portMAX_DELAY);
+        if (disp_ctx->flags.swap_bytes) {
+            lvgl_port_rgb565_swap((uint16_t *)to, (const uint16_t *)from, len);
+        } else {
+            memcpy(to, from, len * px_size);
+        }
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, area->x1, y1, area->x2 + 1, y2 + 1, to);
+        from += len * px_size;
+        /* Bus could be idle, when the copy was slower than the previous transfer */
+        if (disp_ctx->flags.stats && disp_ctx->stats.busy_start == 0) {
+            disp_ctx->stats.busy_start = esp_timer_get_time();
+        }
+    }
+
+    /* Draw buffer was copied, LVGL can render the next area during the last transfers */
+    lv_disp_flush_ready(disp_ctx->disp_drv);
+}
+
+/* Must be called before the first transfer of the flush, the ready callback counts down to the last transfer */
+static void lvgl_port_flush_trans_begin(lvgl_port_display_ctx_t *disp_ctx, uint32_t count)
+{
+    if (disp_ctx->flags.ring) {
+        const uint32_t tail = disp_ctx->ring.tail;
+        disp_ctx->ring.in_flight[tail % LVGL_PORT_DISP_BUFFERS_MAX].buf = disp_ctx->ring.render;
+        disp_ctx->ring.in_flight[tail % LVGL_PORT_DISP_BUFFERS_MAX].pending = count;
+        disp_ctx->ring.tail = tail + 1;
+    } else {
+        disp_ctx->trans_pending = count;
+    }
+}
+
+/* Transfers of the flushed buffer are queued, LVGL continues rendering into the next free buffer */
+static void lvgl_port_ring_flush_end(lvgl_port_display_ctx_t *disp_ctx)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    lvgl_port_buffer_stats_t *stats = &disp_ctx->ring.stats;
+    uint8_t next = 0;
+
+    if (xQueueReceive(disp_ctx->ring.free, &next, 0) != pdTRUE) {
+        /* All buffers are in flight, wait for the oldest one */
+        const int64_t start = esp_timer_get_time();
+        xQueueReceive(disp_ctx->ring.free, &next, portMAX_DELAY);
+        stats->stall_time_us += esp_timer_get_time() - start;
+        stats->stalls++;
+    }
+
+    const uint32_t in_flight = disp_ctx->ring.tail - disp_ctx->ring.head;
+    stats->flushes++;
+    stats->in_flight[in_flight <= LVGL_PORT_DISP_BUFFERS_MAX ? in_flight : LVGL_PORT_DISP_BUFFERS_MAX]++;
+    if (in_flight > stats->max_in_flight) {
+        stats->max_in_flight = in_flight;
+    }
+
+    /* LVGL uses one draw buffer only, its memory is changed to the free one */
+    disp_ctx->ring.render = next;
+    lvgl_port_disp_set_render_buf(disp_ctx, next);
+    lv_disp_flush_ready(disp);
+}
+
+static bool lvgl_port_ring_trans_done(lvgl_port_display_ctx_t *disp_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+    const uint32_t head = disp_ctx->ring.head;
+
+    if (head == disp_ctx->ring.tail) {
+        return false;
+    }
+
+    /* Flush is divided into more transfers, wait for the last one */
+    if (--disp_ctx->ring.in_flight[head % LVGL_PORT_DISP_BUFFERS_MAX].pending > 0) {
+        return false;
+    }
+
+    const uint8_t buf = disp_ctx->ring.in_flight[head % LVGL_PORT_DISP_BUFFERS_MAX].buf;
+    disp_ctx->ring.head = head + 1;
+    /* The last flush in flight is on the panel */
+    if (disp_ctx->flags.stats && disp_ctx->ring.head == disp_ctx->ring.tail) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
+    if (xPortInIsrContext() == pdTRUE) {
+        xQueueSendFromISR(disp_ctx->ring.free, &buf, &need_yield);
+    } else {
+        xQueueSend(disp_ctx->ring.free, &buf, 0);
+    }
+
+    return (need_yield == pdTRUE);
+}
+
+/* Flushed area is copied into transmit FIFO, LVGL renders the next area while the transmit task sends the copies */
+static void lvgl_port_flush_tx(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area, uint8_t *color_map)
+{
+    lvgl_port_tx_stats_t *stats = &disp_ctx->tx.stats;
+    const int32_t width = lv_area_get_width(area);
+    const int32_t height = lv_area_get_height(area);
+    const uint32_t px_size = lv_color_format_get_size(lv_display_get_color_format(disp_ctx->disp_drv));
+    /* Half of FIFO per transfer, the next chunk is copied while the previous one is sent */
+    const int32_t max_lines = LV_MIN(LV_MAX((int32_t)(disp_ctx->tx.fifo.size / 2 / px_size / width), 1), height);
+    const uint8_t *from = color_map;
+
+    for (int32_t y1 = area->y1; y1 <= area->y2; y1 += max_lines) {
+        const int32_t y2 = LV_MIN(y1 + max_lines - 1, area->y2);
+        const uint32_t len = (uint32_t)(y2 - y1 + 1) * width;
+        uint8_t *to = lvgl_port_tx_alloc(disp_ctx, len * px_size);
+
+        const int64_t start = esp_timer_get_time();
+        if (disp_ctx->flags.swap_bytes) {
+            lvgl_port_rgb565_swap((uint16_t *)to, (const uint16_t *)from, len);
+        } else {
+            memcpy(to, from, len * px_size);
+        }
+        stats->copy_us += esp_timer_get_time() - start;
+        from += len * px_size;
+
+        lvgl_port_tx_item_t *item = &disp_ctx->tx.items[disp_ctx->tx.queued % LVGL_PORT_DISP_TX_PENDING_MAX];
+        item->data = to;
+        item->len = len * px_size;
+        item->x1 = area->x1;
+        item->y1 = y1;
+        item->x2 = area->x2 + 1;
+        item->y2 = y2 + 1;
+        disp_ctx->tx.queued++;
+        /* Queue is longer than maximum of pending transfers, it never blocks */
+        xQueueSend(disp_ctx->tx.queue, item, portMAX_DELAY);
+
+        stats->transfers++;
+        const uint32_t fill = lvgl_port_txfifo_used(&disp_ctx->tx.fifo);
+        if (fill > stats->max_fill) {
+            stats->max_fill = fill;
+        }
+    }
+
+    /* Draw buffer was copied, LVGL can render the next area during the transfers */
+    stats->flushes++;
+    lv_disp_flush_ready(disp_ctx->disp_drv);
+}
+
+/* Allocate copy of the next transfer, wait when FIFO is full or too many transfers are pending (back-pressure) */
+static uint8_t *lvgl_port_tx_alloc(lvgl_port_display_ctx_t *disp_ctx, uint32_t len)
+{
+    lvgl_port_tx_stats_t *stats = &disp_ctx->tx.stats;
+    int64_t stall_start = 0;
+    uint8_t *data = NULL;
+
+    while (1) {
+        /* Finished transfers are freed in order, the ready callback only counts them */
+        const uint32_t finished = disp_ctx->tx.finished;
+        while (disp_ctx->tx.freed != finished) {
+            const lvgl_port_tx_item_t *item = &disp_ctx->tx.items[disp_ctx->tx.freed % LVGL_PORT_DISP_TX_PENDING_MAX];
+            lvgl_port_txfifo_free(&disp_ctx->tx.fifo, item->data, item->len);
+            disp_ctx->tx.freed++;
+        }
+
+        if (disp_ctx->tx.queued - disp_ctx->tx.freed < disp_ctx->tx.max_pending) {
+            data = lvgl_port_txfifo_alloc(&disp_ctx->tx.fifo, len);
+            if (data) {
+                break;
+            }
+        }
+
+        if (stall_start == 0) {
+            stall_start = esp_timer_get_time();
+            stats->stalls++;
+        }
+        /* Given after each finished transfer, a stale give only repeats the check */
+        xSemaphoreTake(disp_ctx->tx.space, portMAX_DELAY);
+    }
+
+    if (stall_start) {
+        stats->stall_time_us += esp_timer_get_time() - stall_start;
+    }
+    const uint32_t pending = disp_ctx->tx.queued - disp_ctx->tx.freed + 1;
+    if (pending > stats->max_pending) {
+        stats->max_pending = pending;
+    }
+
+    return data;
+}
+
+static bool lvgl_port_tx_done(lvgl_port_display_ctx_t *disp_ctx)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    disp_ctx->tx.finished++;
+    /* The last queued transfer is on the panel */
+    if (disp_ctx->flags.stats && disp_ctx->tx.finished == disp_ctx->tx.queued) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
+    if (xPortInIsrContext() == pdTRUE) {
+        xSemaphoreGiveFromISR(disp_ctx->tx.space, &need_yield);
+    } else {
+        xSemaphoreGive(disp_ctx->tx.space);
+    }
+
+    return (need_yield == pdTRUE);
+}
+
+static esp_err_t lvgl_port_tx_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg, lv_color_format_t color_format)
+{
+    const int priority = (disp_cfg->tx_task.priority > 0 ? disp_cfg->tx_task.priority : LVGL_PORT_DISP_TX_PRIORITY);
+    const int stack = (disp_cfg->tx_task.stack > 0 ? disp_cfg->tx_task.stack : LVGL_PORT_DISP_TX_STACK);
+    const uint8_t max_pending = (disp_cfg->tx_task.max_pending > 0 ? disp_cfg->tx_task.max_pending : LVGL_PORT_DISP_TX_PENDING);
+    const uint32_t fifo_bytes = disp_cfg->tx_task.size * lv_color_format_get_size(color_format);
+    esp_err_t ret = ESP_OK;
+    BaseType_t res;
+
+    ESP_RETURN_ON_FALSE(disp_cfg->tx_task.affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, TAG, "Bad core number for transmit task! Maximum core number is %d", (configNUM_CORES - 1));
+
+    /* Copies are sent by DMA */
+    uint8_t *buf = heap_caps_malloc(fifo_bytes, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+    ESP_RETURN_ON_FALSE(buf, ESP_ERR_NO_MEM, TAG, "Not enough memory for transmit FIFO!");
+    lvgl_port_txfifo_init(&disp_ctx->tx.fifo, buf, fifo_bytes);
+    disp_ctx->tx.max_pending = max_pending;
+    disp_ctx->tx.queued = 0;
+    disp_ctx->tx.freed = 0;
+    disp_ctx->tx.finished = 0;
+
+    /* One more item for the stop request */
+    disp_ctx->tx.queue = xQueueCreate(max_pending + 1, sizeof(lvgl_port_tx_item_t));
+    ESP_GOTO_ON_FALSE(disp_ctx->tx.queue, ESP_ERR_NO_MEM, err, TAG, "Failed to create transmit queue");
+    disp_ctx->tx.space = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(disp_ctx->tx.space, ESP_ERR_NO_MEM, err, TAG, "Failed to create transmit semaphore");
+    disp_ctx->tx.done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(disp_ctx->tx.done, ESP_ERR_NO_MEM, err, TAG, "Failed to create transmit semaphore");
+
+    if (disp_cfg->tx_task.affinity < 0) {
+        res = xTaskCreate(lvgl_port_tx_task, "LVGL tx", stack, disp_ctx, priority, &disp_ctx->tx.handle);
+    } else {
+        res = xTaskCreatePinnedToCore(lvgl_port_tx_task, "LVGL tx", stack, disp_ctx, priority, &disp_ctx->tx.handle, disp_cfg->tx_task.affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "Create transmit task fail!");
+
+    return ESP_OK;
+
+err:
+    disp_ctx->tx.handle = NULL;
+    lvgl_port_tx_deinit(disp_ctx);
+    return ret;
+}
+
+static esp_err_t lvgl_port_tx_deinit(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const TickType_t timeout = pdMS_TO_TICKS(LVGL_PORT_DISP_TASK_STOP_MS);
+
+    /* Nothing is freed while the task or DMA can use it, the call can be repeated after timeout */
+    if (disp_ctx->tx.handle) {
+        /* Stop request is queued after the pending transfers (queue has one more item for it) */
+        if (!disp_ctx->tx.stopping) {
+            const lvgl_port_tx_item_t stop = { .data = NULL };
+            xQueueSend(disp_ctx->tx.queue, &stop, portMAX_DELAY);
+            disp_ctx->tx.stopping = true;
+        }
+        if (!disp_ctx->tx.stopped) {
+            ESP_RETURN_ON_FALSE(xSemaphoreTake(disp_ctx->tx.done, timeout) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Failed to stop transmit task");
+            disp_ctx->tx.stopped = true;
+        }
+
+        /* The last transfers can still be on the bus, DMA reads the FIFO until they are finished */
+        const TickType_t start = xTaskGetTickCount();
+        while (disp_ctx->tx.finished != disp_ctx->tx.queued) {
+            const TickType_t waited = xTaskGetTickCount() - start;
+            ESP_RETURN_ON_FALSE(waited < timeout, ESP_ERR_TIMEOUT, TAG, "Transfers of transmit task are not finished");
+            /* Given by ready callback after each finished transfer */
+            xSemaphoreTake(disp_ctx->tx.space, timeout - waited);
+        }
+        disp_ctx->tx.handle = NULL;
+    }
+
+    if (disp_ctx->tx.queue) {
+        vQueueDelete(disp_ctx->tx.queue);
+        disp_ctx->tx.queue = NULL;
+    }
+    if (disp_ctx->tx.space) {
+        vSemaphoreDelete(disp_ctx->tx.space);
+        disp_ctx->tx.space = NULL;
+    }
+    if (disp_ctx->tx.done) {
+        vSemaphoreDelete(disp_ctx->tx.done);
+        disp_ctx->tx.done = NULL;
+    }
+    free(disp_ctx->tx.fifo.buf);
+    disp_ctx->tx.fifo.buf = NULL;
+
+    return ESP_OK;
+}
+
+static void lvgl_port_tx_task(void *arg)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+    assert(disp_ctx != NULL);
+    lvgl_port_tx_item_t item;
+
+    while (xQueueReceive(disp_ctx->tx.queue, &item, portMAX_DELAY) == pdTRUE && item.data) {
+        /* Panel IO can block here until its transaction queue has space, LVGL task is not blocked */
+        esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, item.x1, item.y1, item.x2, item.y2, item.data);
+    }
+
+    xSemaphoreGive(disp_ctx->tx.done);
+    vTaskDelete(NULL);
+}
+#endif
+
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+static bool lvgl_port_flush_vsync_switch_callback(esp_lcd_panel_handle_t panel_io, const esp_lcd_rgb_panel_event_data_t *edata, void *user_ctx)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)user_ctx;
+    assert(disp_ctx != NULL);
+    const int8_t queued = disp_ctx->rgb.queued;
+
+    if (queued < 0) {
+        return false;
+    }
+
+    /* Panel switched to the queued frame buffer, the previously scanned one is free */
+    disp_ctx->rgb.scan = queued;
+    disp_ctx->rgb.queued = -1;
+    if (disp_ctx->flags.stats) {
+        lvgl_port_stats_ready(disp_ctx);
+    }
+
+    return lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_VSYNC);
+}
+
+static void lvgl_port_flush_rgb_async(lvgl_port_display_ctx_t *disp_ctx)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+
+    /* Areas are rendered directly into the frame buffer, only the last one finishes the frame */
+    if (!lv_disp_flush_is_last(disp)) {
+        lv_disp_flush_ready(disp);
+        return;
+    }
+
+    /* Panel keeps only one frame buffer for the next VSYNC, wait until the previous frame is shown */
+    lvgl_port_rgb_wait_vsync(disp_ctx);
+
+    const uint8_t render = disp_ctx->rgb.render;
+    esp_lcd_panel_draw_bitmap(disp_ctx->panel_handle, 0, 0, lv_display_get_horizontal_resolution(disp), lv_display_get_vertical_resolution(disp), disp_ctx->rgb.fbs[render]);
+    /* Set after the switch was requested, so the interrupt cannot release the scanned frame buffer too early */
+    disp_ctx->rgb.queued = render;
+    disp_ctx->rgb.latest = render;
+    if (disp_ctx->flags.direct_mode) {
+        lvgl_port_rgb_mark_stale(disp_ctx);
+    }
+
+    /* With three frame buffers, one is always free. Otherwise the free one is taken before the next frame is rendered */
+    lvgl_port_rgb_take_free(disp_ctx);
+    lv_disp_flush_ready(disp);
+}
+
+static void lvgl_port_rgb_render_start_callback(lv_event_t *e)
+{
+    assert(e);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)e->user_data;
+    assert(disp_ctx != NULL);
+
+    /* LVGL takes the active buffer for the first area after this event (before it waits for flushing), so it is switched here */
+    if (lvgl_port_rgb_take_free(disp_ctx)) {
+        return;
+    }
+
+    /* Both frame buffers are busy (scanned and queued), wait for VSYNC */
+    const int64_t wait_start = esp_timer_get_time();
+    lvgl_port_rgb_wait_vsync(disp_ctx);
+    lvgl_port_rgb_take_free(disp_ctx);
+    if (disp_ctx->flags.stats) {
+        const int64_t wait = esp_timer_get_time() - wait_start;
+        disp_ctx->stats.data.flush_wait_us += wait;
+        disp_ctx->stats.frame_wait += wait;
+    }
+}
+
+static void lvgl_port_rgb_wait_vsync(lvgl_port_display_ctx_t *disp_ctx)
+{
+    while (disp_ctx->rgb.queued >= 0) {
+        /* Clear before check, the notification from interrupt cannot be lost */
+        ulTaskNotifyValueClear(NULL, LVGL_PORT_NOTIFY_VSYNC);
+        if (disp_ctx->rgb.queued < 0) {
+            break;
+        }
+        lvgl_port_task_wait_notify(LVGL_PORT_NOTIFY_VSYNC);
+    }
+}
+
+static bool lvgl_port_rgb_take_free(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const int8_t queued = disp_ctx->rgb.queued;
+    const uint8_t scan = disp_ctx->rgb.scan;
+    uint8_t next = disp_ctx->rgb.render;
+
+    if (next == queued || next == scan) {
+        next = LVGL_PORT_RGB_FBS_MAX;
+        for (uint8_t i = 0; i < disp_ctx->rgb.count; i++) {
+            if (i != queued && i != scan) {
+                next = i;
+                break;
+            }
+        }
+        if (next == LVGL_PORT_RGB_FBS_MAX) {
+            return false;
+        }
+    }
+
+    if (next != disp_ctx->rgb.render) {
+        if (disp_ctx->flags.direct_mode) {
+            lvgl_port_rgb_sync(disp_ctx, next);
+        }
+        disp_ctx->rgb.render = next;
+        lvgl_port_disp_set_render_buf(disp_ctx, next);
+    }
+
+    return true;
+}
+
+/* Areas of the finished frame are missing in the other frame buffers */
+static void lvgl_port_rgb_mark_stale(lvgl_port_display_ctx_t *disp_ctx)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+
+    for (uint8_t b = 0; b < disp_ctx->rgb.count; b++) {
+        if (b == disp_ctx->rgb.render) {
+            disp_ctx->rgb.stale_cnt[b] = 0;
+            continue;
+        }
+
+        for (uint32_t i = 0; i < disp->inv_p && disp_ctx->rgb.stale_cnt[b] != LVGL_PORT_RGB_STALE_FULL; i++) {
+            if (disp->inv_area_joined[i]) {
+                continue;
+            }
+            if (disp_ctx->rgb.stale_cnt[b] >= LVGL_PORT_RGB_STALE_MAX) {
+                disp_ctx->rgb.stale_cnt[b] = LVGL_PORT_RGB_STALE_FULL;
+                break;
+            }
+            lv_area_copy(&disp_ctx->rgb.stale[b][disp_ctx->rgb.stale_cnt[b]++], &disp->inv_areas[i]);
+        }
+    }
+}
+
+/* Copy only changed areas from the latest frame, the rest of the frame buffer is up to date */
+static void lvgl_port_rgb_sync(lvgl_port_display_ctx_t *disp_ctx, uint8_t dst)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const uint8_t *from = disp_ctx->rgb.fbs[disp_ctx->rgb.latest];
+    uint8_t *to = disp_ctx->rgb.fbs[dst];
+    const lv_color_format_t cf = lv_display_get_color_format(disp);
+    const uint32_t px_size = lv_color_format_get_size(cf);
+    const int32_t hres = lv_display_get_horizontal_resolution(disp);
+    const int32_t vres = lv_display_get_vertical_resolution(disp);
+    const uint32_t stride = lv_draw_buf_width_to_stride(hres, cf);
+
+    if (disp_ctx->rgb.stale_cnt[dst] == LVGL_PORT_RGB_STALE_FULL) {
+        memcpy(to, from, stride * vres);
+    } else {
+        for (uint32_t i = 0; i < disp_ctx->rgb.stale_cnt[dst]; i++) {
+            const lv_area_t *area = &disp_ctx->rgb.stale[dst][i];
+            const uint32_t len = lv_area_get_width(area) * px_size;
+            for (int32_t y = area->y1; y <= area->y2; y++) {
+                const uint32_t offset = y * stride + area->x1 * px_size;
+                memcpy(to + offset, from + offset, len);
+            }
+        }
+    }
+    disp_ctx->rgb.stale_cnt[dst] = 0;
+}
+#endif
+
+/* Called at the beginning of flush */
+static void lvgl_port_stats_flush(lvgl_port_display_ctx_t *disp_ctx, const lv_area_t *area)
+{
+    lv_display_t *disp = disp_ctx->disp_drv;
+    const uint32_t px = lv_area_get_size(area);
+
+    disp_ctx->stats.data.areas++;
+    disp_ctx->stats.data.pixels += px;
+    /* Monochrome displays get 1 bit per pixel */
+    disp_ctx->stats.data.bytes += (disp_ctx->flags.monochrome ? px / 8 : px * lv_color_format_get_size(lv_display_get_color_format(disp)));
+    if (disp_ctx->stats.busy_start == 0) {
+        disp_ctx->stats.busy_start = esp_timer_get_time();
+    }
+
+    /* Latency of the frame ends, when its last area is on the panel */
+    if (lv_disp_flush_is_last(disp)) {
+        disp_ctx->stats.latency_start = disp_ctx->stats.inv_start;
+        disp_ctx->stats.inv_start = 0;
+    }
+}
+
+/* Called when all pending transfers are finished (also from interrupt) */
+static void lvgl_port_stats_ready(lvgl_port_display_ctx_t *disp_ctx)
+{
+    const int64_t now = esp_timer_get_time();
+    const int64_t busy_start = disp_ctx->stats.busy_start;
+    const int64_t latency_start = disp_ctx->stats.latency_start;
+
+    if (busy_start) {
+        disp_ctx->stats.data.bus_busy_us += now - busy_start;
+        disp_ctx->stats.busy_start = 0;
+    }
+
+    if (latency_start) {
+        lvgl_port_stats_add_latency(&disp_ctx->stats.data, now - latency_start);
+        disp_ctx->stats.latency_start = 0;
+    }
+}
+
+static void lvgl_port_display_stats_callback(lv_event_t *e)
+{
+    assert(e);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)e->user_data;
+    assert(disp_ctx != NULL);
+    const int64_t now = esp_timer_get_time();
+
+    switch (lv_event_get_code(e)) {
+    case LV_EVENT_RENDER_START:
+        disp_ctx->stats.data.frames++;
+        disp_ctx->stats.render_start = now;
+        disp_ctx->stats.frame_wait = 0;
+        break;
+    case LV_EVENT_RENDER_READY:
+        /* Waiting for flush ready is not counted into rendering */
+        if (disp_ctx->stats.render_start) {
+            disp_ctx->stats.data.render_us += now - disp_ctx->stats.render_start - disp_ctx->stats.frame_wait;
+            disp_ctx->stats.render_start = 0;
+        }
+        break;
+#if LVGL_PORT_STATS_FLUSH_WAIT
+    case LV_EVENT_FLUSH_WAIT_START:
+        disp_ctx->stats.wait_start = now;
+        break;
+    case LV_EVENT_FLUSH_WAIT_FINISH:
+        if (disp_ctx->stats.wait_start) {
+            disp_ctx->stats.data.flush_wait_us += now - disp_ctx->stats.wait_start;
+            disp_ctx->stats.frame_wait += now - disp_ctx->stats.wait_start;
+            disp_ctx->stats.wait_start = 0;
+        }
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+static void lvgl_port_disp_init_render_bufs(lvgl_port_display_ctx_t *disp_ctx, lv_display_t *disp, void *const *bufs, uint8_t count, uint32_t size)
+{
+    assert(count <= LVGL_PORT_DISP_BUFFERS_MAX);
+#if LVGL_PORT_DRAW_BUFS
+    /* The same size, format and stride as the buffer made by LVGL, only memory differs */
+    const lv_draw_buf_t *act = lv_display_get_buf_active(disp);
+    for (uint8_t i = 0; i < count; i++) {
+        lv_draw_buf_init(&disp_ctx->render.bufs[i], act->header.w, act->header.h, act->header.cf, act->header.stride, bufs[i], size);
+    }
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        disp_ctx->render.data[i] = bufs[i];
+    }
+    disp_ctx->render.size = size;
+    disp_ctx->render.mode = (disp_ctx->flags.ring ? LV_DISPLAY_RENDER_MODE_PARTIAL :
+                             (disp_ctx->flags.direct_mode ? LV_DISPLAY_RENDER_MODE_DIRECT : LV_DISPLAY_RENDER_MODE_FULL));
+#endif
+}
+
+static void lvgl_port_disp_set_render_buf(lvgl_port_display_ctx_t *disp_ctx, uint8_t idx)
+{
+    /* LVGL has only one buffer, the active one is replaced between flushes */
+#if LVGL_PORT_DRAW_BUFS
+    lv_display_set_draw_buffers(disp_ctx->disp_drv, &disp_ctx->render.bufs[idx], NULL);
+#else
+    lv_display_set_buffers(disp_ctx->disp_drv, disp_ctx->render.data[idx], NULL, disp_ctx->render.size, disp_ctx->render.mode);
+#endif
 }
 
 static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx)
@@ -444,8 +1917,14 @@ static void lvgl_port_disp_rotation_update(lvgl_port_display_ctx_t *disp_ctx)
     assert(disp_ctx != NULL);
     esp_lcd_panel_handle_t control_handle = (disp_ctx->control_handle ? disp_ctx->control_handle : disp_ctx->panel_handle);
 
-    /* Solve rotation screen and touch */
-    switch (lv_display_get_rotation(disp_ctx->disp_drv)) {
+    /* Solve rotation screen and touch (with software rotation, display stays in default orientation) */
+    /* PPA makes rotation and mirroring, the panel is not touched */
+    if (disp_ctx->flags.ppa) {
+        lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, disp_ctx->disp_drv);
+        return;
+    }
+
+    switch (disp_ctx->flags.sw_rotate ? LV_DISPLAY_ROTATION_0 : lv_display_get_rotation(disp_ctx->disp_drv)) {
     case LV_DISPLAY_ROTATION_0:
         /* Rotate LCD display */
         esp_lcd_panel_swap_xy(control_handle, disp_ctx->rotation.swap_xy);
@@ -489,6 +1968,189 @@ static void lvgl_port_disp_size_update_callback(lv_event_t *e)
 
 static void lvgl_port_display_invalidate_callback(lv_event_t *e)
 {
+    assert(e);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)e->user_data;
+
+    /* Latency of the next frame starts with its first invalidated area */
+    if (disp_ctx && disp_ctx->flags.stats && disp_ctx->stats.inv_start == 0 && lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+        disp_ctx->stats.inv_start = esp_timer_get_time();
+    }
+
+    /* Round area to whole bytes of I1 buffer and whole pages of monochrome display */
+    if (disp_ctx && disp_ctx->flags.mono_i1 && lv_event_get_code(e) == LV_EVENT_INVALIDATE_AREA) {
+        lv_area_t *area = (lv_area_t *)lv_event_get_param(e);
+        const int32_t hres = lv_display_get_horizontal_resolution(disp_ctx->disp_drv);
+        const int32_t vres = lv_display_get_vertical_resolution(disp_ctx->disp_drv);
+        area->x1 &= ~0x07;
+        area->y1 &= ~0x07;
+        area->x2 = LV_MIN(area->x2 | 0x07, hres - 1);
+        area->y2 = LV_MIN(area->y2 | 0x07, vres - 1);
+    }
+
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_DISPLAY, NULL);
 }
+
+static void lvgl_port_display_render_start_callback(lv_event_t *e)
+{
+    assert(e);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)e->user_data;
+    assert(disp_ctx != NULL);
+    lv_display_t *disp = disp_ctx->disp_drv;
+    lvgl_port_area_t areas[LV_INV_BUF_SIZE];
+    lvgl_port_area_result_t res;
+
+    if (disp->inv_p < 2) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < disp->inv_p; i++) {
+        areas[i].x1 = disp->inv_areas[i].x1;
+        areas[i].y1 = disp->inv_areas[i].y1;
+        areas[i].x2 = disp->inv_areas[i].x2;
+        areas[i].y2 = disp->inv_areas[i].y2;
+    }
+
+    /* Merged areas are always kept on the higher index, so LVGL's last area stays valid */
+    if (lvgl_port_area_coalesce(areas, disp->inv_area_joined, disp->inv_p, disp_ctx->coalesce_overdraw, &res) > 0) {
+        for (uint32_t i = 0; i < disp->inv_p; i++) {
+            if (!disp->inv_area_joined[i]) {
+                disp->inv_areas[i].x1 = areas[i].x1;
+                disp->inv_areas[i].y1 = areas[i].y1;
+                disp->inv_areas[i].x2 = areas[i].x2;
+                disp->inv_areas[i].y2 = areas[i].y2;
+            }
+        }
+    }
+
+    disp_ctx->coalesce_stats.frames++;
+    disp_ctx->coalesce_stats.areas_in += res.areas_in;
+    disp_ctx->coalesce_stats.areas_out += res.areas_out;
+    disp_ctx->coalesce_stats.merged += res.merged;
+    disp_ctx->coalesce_stats.unmerged += res.unmerged;
+    disp_ctx->coalesce_stats.overdraw_px += res.overdraw_px;
+}
+
+static esp_err_t lvgl_port_disp_task_init(lvgl_port_display_ctx_t *disp_ctx, const lvgl_port_display_cfg_t *disp_cfg)
+{
+    const int priority = (disp_cfg->render_task.priority > 0 ? disp_cfg->render_task.priority : LVGL_PORT_DISP_TASK_PRIORITY);
+    const int stack = (disp_cfg->render_task.stack > 0 ? disp_cfg->render_task.stack : LVGL_PORT_DISP_TASK_STACK);
+    BaseType_t res;
+
+    ESP_RETURN_ON_FALSE(disp_cfg->render_task.affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, TAG, "Bad core number for render task! Maximum core number is %d", (configNUM_CORES - 1));
+    ESP_RETURN_ON_FALSE(disp_ctx->disp_drv->refr_timer, ESP_ERR_INVALID_STATE, TAG, "Display has no refresh timer!");
+
+    disp_ctx->task.done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(disp_ctx->task.done, ESP_ERR_NO_MEM, TAG, "Create render task semaphore fail!");
+
+    disp_ctx->task.running = true;
+    if (disp_cfg->render_task.affinity < 0) {
+        res = xTaskCreate(lvgl_port_disp_task, "LVGL render", stack, disp_ctx, priority, &disp_ctx->task.handle);
+    } else {
+        res = xTaskCreatePinnedToCore(lvgl_port_disp_task, "LVGL render", stack, disp_ctx, priority, &disp_ctx->task.handle, disp_cfg->render_task.affinity);
+    }
+    if (res != pdPASS) {
+        disp_ctx->task.running = false;
+        disp_ctx->task.handle = NULL;
+        vSemaphoreDelete(disp_ctx->task.done);
+        disp_ctx->task.done = NULL;
+        ESP_LOGE(TAG, "Create render task fail!");
+        return ESP_FAIL;
+    }
+
+    /* Refresh timer stays in LVGL timers (own period, resumed by invalidation), but only wakes the render task */
+    lv_timer_set_cb(disp_ctx->disp_drv->refr_timer, lvgl_port_disp_refr_request_callback);
+
+    return ESP_OK;
+}
+
+static esp_err_t lvgl_port_disp_task_deinit(lvgl_port_display_ctx_t *disp_ctx)
+{
+    disp_ctx->task.running = false;
+    lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_WAKE);
+
+    /* Render task finishes the current refresh, it can wait for LVGL mutex. It still runs after timeout, the call can be repeated */
+    ESP_RETURN_ON_FALSE(xSemaphoreTake(disp_ctx->task.done, pdMS_TO_TICKS(LVGL_PORT_DISP_TASK_STOP_MS)) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "Failed to stop render task");
+
+    vSemaphoreDelete(disp_ctx->task.done);
+    disp_ctx->task.done = NULL;
+    disp_ctx->task.handle = NULL;
+
+    return ESP_OK;
+}
+
+static void lvgl_port_disp_task(void *arg)
+{
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)arg;
+    assert(disp_ctx != NULL);
+    lv_display_t *disp = disp_ctx->disp_drv;
+
+    while (disp_ctx->task.running) {
+        if (!disp_ctx->task.requested) {
+            xTaskNotifyWait(0, LVGL_PORT_NOTIFY_WAKE, NULL, portMAX_DELAY);
+            continue;
+        }
+        disp_ctx->task.requested = false;
+
+        /* The last transfer of the previous frame is waited for without LVGL mutex, other displays can be rendered meanwhile */
+        while (disp->flushing) {
+            ulTaskNotifyValueClear(NULL, LVGL_PORT_NOTIFY_FLUSH);
+            if (!disp->flushing) {
+                break;
+            }
+            lvgl_port_task_wait_notify(LVGL_PORT_NOTIFY_FLUSH);
+        }
+
+#if CONFIG_IDF_TARGET_ESP32S3 && ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+        /* Both RGB frame buffers are busy, the frame buffer for the next frame is waited for without LVGL mutex too */
+        if (disp_ctx->flags.rgb_async && disp_ctx->rgb.count == 2) {
+            lvgl_port_rgb_wait_vsync(disp_ctx);
+        }
+#endif
+
+        /* Rendering reads shared LVGL objects, it must be locked */
+        lvgl_port_lock(0);
+        if (disp_ctx->task.running) {
+            lvgl_port_disp_refr_timer(disp->refr_timer);
+        }
+        lvgl_port_unlock();
+    }
+
+    xSemaphoreGive(disp_ctx->task.done);
+    vTaskDelete(NULL);
+}
+
+static void lvgl_port_disp_refr_request_callback(lv_timer_t *timer)
+{
+    lv_display_t *disp = (lv_display_t *)lv_timer_get_user_data(timer);
+    lvgl_port_display_ctx_t *disp_ctx = (lvgl_port_display_ctx_t *)lv_display_get_user_data(disp);
+
+    /* Render task is stopped (removing display), refresh in LVGL task */
+    if (disp_ctx == NULL || !disp_ctx->task.running) {
+        lvgl_port_disp_refr_timer(timer);
+        return;
+    }
+
+    /* Paused as LVGL does in refresh, invalidation resumes it */
+    lv_timer_pause(timer);
+    disp_ctx->task.requested = true;
+    lvgl_port_disp_notify(disp_ctx, LVGL_PORT_NOTIFY_WAKE);
+}
+
+static bool lvgl_port_disp_notify(lvgl_port_display_ctx_t *disp_ctx, uint32_t value)
+{
+    BaseType_t need_yield = pdFALSE;
+
+    /* Display without own render task is handled in LVGL task */
+    if (disp_ctx->task.handle == NULL) {
+        return lvgl_port_task_notify(value);
+    }
+
+    if (xPortInIsrContext() == pdTRUE) {
+        xTaskNotifyFromISR(disp_ctx->task.handle, value, eSetBits, &need_yield);
+    } else {
+        xTaskNotify(disp_ctx->task.handle, value, eSetBits);
+    }
+
+    return (need_yield == pdTRUE);
+}
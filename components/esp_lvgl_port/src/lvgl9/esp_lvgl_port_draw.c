@@ -0,0 +1,346 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+
+/*
+ * Draw unit API with software draw functions taking draw unit is in LVGL 9.1 and 9.2. It needs OS for waking
+ * the dispatcher and for locks of image cache and circle cache used by the worker on the other core.
+ */
+#if LVGL_VERSION_MAJOR == 9 && LVGL_VERSION_MINOR >= 1 && LVGL_VERSION_MINOR <= 2 && LV_USE_OS != LV_OS_NONE
+#define LVGL_PORT_DRAW_WORKER 1
+#include "src/draw/sw/lv_draw_sw.h"
+#if LVGL_VERSION_MINOR >= 2
+#include "src/draw/lv_draw_private.h"
+#endif
+#else
+#define LVGL_PORT_DRAW_WORKER 0
+#endif
+
+static const char *TAG = "LVGL";
+
+/* Draw unit ID of the worker (LVGL units use small numbers) */
+#define LVGL_PORT_DRAW_UNIT_ID          (40)
+/* Preference of the worker, the software renderer takes only tasks with 100 */
+#define LVGL_PORT_DRAW_PREFERENCE       (99)
+/* Defaults of draw worker task */
+#define LVGL_PORT_DRAW_TASK_PRIORITY    (4)
+#define LVGL_PORT_DRAW_TASK_STACK       (8192)
+#define LVGL_PORT_DRAW_TASK_STOP_MS     (1000)
+
+#if LVGL_PORT_DRAW_WORKER
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    lv_draw_unit_t          base_unit;      /* LVGL draw unit (must be first) */
+    lv_draw_task_t *volatile task_act;      /* Draw task rendered by worker (NULL: worker is free) */
+    TaskHandle_t            task;           /* Draw worker task */
+    SemaphoreHandle_t       done;           /* Given by worker task, when it is stopped */
+    volatile bool           running;        /* Worker task is running */
+    bool                    enabled;        /* Draw tasks are split to the worker */
+    uint64_t                load[2];        /* Pixels assigned to software renderer [0] and worker [1] */
+    portMUX_TYPE            lock;           /* Statistics lock */
+    lvgl_port_draw_worker_stats_t stats;    /* Statistics */
+} lvgl_port_draw_unit_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static lvgl_port_draw_unit_t *lvgl_port_draw_unit;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static int32_t lvgl_port_draw_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task);
+static int32_t lvgl_port_draw_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer);
+static int32_t lvgl_port_draw_delete(lv_draw_unit_t *draw_unit);
+static void lvgl_port_draw_task(void *arg);
+static bool lvgl_port_draw_is_supported(lv_draw_task_type_t type);
+static void lvgl_port_draw_execute(lv_draw_unit_t *draw_unit, lv_draw_task_t *task);
+
+#endif
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_draw_worker_init(const lvgl_port_draw_worker_cfg_t *cfg)
+{
+#if LVGL_PORT_DRAW_WORKER
+    esp_err_t ret = ESP_OK;
+    BaseType_t res;
+
+    ESP_RETURN_ON_FALSE(configNUM_CORES > 1, ESP_ERR_NOT_SUPPORTED, TAG, "Draw worker needs two cores!");
+    ESP_RETURN_ON_FALSE(lvgl_port_draw_unit == NULL, ESP_ERR_INVALID_STATE, TAG, "Draw worker is already running!");
+    ESP_RETURN_ON_FALSE(cfg == NULL || cfg->task_affinity < (configNUM_CORES), ESP_ERR_INVALID_ARG, TAG, "Bad core number for task! Maximum core number is %d", (configNUM_CORES - 1));
+
+    const int priority = (cfg && cfg->task_priority > 0 ? cfg->task_priority : LVGL_PORT_DRAW_TASK_PRIORITY);
+    const int stack = (cfg && cfg->task_stack > 0 ? cfg->task_stack : LVGL_PORT_DRAW_TASK_STACK);
+    int core = (cfg ? cfg->task_affinity : -1);
+    if (core < 0) {
+        /* The other core than LVGL task (unpinned LVGL task mostly runs on core 0) */
+        core = (lvgl_port_task_get_affinity() == 1 ? 0 : 1);
+    }
+
+    lvgl_port_lock(0);
+
+    /* Draw unit memory is owned by LVGL, it is freed in lv_deinit */
+    lvgl_port_draw_unit_t *unit = lv_draw_create_unit(sizeof(lvgl_port_draw_unit_t));
+    ESP_GOTO_ON_FALSE(unit, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for draw unit!");
+    unit->base_unit.evaluate_cb = lvgl_port_draw_evaluate;
+    unit->base_unit.dispatch_cb = lvgl_port_draw_dispatch;
+    unit->base_unit.delete_cb = lvgl_port_draw_delete;
+    unit->enabled = true;
+    portMUX_INITIALIZE(&unit->lock);
+
+    unit->done = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(unit->done, ESP_ERR_NO_MEM, err, TAG, "Create draw worker semaphore fail!");
+
+    unit->running = true;
+    res = xTaskCreatePinnedToCore(lvgl_port_draw_task, "LVGL draw", stack, unit, priority, &unit->task, core);
+    if (res != pdPASS) {
+        unit->running = false;
+        vSemaphoreDelete(unit->done);
+        unit->done = NULL;
+        /* Unit stays registered in LVGL, it does not take any task */
+        unit->enabled = false;
+        ESP_GOTO_ON_FALSE(false, ESP_FAIL, err, TAG, "Create draw worker task fail!");
+    }
+    lvgl_port_draw_unit = unit;
+    ESP_LOGI(TAG, "Draw worker started on core %d", core);
+
+err:
+    lvgl_port_unlock();
+    return ret;
+#else
+    ESP_LOGE(TAG, "Draw worker needs LVGL 9.1 or 9.2 with OS (LV_USE_OS)!");
+    return ESP_ERR_NOT_SUPPORTED;
+#endif
+}
+
+esp_err_t lvgl_port_draw_worker_enable(bool enable)
+{
+#if LVGL_PORT_DRAW_WORKER
+    ESP_RETURN_ON_FALSE(lvgl_port_draw_unit, ESP_ERR_INVALID_STATE, TAG, "Draw worker is not running!");
+
+    /* Changed between evaluations of draw tasks */
+    lvgl_port_lock(0);
+    lvgl_port_draw_unit->enabled = enable;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+#else
+    return ESP_ERR_INVALID_STATE;
+#endif
+}
+
+esp_err_t lvgl_port_draw_worker_get_stats(lvgl_port_draw_worker_stats_t *stats, bool reset)
+{
+#if LVGL_PORT_DRAW_WORKER
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_draw_unit, ESP_ERR_INVALID_STATE, TAG, "Draw worker is not running!");
+
+    portENTER_CRITICAL(&lvgl_port_draw_unit->lock);
+    memcpy(stats, &lvgl_port_draw_unit->stats, sizeof(lvgl_port_draw_worker_stats_t));
+    if (reset) {
+        memset(&lvgl_port_draw_unit->stats, 0, sizeof(lvgl_port_draw_worker_stats_t));
+    }
+    portEXIT_CRITICAL(&lvgl_port_draw_unit->lock);
+
+    return ESP_OK;
+#else
+    return ESP_ERR_INVALID_STATE;
+#endif
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+#if LVGL_PORT_DRAW_WORKER
+static int32_t lvgl_port_draw_evaluate(lv_draw_unit_t *draw_unit, lv_draw_task_t *task)
+{
+    lvgl_port_draw_unit_t *unit = (lvgl_port_draw_unit_t *)draw_unit;
+
+    /* Only tasks for the software renderer, which were not taken by a better unit */
+    if (!unit->enabled || !unit->running || task->preference_score < 100 || !lvgl_port_draw_is_supported(task->type)) {
+        return 0;
+    }
+
+    /* Balance by pixels, small tasks are cheap and big ones are split fairly between cores */
+    const uint32_t px = lv_area_get_size(&task->area);
+    const int side = (unit->load[1] < unit->load[0] ? 1 : 0);
+    unit->load[side] += px;
+
+    if (side) {
+        /* Counted in statistics by the worker task, after it is rendered */
+        task->preference_score = LVGL_PORT_DRAW_PREFERENCE;
+        task->preferred_draw_unit_id = LVGL_PORT_DRAW_UNIT_ID;
+    } else {
+        /* Software renderer does not report its tasks, they are counted once, when left to it */
+        portENTER_CRITICAL(&unit->lock);
+        unit->stats.sw_tasks++;
+        unit->stats.sw_px += px;
+        portEXIT_CRITICAL(&unit->lock);
+    }
+
+    return 0;
+}
+
+static int32_t lvgl_port_draw_dispatch(lv_draw_unit_t *draw_unit, lv_layer_t *layer)
+{
+    lvgl_port_draw_unit_t *unit = (lvgl_port_draw_unit_t *)draw_unit;
+
+    /* Worker is busy */
+    if (unit->task_act) {
+        return 0;
+    }
+
+    lv_draw_task_t *t = lv_draw_get_next_available_task(layer, NULL, LVGL_PORT_DRAW_UNIT_ID);
+    if (t == NULL || t->preferred_draw_unit_id != LVGL_PORT_DRAW_UNIT_ID) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    if (lv_draw_layer_alloc_buf(layer) == NULL) {
+        return LV_DRAW_UNIT_IDLE;
+    }
+
+    t->state = LV_DRAW_TASK_STATE_IN_PROGRESS;
+    unit->base_unit.target_layer = layer;
+    unit->base_unit.clip_area = &t->clip_area;
+    unit->task_act = t;
+    xTaskNotifyGive(unit->task);
+
+    return 1;
+}
+
+static int32_t lvgl_port_draw_delete(lv_draw_unit_t *draw_unit)
+{
+    lvgl_port_draw_unit_t *unit = (lvgl_port_draw_unit_t *)draw_unit;
+
+    if (unit->running) {
+        unit->running = false;
+        xTaskNotifyGive(unit->task);
+        if (xSemaphoreTake(unit->done, pdMS_TO_TICKS(LVGL_PORT_DRAW_TASK_STOP_MS)) != pdTRUE) {
+            ESP_LOGE(TAG, "Failed to stop draw worker");
+        }
+    }
+    if (unit->done) {
+        vSemaphoreDelete(unit->done);
+    }
+    lvgl_port_draw_unit = NULL;
+
+    return 0;
+}
+
+static void lvgl_port_draw_task(void *arg)
+{
+    lvgl_port_draw_unit_t *unit = (lvgl_port_draw_unit_t *)arg;
+    assert(unit != NULL);
+
+    while (unit->running) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        lv_draw_task_t *t = unit->task_act;
+        if (t == NULL) {
+            continue;
+        }
+
+        const int64_t start = esp_timer_get_time();
+        lvgl_port_draw_execute(&unit->base_unit, t);
+        const int64_t busy = esp_timer_get_time() - start;
+
+        portENTER_CRITICAL(&unit->lock);
+        unit->stats.worker_tasks++;
+        unit->stats.worker_px += lv_area_get_size(&t->area);
+        unit->stats.worker_busy_us += busy;
+        portEXIT_CRITICAL(&unit->lock);
+
+        /* Task is done, dispatcher in LVGL task can continue with dependent tasks */
+        t->state = LV_DRAW_TASK_STATE_READY;
+        unit->task_act = NULL;
+        lv_draw_dispatch_request();
+    }
+
+    xSemaphoreGive(unit->done);
+    vTaskDelete(NULL);
+}
+
+static bool lvgl_port_draw_is_supported(lv_draw_task_type_t type)
+{
+    /*
+     * Only tasks using no shared state or state locked by LVGL OS layer (image cache, circle cache). Labels stay in
+     * LVGL task, glyph cache of fonts and buffer of compressed fonts are not locked. Shadow cache is not locked too.
+     */
+    switch (type) {
+    case LV_DRAW_TASK_TYPE_FILL:
+    case LV_DRAW_TASK_TYPE_BORDER:
+    case LV_DRAW_TASK_TYPE_IMAGE:
+    case LV_DRAW_TASK_TYPE_LAYER:
+    case LV_DRAW_TASK_TYPE_LINE:
+#if LV_DRAW_SW_COMPLEX
+#if LV_DRAW_SW_SHADOW_CACHE_SIZE == 0
+    case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+#endif
+    case LV_DRAW_TASK_TYPE_ARC:
+    case LV_DRAW_TASK_TYPE_TRIANGLE:
+    case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
+#endif
+        return true;
+    default:
+        return false;
+    }
+}
+
+static void lvgl_port_draw_execute(lv_draw_unit_t *draw_unit, lv_draw_task_t *task)
+{
+    /* Same software draw functions as used by LVGL software renderer */
+    switch (task->type) {
+    case LV_DRAW_TASK_TYPE_FILL:
+        lv_draw_sw_fill(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_BORDER:
+        lv_draw_sw_border(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_IMAGE:
+        lv_draw_sw_image(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_LAYER:
+        lv_draw_sw_layer(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_LINE:
+        lv_draw_sw_line(draw_unit, task->draw_dsc);
+        break;
+#if LV_DRAW_SW_COMPLEX
+    case LV_DRAW_TASK_TYPE_BOX_SHADOW:
+        lv_draw_sw_box_shadow(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_ARC:
+        lv_draw_sw_arc(draw_unit, task->draw_dsc, &task->area);
+        break;
+    case LV_DRAW_TASK_TYPE_TRIANGLE:
+        lv_draw_sw_triangle(draw_unit, task->draw_dsc);
+        break;
+    case LV_DRAW_TASK_TYPE_MASK_RECTANGLE:
+        lv_draw_sw_mask_rect(draw_unit, task->draw_dsc, &task->area);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+#endif
@@ -0,0 +1,227 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+
+#if CONFIG_IDF_TARGET_LINUX
+/* Host build has no power management, the CPU frequency lock is never created */
+typedef void *esp_pm_lock_handle_t;
+#define esp_pm_lock_create(type, arg, name, handle) (ESP_ERR_NOT_SUPPORTED)
+#define esp_pm_lock_acquire(handle)                 (ESP_OK)
+#define esp_pm_lock_release(handle)                 (ESP_OK)
+#define esp_pm_lock_delete(handle)                  (ESP_OK)
+#else
+#include "esp_pm.h"
+#endif
+
+static const char *TAG = "LVGL";
+
+/* Defaults of governor */
+#define LVGL_PORT_GOV_IDLE_PERIOD_MS    (100)
+#define LVGL_PORT_GOV_ACTIVE_HOLD_MS    (2000)
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+typedef struct {
+    uint32_t            active_period_ms;
+    uint32_t            idle_period_ms;
+    uint32_t            active_hold_ms;
+    bool                active;         /* Active period is set */
+    bool                applied;        /* Period was set at least once */
+    int64_t             last_update;    /* Time of the last evaluation */
+    esp_pm_lock_handle_t pm_lock;       /* CPU frequency lock during rendering (NULL: not used) */
+    uint32_t            renders;        /* Count of displays rendering now */
+    int64_t             render_start;   /* Time of the first render start */
+    lvgl_port_governor_stats_t stats;
+} lvgl_port_governor_t;
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static lvgl_port_governor_t *lvgl_port_gov;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void lvgl_port_governor_apply(lvgl_port_governor_t *gov, uint32_t period_ms);
+static void lvgl_port_governor_hook_display(lvgl_port_governor_t *gov, lv_display_t *disp);
+static void lvgl_port_governor_render_callback(lv_event_t *e);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_governor_init(const lvgl_port_governor_cfg_t *cfg)
+{
+    esp_err_t ret = ESP_OK;
+
+    ESP_RETURN_ON_FALSE(lvgl_port_gov == NULL, ESP_ERR_INVALID_STATE, TAG, "Governor is already running!");
+
+    lvgl_port_governor_t *gov = calloc(1, sizeof(lvgl_port_governor_t));
+    ESP_RETURN_ON_FALSE(gov, ESP_ERR_NO_MEM, TAG, "Not enough memory for governor!");
+    gov->active_period_ms = (cfg && cfg->active_period_ms ? cfg->active_period_ms : LV_DEF_REFR_PERIOD);
+    gov->idle_period_ms = (cfg && cfg->idle_period_ms ? cfg->idle_period_ms : LVGL_PORT_GOV_IDLE_PERIOD_MS);
+    gov->active_hold_ms = (cfg && cfg->active_hold_ms ? cfg->active_hold_ms : LVGL_PORT_GOV_ACTIVE_HOLD_MS);
+
+    if (cfg && cfg->pm_lock) {
+        /* Without power management, the CPU runs at fixed frequency and the lock is not needed */
+        ret = esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "lvgl render", &gov->pm_lock);
+        if (ret == ESP_ERR_NOT_SUPPORTED) {
+            ESP_LOGW(TAG, "Power management is not enabled (CONFIG_PM_ENABLE), CPU frequency lock is not used");
+            gov->pm_lock = NULL;
+            ret = ESP_OK;
+        }
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "Create PM lock fail!");
+    }
+
+    /* Evaluated in the next LVGL task pass */
+    lvgl_port_lock(0);
+    gov->last_update = esp_timer_get_time();
+    lvgl_port_gov = gov;
+    lvgl_port_unlock();
+    lvgl_port_task_wake(LVGL_PORT_EVENT_USER, NULL);
+
+    return ESP_OK;
+
+err:
+    free(gov);
+    return ret;
+}
+
+esp_err_t lvgl_port_governor_get_stats(lvgl_port_governor_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(lvgl_port_gov, ESP_ERR_INVALID_STATE, TAG, "Governor is not running!");
+
+    /* Counted in LVGL task and render callbacks, all of them with LVGL mutex */
+    lvgl_port_lock(0);
+    memcpy(stats, &lvgl_port_gov->stats, sizeof(lvgl_port_governor_stats_t));
+    if (reset) {
+        memset(&lvgl_port_gov->stats, 0, sizeof(lvgl_port_governor_stats_t));
+    }
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
+void lvgl_port_governor_update(void)
+{
+    lvgl_port_governor_t *gov = lvgl_port_gov;
+    if (gov == NULL) {
+        return;
+    }
+
+    const int64_t now = esp_timer_get_time();
+    if (gov->active) {
+        gov->stats.active_us += now - gov->last_update;
+    } else {
+        gov->stats.idle_us += now - gov->last_update;
+    }
+    gov->last_update = now;
+
+    /* Input activity of all displays, animations of any object */
+    const bool active = (lv_display_get_inactive_time(NULL) < gov->active_hold_ms || lv_anim_count_running() > 0);
+    if (active != gov->active || !gov->applied) {
+        if (gov->applied) {
+            gov->stats.switches++;
+        }
+        gov->active = active;
+        gov->applied = true;
+        lvgl_port_governor_apply(gov, active ? gov->active_period_ms : gov->idle_period_ms);
+    }
+}
+
+void lvgl_port_governor_deinit(void)
+{
+    lvgl_port_governor_t *gov = lvgl_port_gov;
+    if (gov == NULL) {
+        return;
+    }
+
+    lvgl_port_gov = NULL;
+    lv_display_t *disp = lv_display_get_next(NULL);
+    while (disp) {
+        lv_display_remove_event_cb_with_user_data(disp, lvgl_port_governor_render_callback, gov);
+        disp = lv_display_get_next(disp);
+    }
+    if (gov->pm_lock) {
+        if (gov->renders) {
+            esp_pm_lock_release(gov->pm_lock);
+        }
+        esp_pm_lock_delete(gov->pm_lock);
+    }
+    free(gov);
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void lvgl_port_governor_apply(lvgl_port_governor_t *gov, uint32_t period_ms)
+{
+    lv_display_t *disp = lv_display_get_next(NULL);
+    while (disp) {
+        lv_timer_t *refr_timer = lv_display_get_refr_timer(disp);
+        if (refr_timer) {
+            lv_timer_set_period(refr_timer, period_ms);
+        }
+        /* Displays added after governor init are hooked on the next switch */
+        if (gov->pm_lock) {
+            lvgl_port_governor_hook_display(gov, disp);
+        }
+        disp = lv_display_get_next(disp);
+    }
+
+    /* Input devices in event mode do not have read timer, they wake LVGL task by themselves */
+    lv_indev_t *indev = lv_indev_get_next(NULL);
+    while (indev) {
+        lv_timer_t *read_timer = lv_indev_get_read_timer(indev);
+        if (read_timer) {
+            lv_timer_set_period(read_timer, period_ms);
+        }
+        indev = lv_indev_get_next(indev);
+    }
+
+    ESP_LOGD(TAG, "Refresh period %"PRIu32" ms", period_ms);
+}
+
+static void lvgl_port_governor_hook_display(lvgl_port_governor_t *gov, lv_display_t *disp)
+{
+    /* Called between renders (LVGL task holds the mutex), callbacks of this governor are added only once */
+    lv_display_remove_event_cb_with_user_data(disp, lvgl_port_governor_render_callback, gov);
+    lv_display_add_event_cb(disp, lvgl_port_governor_render_callback, LV_EVENT_RENDER_START, gov);
+    lv_display_add_event_cb(disp, lvgl_port_governor_render_callback, LV_EVENT_RENDER_READY, gov);
+}
+
+static void lvgl_port_governor_render_callback(lv_event_t *e)
+{
+    lvgl_port_governor_t *gov = (lvgl_port_governor_t *)lv_event_get_user_data(e);
+    assert(gov != NULL);
+
+    /* Displays with own render task render with LVGL mutex too, the counter is protected by it */
+    if (lv_event_get_code(e) == LV_EVENT_RENDER_START) {
+        if (gov->renders++ == 0) {
+            esp_pm_lock_acquire(gov->pm_lock);
+            gov->render_start = esp_timer_get_time();
+        }
+    } else if (gov->renders > 0) {
+        if (--gov->renders == 0) {
+            gov->stats.renders++;
+            gov->stats.render_us += esp_timer_get_time() - gov->render_start;
+            esp_pm_lock_release(gov->pm_lock);
+        }
+    }
+}
@@ -4,14 +4,22 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <string.h>
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_check.h"
+#include "esp_timer.h"
 #include "esp_lcd_touch.h"
 #include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_tracebuf.h"
+#include "esp_lvgl_port_gesture.h"
 
 static const char *TAG = "LVGL";
 
+/* Period of reads while noise filter of esp_lcd_touch holds a release (no touch interrupt comes after it) */
+#define LVGL_PORT_TOUCH_RELEASE_POLL_MS     (10)
+
 /*******************************************************************************
 * Types definitions
 *******************************************************************************/
@@ -19,6 +27,15 @@ static const char *TAG = "LVGL";
 typedef struct {
     esp_lcd_touch_handle_t  handle;     /* LCD touch IO handle */
     lv_indev_t              *indev;     /* LVGL input device driver */
+    bool                    sampler;    /* Touch samples are read by reader task of esp_lcd_touch */
+    lv_timer_t              *release_timer; /* Reads while release is held in interrupt mode without sampler */
+    lvgl_port_gesture_tracker_t tracker; /* Touch IDs and two-finger gesture */
+    struct {
+        bool        latched;    /* Pointer follows the finger with id, until all fingers are released */
+        bool        pressed;    /* The finger is pressed */
+        uint8_t     id;         /* Touch ID of the finger */
+        lv_point_t  point;      /* The last position of the finger */
+    } pointer;
 } lvgl_port_touch_ctx_t;
 
 /*******************************************************************************
@@ -27,6 +44,13 @@ typedef struct {
 
 static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data);
 static void lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t tp);
+#ifdef ESP_LCD_TOUCH_FILTER_SUPPORTED
+static void lvgl_port_touch_release_timer(lv_timer_t *timer);
+#endif
+#ifdef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+static void lvgl_port_touch_sample_callback(esp_lcd_touch_handle_t tp, void *user_data);
+#endif
+static void lvgl_port_touch_update_pointer(lvgl_port_touch_ctx_t *touch_ctx, const lvgl_port_gesture_point_t *points, uint8_t cnt);
 
 /*******************************************************************************
 * Public API functions
@@ -47,8 +71,19 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
         return NULL;
     }
     touch_ctx->handle = touch_cfg->handle;
+    touch_ctx->indev = NULL;
+    touch_ctx->release_timer = NULL;
+    touch_ctx->sampler = (touch_cfg->sampler.ring_size > 0);
+#ifndef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+    ESP_GOTO_ON_FALSE(!touch_ctx->sampler, ESP_ERR_NOT_SUPPORTED, err, TAG, "Touch sampler needs esp_lcd_touch 1.2.0 or newer!");
+#endif
+    touch_ctx->pointer.latched = false;
+    touch_ctx->pointer.pressed = false;
+    touch_ctx->pointer.point.x = 0;
+    touch_ctx->pointer.point.y = 0;
+    lvgl_port_gesture_init(&touch_ctx->tracker, NULL);
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC && !touch_ctx->sampler) {
         /* Register touch interrupt callback */
         ret = esp_lcd_touch_register_interrupt_callback_with_data(touch_ctx->handle, lvgl_port_touch_interrupt_callback, touch_ctx);
         ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in register touch interrupt.");
@@ -58,18 +93,54 @@ lv_indev_t *lvgl_port_add_touch(const lvgl_port_touch_cfg_t *touch_cfg)
     /* Register a touchpad input device */
     indev = lv_indev_create();
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
-    /* Event mode can be set only, when touch interrupt enabled */
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+    /* Event mode can be set only, when touch interrupt enabled or reader task wakes LVGL task with each sample */
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC || touch_ctx->sampler) {
         lv_indev_set_mode(indev, LV_INDEV_MODE_EVENT);
     }
     lv_indev_set_read_cb(indev, lvgl_port_touchpad_read);
     lv_indev_set_disp(indev, touch_cfg->disp);
     lv_indev_set_user_data(indev, touch_ctx);
     touch_ctx->indev = indev;
+#ifdef ESP_LCD_TOUCH_FILTER_SUPPORTED
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC && !touch_ctx->sampler) {
+        /* Resumed by read, when release is held by noise filter of esp_lcd_touch */
+        touch_ctx->release_timer = lv_timer_create(lvgl_port_touch_release_timer, LVGL_PORT_TOUCH_RELEASE_POLL_MS, touch_ctx);
+        if (touch_ctx->release_timer) {
+            lv_timer_pause(touch_ctx->release_timer);
+        } else {
+            ret = ESP_ERR_NO_MEM;
+        }
+    }
+#endif
     lvgl_port_unlock();
+    ESP_GOTO_ON_ERROR(ret, err, TAG, "Not enough memory for touch release timer!");
+
+#ifdef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+    if (touch_ctx->sampler) {
+        /* Reader task saves all samples between LVGL reads */
+        const esp_lcd_touch_sampler_config_t sampler_cfg = {
+            .ring_size = touch_cfg->sampler.ring_size,
+            .task_priority = touch_cfg->sampler.task_priority,
+            .task_affinity = touch_cfg->sampler.task_affinity,
+            .on_sample = lvgl_port_touch_sample_callback,
+            .user_data = touch_ctx,
+        };
+        ret = esp_lcd_touch_sampler_start(touch_ctx->handle, &sampler_cfg);
+        ESP_GOTO_ON_ERROR(ret, err, TAG, "Error in start of touch sampler.");
+    }
+#endif
 
 err:
     if (ret != ESP_OK) {
+        if (indev) {
+            lvgl_port_lock(0);
+            if (touch_ctx->release_timer) {
+                lv_timer_delete(touch_ctx->release_timer);
+            }
+            lv_indev_delete(indev);
+            lvgl_port_unlock();
+            indev = NULL;
+        }
         if (touch_ctx) {
             free(touch_ctx);
         }
@@ -83,12 +154,22 @@ esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
     assert(touch);
     lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_indev_get_user_data(touch);
 
+#ifdef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+    if (touch_ctx->sampler) {
+        /* Reader task does not wake LVGL task for removed input device */
+        esp_lcd_touch_sampler_stop(touch_ctx->handle);
+    }
+#endif
+
     lvgl_port_lock(0);
+    if (touch_ctx->release_timer) {
+        lv_timer_delete(touch_ctx->release_timer);
+    }
     /* Remove input device driver */
     lv_indev_delete(touch);
     lvgl_port_unlock();
 
-    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC) {
+    if (touch_ctx->handle->config.int_gpio_num != GPIO_NUM_NC && !touch_ctx->sampler) {
         /* Unregister touch interrupt callback */
         esp_lcd_touch_register_interrupt_callback(touch_ctx->handle, NULL);
     }
@@ -100,6 +181,29 @@ esp_err_t lvgl_port_remove_touch(lv_indev_t *touch)
     return ESP_OK;
 }
 
+esp_err_t lvgl_port_touch_get_gesture(lv_indev_t *touch, lvgl_port_touch_gesture_t *gesture)
+{
+    assert(touch);
+    assert(gesture);
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_indev_get_user_data(touch);
+    assert(touch_ctx);
+
+    /* Updated in read callback, which runs with LVGL mutex */
+    lvgl_port_lock(0);
+    const lvgl_port_gesture_t *last = &touch_ctx->tracker.gesture;
+    gesture->active = last->active;
+    gesture->recognized = last->recognized;
+    gesture->scale = last->scale;
+    gesture->rotation = last->rotation;
+    gesture->scroll_x = last->scroll_x;
+    gesture->scroll_y = last->scroll_y;
+    gesture->center_x = last->center_x;
+    gesture->center_y = last->center_y;
+    lvgl_port_unlock();
+
+    return ESP_OK;
+}
+
 /*******************************************************************************
 * Private functions
 *******************************************************************************/
@@ -111,23 +215,82 @@ static void lvgl_port_touchpad_read(lv_indev_t *indev_drv, lv_indev_data_t *data
     assert(touch_ctx);
     assert(touch_ctx->handle);
 
-    uint16_t touchpad_x[1] = {0};
-    uint16_t touchpad_y[1] = {0};
-    uint8_t touchpad_cnt = 0;
+    uint16_t touch_x[CONFIG_ESP_LCD_TOUCH_MAX_POINTS] = {0};
+    uint16_t touch_y[CONFIG_ESP_LCD_TOUCH_MAX_POINTS] = {0};
+    uint8_t touch_cnt = 0;
+    int64_t timestamp_us = 0;
+    lvgl_port_gesture_point_t points[2 * LVGL_PORT_GESTURE_POINTS_MAX];
 
-    /* Read data from touch controller into memory */
-    esp_lcd_touch_read_data(touch_ctx->handle);
+#ifdef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+    if (touch_ctx->sampler) {
+        esp_lcd_touch_sample_t sample;
+        uint16_t remaining = 0;
 
-    /* Read data from touch controller */
-    bool touchpad_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touchpad_x, touchpad_y, NULL, &touchpad_cnt, 1);
+        /* Take the oldest sample, LVGL calls this again while there are more samples */
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_TOUCH_READ, LVGL_PORT_TRACE_BEGIN, 0, 0);
+        bool taken = esp_lcd_touch_get_sample(touch_ctx->handle, &sample, &remaining);
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_TOUCH_READ, LVGL_PORT_TRACE_END, taken ? sample.points : 0, remaining);
+        data->continue_reading = (remaining > 0);
+        if (!taken) {
+            /* No new sample, the state is not changed */
+            data->point = touch_ctx->pointer.point;
+            data->state = (touch_ctx->pointer.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED);
+            return;
+        }
+        touch_cnt = sample.points;
+        memcpy(touch_x, sample.x, sizeof(touch_x));
+        memcpy(touch_y, sample.y, sizeof(touch_y));
+        timestamp_us = sample.timestamp_us;
+    } else
+#endif
+    {
+        /* Read data from touch controller into memory (all points of one frame) */
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_TOUCH_READ, LVGL_PORT_TRACE_BEGIN, 0, 0);
+        esp_lcd_touch_read_data(touch_ctx->handle);
 
-    if (touchpad_pressed && touchpad_cnt > 0) {
-        data->point.x = touchpad_x[0];
-        data->point.y = touchpad_y[0];
-        data->state = LV_INDEV_STATE_PRESSED;
-    } else {
-        data->state = LV_INDEV_STATE_RELEASED;
+        /* Read data from touch controller */
+        bool touchpad_pressed = esp_lcd_touch_get_coordinates(touch_ctx->handle, touch_x, touch_y, NULL, &touch_cnt, CONFIG_ESP_LCD_TOUCH_MAX_POINTS);
+        LVGL_PORT_TRACE(LVGL_PORT_TRACE_TOUCH_READ, LVGL_PORT_TRACE_END, touchpad_pressed ? touch_cnt : 0, 0);
+        if (!touchpad_pressed) {
+            touch_cnt = 0;
+        }
+        timestamp_us = esp_timer_get_time();
+#ifdef ESP_LCD_TOUCH_FILTER_SUPPORTED
+        if (touch_ctx->release_timer) {
+            /* Held release is read again, until it is reported */
+            if (esp_lcd_touch_release_pending(touch_ctx->handle)) {
+                lv_timer_resume(touch_ctx->release_timer);
+            } else {
+                lv_timer_pause(touch_ctx->release_timer);
+            }
+        }
+#endif
     }
+
+    /* Assign touch IDs, released points are reported once with their last position */
+    const uint8_t cnt = lvgl_port_gesture_update(&touch_ctx->tracker, touch_x, touch_y, touch_cnt, points);
+    lvgl_port_touch_update_pointer(touch_ctx, points, cnt);
+
+    data->point = touch_ctx->pointer.point;
+    data->state = (touch_ctx->pointer.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED);
+
+#if LV_USE_GESTURE_RECOGNITION
+    /* LVGL recognizes pinch, rotate and two-finger swipe from all points (from LVGL 9.3) */
+    lv_indev_touch_data_t touches[2 * LVGL_PORT_GESTURE_POINTS_MAX];
+    /* Buffered samples keep their age in LVGL ticks */
+    const uint32_t now = lv_tick_get() - (uint32_t)((esp_timer_get_time() - timestamp_us) / 1000);
+    for (uint8_t i = 0; i < cnt; i++) {
+        touches[i].point.x = points[i].x;
+        touches[i].point.y = points[i].y;
+        touches[i].state = (points[i].pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED);
+        touches[i].id = points[i].id;
+        touches[i].timestamp = now;
+    }
+    lv_indev_gesture_recognizers_update(indev_drv, touches, cnt);
+    lv_indev_gesture_recognizers_set_data(indev_drv, data);
+#else
+    (void)timestamp_us;
+#endif
 }
 
 static void IRAM_ATTR lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t tp)
@@ -137,3 +300,48 @@ static void IRAM_ATTR lvgl_port_touch_interrupt_callback(esp_lcd_touch_handle_t
     /* Wake LVGL task, if needed */
     lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
 }
+
+#ifdef ESP_LCD_TOUCH_FILTER_SUPPORTED
+static void lvgl_port_touch_release_timer(lv_timer_t *timer)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)lv_timer_get_user_data(timer);
+
+    /* Input device is in event mode, it is read only on request */
+    lv_indev_read(touch_ctx->indev);
+}
+#endif
+
+#ifdef ESP_LCD_TOUCH_SAMPLER_SUPPORTED
+static void lvgl_port_touch_sample_callback(esp_lcd_touch_handle_t tp, void *user_data)
+{
+    lvgl_port_touch_ctx_t *touch_ctx = (lvgl_port_touch_ctx_t *)user_data;
+
+    /* Wake LVGL task to take the new sample */
+    lvgl_port_task_wake(LVGL_PORT_EVENT_TOUCH, touch_ctx->indev);
+}
+#endif
+
+static void lvgl_port_touch_update_pointer(lvgl_port_touch_ctx_t *touch_ctx, const lvgl_port_gesture_point_t *points, uint8_t cnt)
+{
+    /* LVGL pointer follows the first pressed finger, it does not jump to the other fingers when it is released */
+    if (!touch_ctx->pointer.latched && touch_ctx->tracker.count > 0) {
+        touch_ctx->pointer.latched = true;
+        touch_ctx->pointer.id = points[0].id;
+    }
+
+    if (touch_ctx->pointer.latched) {
+        touch_ctx->pointer.pressed = false;
+        for (uint8_t i = 0; i < cnt; i++) {
+            if (points[i].id == touch_ctx->pointer.id) {
+                touch_ctx->pointer.point.x = points[i].x;
+                touch_ctx->pointer.point.y = points[i].y;
+                touch_ctx->pointer.pressed = points[i].pressed;
+                break;
+            }
+        }
+    }
+
+    if (touch_ctx->tracker.count == 0) {
+        touch_ctx->pointer.latched = false;
+    }
+}
@@ -0,0 +1,126 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lvgl_port.h"
+#include "esp_lvgl_port_priv.h"
+#include "esp_lvgl_port_tracebuf.h"
+
+static const char *TAG = "LVGL";
+
+/* Maximum length of one JSON event */
+#define LVGL_PORT_TRACE_LINE_LEN    (192)
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+bool lvgl_port_trace_enabled;
+static lvgl_port_trace_ring_t *lvgl_port_trace_ring;
+static size_t lvgl_port_trace_ring_bytes;
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t lvgl_port_trace_start(uint32_t entries)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_task_get_handle(), ESP_ERR_INVALID_STATE, TAG, "LVGL port is not initialized");
+
+    if (entries == 0) {
+        entries = LVGL_PORT_TRACE_ENTRIES_DEFAULT;
+    }
+
+    const size_t size = lvgl_port_trace_ring_size(entries);
+    if (lvgl_port_trace_ring == NULL) {
+        /* Written from transfer done interrupts, which can run while cache is disabled */
+        void *mem = heap_caps_malloc(size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ESP_RETURN_ON_FALSE(mem, ESP_ERR_NO_MEM, TAG, "Not enough memory for trace buffer!");
+        lvgl_port_trace_ring = lvgl_port_trace_ring_init(mem, entries);
+        lvgl_port_trace_ring_bytes = size;
+    }
+    ESP_RETURN_ON_FALSE(size == lvgl_port_trace_ring_bytes, ESP_ERR_INVALID_SIZE, TAG, "Trace buffer is allocated with different size");
+
+    lvgl_port_trace_enabled = false;
+    lvgl_port_trace_ring_clear(lvgl_port_trace_ring);
+    lvgl_port_trace_enabled = true;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_trace_stop(void)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_trace_ring, ESP_ERR_INVALID_STATE, TAG, "Trace was not started");
+
+    lvgl_port_trace_enabled = false;
+
+    return ESP_OK;
+}
+
+esp_err_t lvgl_port_trace_dump(FILE *stream)
+{
+    ESP_RETURN_ON_FALSE(lvgl_port_trace_ring, ESP_ERR_INVALID_STATE, TAG, "Trace was not started");
+    char line[LVGL_PORT_TRACE_LINE_LEN];
+
+    if (stream == NULL) {
+        stream = stdout;
+    }
+
+    /* Printing takes long, the records of the dump itself would overwrite the trace */
+    const bool enabled = lvgl_port_trace_enabled;
+    lvgl_port_trace_enabled = false;
+
+    uint32_t count = 0;
+    const uint32_t first = lvgl_port_trace_ring_first(lvgl_port_trace_ring, &count);
+    const uint32_t ts_base = (count ? lvgl_port_trace_ring_get(lvgl_port_trace_ring, first)->ts : 0);
+
+    fprintf(stream, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"start_us\":%" PRIu32 ",\"records\":%" PRIu32 "},\"traceEvents\":[\n", ts_base, count);
+    lvgl_port_trace_format_thread(0, "interrupt", line, sizeof(line));
+    fputs(line, stream);
+    void *lvgl_task = lvgl_port_task_get_handle();
+    if (lvgl_task) {
+        lvgl_port_trace_format_thread((uint32_t)(uintptr_t)lvgl_task, pcTaskGetName(lvgl_task), line, sizeof(line));
+        fprintf(stream, ",\n%s", line);
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (lvgl_port_trace_format(lvgl_port_trace_ring_get(lvgl_port_trace_ring, first + i), ts_base, line, sizeof(line)) > 0) {
+            fprintf(stream, ",\n%s", line);
+        }
+    }
+    fputs("\n]}\n", stream);
+    fflush(stream);
+
+    lvgl_port_trace_enabled = enabled;
+
+    return ESP_OK;
+}
+
+IRAM_ATTR void lvgl_port_trace_record(uint8_t event, uint8_t phase, uint32_t arg0, uint32_t arg1)
+{
+    lvgl_port_trace_ring_t *ring = lvgl_port_trace_ring;
+
+    if (ring) {
+        const uint32_t tid = (xPortInIsrContext() == pdTRUE ? 0 : (uint32_t)(uintptr_t)xTaskGetCurrentTaskHandle());
+        lvgl_port_trace_ring_put(ring, (uint32_t)esp_timer_get_time(), tid, event, phase, arg0, arg1);
+    }
+}
+
+void lvgl_port_trace_deinit(void)
+{
+    lvgl_port_trace_enabled = false;
+    free(lvgl_port_trace_ring);
+    lvgl_port_trace_ring = NULL;
+    lvgl_port_trace_ring_bytes = 0;
+}
@@ -0,0 +1,142 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include "esp_err.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_mock.h"
+#include "esp_lvgl_port.h"
+#include "demos/lv_demos.h"
+
+/* LCD size */
+#define BENCHMARK_LCD_H_RES         (320)
+#define BENCHMARK_LCD_V_RES         (240)
+#define BENCHMARK_DRAW_BUFF_HEIGHT  (50)
+
+static const char *TAG = "benchmark";
+
+/* Port configuration, all of them run the same demo on the same simulated bus */
+typedef struct {
+    const char *name;
+    bool    double_buffer;
+    uint8_t buffer_count;
+    bool    swap_bytes;
+    uint8_t coalesce_overdraw;
+    uint32_t tx_lines;
+} benchmark_cfg_t;
+
+static const benchmark_cfg_t benchmark_cfgs[] = {
+    { .name = "single_buffer" },
+    { .name = "double_buffer", .double_buffer = true },
+    { .name = "swap_bytes", .double_buffer = true, .swap_bytes = true },
+    { .name = "coalesce", .double_buffer = true, .coalesce_overdraw = 20 },
+    { .name = "buffer_ring", .buffer_count = 3 },
+    { .name = "tx_task", .double_buffer = true, .swap_bytes = true, .tx_lines = BENCHMARK_DRAW_BUFF_HEIGHT },
+};
+
+typedef struct {
+    lvgl_port_disp_stats_t disp;
+    esp_lcd_mock_stats_t bus;
+} benchmark_result_t;
+
+static void benchmark_run(const benchmark_cfg_t *cfg, benchmark_result_t *res)
+{
+    esp_lcd_panel_io_handle_t io = NULL;
+    esp_lcd_panel_handle_t panel = NULL;
+    const esp_lcd_mock_config_t mock_cfg = {
+        .hres = BENCHMARK_LCD_H_RES,
+        .vres = BENCHMARK_LCD_V_RES,
+        .bits_per_pixel = 16,
+        .bus_bytes_per_sec = CONFIG_BENCHMARK_BUS_KBPS * 1000,
+        .trans_overhead_us = 20,
+        .flags = {
+            .swap_bytes = cfg->swap_bytes,
+            .wait_color_done = true,
+        }
+    };
+    ESP_ERROR_CHECK(esp_lcd_new_mock_panel(&mock_cfg, &io, &panel));
+
+    const lvgl_port_display_cfg_t disp_cfg = {
+        .io_handle = io,
+        .panel_handle = panel,
+        .buffer_size = BENCHMARK_LCD_H_RES * BENCHMARK_DRAW_BUFF_HEIGHT,
+        .double_buffer = cfg->double_buffer,
+        .buffer_count = cfg->buffer_count,
+        .coalesce_overdraw = cfg->coalesce_overdraw,
+        .hres = BENCHMARK_LCD_H_RES,
+        .vres = BENCHMARK_LCD_V_RES,
+        .tx_task = {
+            .size = cfg->tx_lines * BENCHMARK_LCD_H_RES,
+            .affinity = -1,
+        },
+        .flags = {
+            .swap_bytes = cfg->swap_bytes,
+        }
+    };
+    lv_display_t *disp = lvgl_port_add_disp(&disp_cfg);
+    assert(disp);
+    ESP_ERROR_CHECK(lvgl_port_disp_stats_enable(disp, true));
+
+    lvgl_port_lock(0);
+    lv_demo_benchmark();
+    lvgl_port_unlock();
+
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_BENCHMARK_RUN_MS));
+    ESP_ERROR_CHECK(lvgl_port_disp_get_stats(disp, &res->disp, true));
+    ESP_ERROR_CHECK(esp_lcd_mock_get_stats(panel, &res->bus, true));
+
+    /* Pending transfers call back into the display, it is removed after them (the last frame stays in the panel memory) */
+    lvgl_port_lock(0);
+    lv_obj_clean(lv_display_get_screen_active(disp));
+    lvgl_port_unlock();
+    ESP_ERROR_CHECK(esp_lcd_mock_wait_idle(panel, 1000));
+    ESP_ERROR_CHECK(lvgl_port_remove_disp(disp));
+    ESP_ERROR_CHECK(esp_lcd_mock_wait_idle(panel, 1000));
+#if CONFIG_BENCHMARK_DUMP_PPM
+    char path[64];
+    snprintf(path, sizeof(path), "benchmark_%s.ppm", cfg->name);
+    if (esp_lcd_mock_dump_ppm(panel, path) == ESP_OK) {
+        ESP_LOGI(TAG, "Last frame saved into %s", path);
+    }
+#endif
+
+    esp_lcd_panel_del(panel);
+    esp_lcd_panel_io_del(io);
+}
+
+void app_main(void)
+{
+    const size_t count = sizeof(benchmark_cfgs) / sizeof(benchmark_cfgs[0]);
+    benchmark_result_t results[sizeof(benchmark_cfgs) / sizeof(benchmark_cfgs[0])];
+
+    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    ESP_ERROR_CHECK(lvgl_port_init(&lvgl_cfg));
+
+    for (size_t i = 0; i < count; i++) {
+        ESP_LOGI(TAG, "Running %s for %d ms", benchmark_cfgs[i].name, CONFIG_BENCHMARK_RUN_MS);
+        benchmark_run(&benchmark_cfgs[i], &results[i]);
+    }
+
+    printf("\n%-16s %6s %8s %10s %10s %8s %12s %10s\n", "config", "fps", "flushes", "transfers", "kB", "bus %", "flush wait", "render");
+    for (size_t i = 0; i < count; i++) {
+        const lvgl_port_disp_stats_t *disp = &results[i].disp;
+        const esp_lcd_mock_stats_t *bus = &results[i].bus;
+        const uint64_t elapsed_ms = (disp->elapsed_us > 1000 ? disp->elapsed_us / 1000 : 1);
+        printf("%-16s %3u.%02u %8u %10u %10u %8u %9u ms %7u ms\n", benchmark_cfgs[i].name,
+               (unsigned)((uint64_t)disp->frames * 1000 / elapsed_ms), (unsigned)((uint64_t)disp->frames * 100000 / elapsed_ms % 100),
+               (unsigned)disp->areas, (unsigned)bus->transfers, (unsigned)(bus->bytes / 1000),
+               (unsigned)(bus->bus_busy_us / 10 / elapsed_ms), (unsigned)(disp->flush_wait_us / 1000), (unsigned)(disp->render_us / 1000));
+    }
+
+    ESP_ERROR_CHECK(lvgl_port_deinit());
+    exit(0);
+}
@@ -0,0 +1,187 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_area.h"
+#include "test_host.h"
+
+/* Cost model of SPI panel (40 MHz, RGB565): CASET + RASET + RAMWR transactions per transfer and 0.4 us per pixel */
+#define TEST_TRANS_OVERHEAD_NS  (60000)
+#define TEST_PIXEL_NS           (400)
+
+/* End of frame in recorded trace */
+#define TEST_FRAME_END          {-1, -1, -1, -1}
+
+/*
+ * Invalidation traces recorded from LV_EVENT_RENDER_START on 320x240 ILI9341 (after LVGL's own join).
+ * Every frame is terminated by TEST_FRAME_END.
+ */
+
+/* Status bar with clock, wifi and battery labels, and a value label in the middle */
+static const lvgl_port_area_t trace_labels[] = {
+    {250, 4, 289, 17}, {292, 4, 315, 17}, {226, 4, 245, 17}, {120, 100, 199, 123}, TEST_FRAME_END,
+    {250, 4, 289, 17}, {120, 100, 199, 123}, TEST_FRAME_END,
+    {250, 4, 289, 17}, {292, 4, 315, 17}, {120, 100, 199, 123}, {120, 126, 199, 139}, TEST_FRAME_END,
+    {250, 4, 289, 17}, {226, 4, 245, 17}, {120, 100, 199, 123}, {120, 126, 199, 139}, TEST_FRAME_END,
+};
+
+/* Grid of small value labels (dashboard) */
+static const lvgl_port_area_t trace_dashboard[] = {
+    {10, 40, 69, 55}, {90, 40, 149, 55}, {170, 40, 229, 55}, {250, 40, 309, 55},
+    {10, 80, 69, 95}, {90, 80, 149, 95}, {170, 80, 229, 95}, {250, 80, 309, 95},
+    {10, 120, 69, 135}, {90, 120, 149, 135}, {170, 120, 229, 135}, {250, 120, 309, 135}, TEST_FRAME_END,
+    {10, 40, 69, 55}, {170, 40, 229, 55}, {90, 80, 149, 95}, {250, 80, 309, 95},
+    {10, 120, 69, 135}, {170, 120, 229, 135}, TEST_FRAME_END,
+    {90, 40, 149, 55}, {250, 40, 309, 55}, {10, 80, 69, 95}, {170, 80, 229, 95},
+    {90, 120, 149, 135}, {250, 120, 309, 135}, TEST_FRAME_END,
+};
+
+/* Progress bar, spinner arc pieces and its percentage label */
+static const lvgl_port_area_t trace_spinner[] = {
+    {140, 80, 179, 89}, {180, 90, 189, 129}, {150, 130, 179, 139}, {60, 180, 161, 191}, {150, 196, 169, 209}, TEST_FRAME_END,
+    {130, 90, 139, 129}, {140, 80, 179, 89}, {62, 180, 163, 191}, {150, 196, 169, 209}, TEST_FRAME_END,
+    {150, 130, 179, 139}, {130, 90, 139, 129}, {64, 180, 165, 191}, {150, 196, 169, 209}, TEST_FRAME_END,
+};
+
+typedef struct {
+    const char *name;
+    const lvgl_port_area_t *trace;
+    uint32_t len;
+} test_trace_t;
+
+static const test_trace_t test_traces[] = {
+    {"labels", trace_labels, sizeof(trace_labels) / sizeof(trace_labels[0])},
+    {"dashboard", trace_dashboard, sizeof(trace_dashboard) / sizeof(trace_dashboard[0])},
+    {"spinner", trace_spinner, sizeof(trace_spinner) / sizeof(trace_spinner[0])},
+};
+
+typedef struct {
+    uint32_t frames;
+    uint32_t transfers;
+    uint64_t pixels;
+    uint64_t overdraw;
+    uint32_t merged;
+    int64_t time_us;
+} test_replay_res_t;
+
+static void test_replay_trace(const test_trace_t *trace, uint32_t overdraw_pct, test_replay_res_t *res)
+{
+    lvgl_port_area_t areas[64];
+    uint8_t joined[64];
+    uint32_t cnt = 0;
+
+    memset(res, 0, sizeof(test_replay_res_t));
+    for (uint32_t i = 0; i < trace->len; i++) {
+        if (trace->trace[i].x1 >= 0) {
+            areas[cnt] = trace->trace[i];
+            joined[cnt] = 0;
+            cnt++;
+            continue;
+        }
+
+        /* End of frame */
+        lvgl_port_area_result_t area_res = {0};
+        const int64_t start = test_host_time_us();
+        if (overdraw_pct > 0) {
+            lvgl_port_area_coalesce(areas, joined, cnt, overdraw_pct, &area_res);
+        }
+        res->time_us += test_host_time_us() - start;
+
+        for (uint32_t a = 0; a < cnt; a++) {
+            if (!joined[a]) {
+                res->transfers++;
+                res->pixels += lvgl_port_area_get_size(&areas[a]);
+            }
+        }
+        res->overdraw += area_res.overdraw_px;
+        res->merged += area_res.merged;
+        res->frames++;
+        cnt = 0;
+    }
+}
+
+TEST_CASE("Coalesce adjacent areas without overdraw", "[area]")
+{
+    lvgl_port_area_t areas[] = {
+        {0, 0, 9, 9}, {10, 0, 19, 9}, {0, 10, 19, 19},
+    };
+    uint8_t joined[3] = {0};
+    lvgl_port_area_result_t res;
+
+    TEST_ASSERT_EQUAL(2, lvgl_port_area_coalesce(areas, joined, 3, 1, &res));
+    TEST_ASSERT_EQUAL(1, res.areas_out);
+    TEST_ASSERT_EQUAL(0, res.overdraw_px);
+    TEST_ASSERT_EQUAL(0, res.unmerged);
+    /* Merged area must stay on the last index */
+    TEST_ASSERT_EQUAL(0, joined[2]);
+    TEST_ASSERT_EQUAL(0, areas[2].x1);
+    TEST_ASSERT_EQUAL(0, areas[2].y1);
+    TEST_ASSERT_EQUAL(19, areas[2].x2);
+    TEST_ASSERT_EQUAL(19, areas[2].y2);
+}
+
+TEST_CASE("Coalesce respects overdraw budget", "[area]")
+{
+    lvgl_port_area_t areas[] = {
+        {0, 0, 9, 9}, {100, 100, 109, 109}, {12, 0, 21, 9},
+    };
+    uint8_t joined[3] = {0};
+    lvgl_port_area_result_t res;
+
+    /* Gap of 2 columns between area 0 and 2 is 10% of 200 pixels */
+    TEST_ASSERT_EQUAL(0, lvgl_port_area_coalesce(areas, joined, 3, 5, &res));
+    TEST_ASSERT_EQUAL(3, res.unmerged);
+
+    TEST_ASSERT_EQUAL(1, lvgl_port_area_coalesce(areas, joined, 3, 10, &res));
+    TEST_ASSERT_EQUAL(1, joined[0]);
+    TEST_ASSERT_EQUAL(0, joined[1]);
+    TEST_ASSERT_EQUAL(0, joined[2]);
+    TEST_ASSERT_EQUAL(20, res.overdraw_px);
+    TEST_ASSERT_EQUAL(1, res.unmerged);
+}
+
+TEST_CASE("Coalesce counts overlapped pixels once", "[area]")
+{
+    lvgl_port_area_t areas[] = {
+        {0, 0, 19, 9}, {10, 0, 29, 9}, {50, 50, 59, 59},
+    };
+    uint8_t joined[3] = {1, 0, 0};
+
+    /* Joined areas are ignored */
+    TEST_ASSERT_EQUAL(0, lvgl_port_area_coalesce(areas, joined, 3, 50, NULL));
+
+    joined[0] = 0;
+    TEST_ASSERT_EQUAL(1, lvgl_port_area_coalesce(areas, joined, 3, 1, NULL));
+    TEST_ASSERT_EQUAL(0, areas[1].x1);
+    TEST_ASSERT_EQUAL(29, areas[1].x2);
+}
+
+TEST_CASE("Coalesce benchmark on recorded traces", "[area][benchmark]")
+{
+    const uint32_t budgets[] = {0, 10, 25, 50, 100};
+
+    for (uint32_t t = 0; t < sizeof(test_traces) / sizeof(test_traces[0]); t++) {
+        test_replay_res_t base;
+        test_replay_trace(&test_traces[t], 0, &base);
+        const uint64_t base_ns = (uint64_t)base.transfers * TEST_TRANS_OVERHEAD_NS + base.pixels * TEST_PIXEL_NS;
+
+        for (uint32_t b = 0; b < sizeof(budgets) / sizeof(budgets[0]); b++) {
+            test_replay_res_t res;
+            test_replay_trace(&test_traces[t], budgets[b], &res);
+            const uint64_t bus_ns = (uint64_t)res.transfers * TEST_TRANS_OVERHEAD_NS + res.pixels * TEST_PIXEL_NS;
+            printf("%-10s budget %3u%%: transfers %3u, merged %3u, pixels %6u, overdraw %5u, bus %6u us (%3u%%), coalesce %u us\n",
+                   test_traces[t].name, (unsigned)budgets[b], (unsigned)res.transfers, (unsigned)res.merged,
+                   (unsigned)res.pixels, (unsigned)res.overdraw, (unsigned)(bus_ns / 1000),
+                   (unsigned)(bus_ns * 100 / base_ns), (unsigned)res.time_us);
+
+            /* Merging must never make the bus time worse than the budget allows */
+            TEST_ASSERT_LESS_OR_EQUAL(base.transfers, res.transfers);
+            TEST_ASSERT_LESS_OR_EQUAL(base.pixels * (100 + budgets[b]) / 100, res.pixels);
+        }
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_blit.h"
+#include "test_host.h"
+
+#define TEST_BLIT_HRES  (48)
+#define TEST_BLIT_VRES  (32)
+
+/* Reference: rotate whole screen, then mirror and convert pixel by pixel */
+static void test_blit_ref(const lvgl_port_blit_cfg_t *cfg, uint8_t *fb, const uint16_t *screen)
+{
+    const bool swap_xy = (cfg->rotation == LVGL_PORT_ROTATE_90 || cfg->rotation == LVGL_PORT_ROTATE_270);
+    const uint32_t fb_w = (swap_xy ? cfg->vres : cfg->hres);
+    const uint32_t fb_h = (swap_xy ? cfg->hres : cfg->vres);
+    uint16_t *rotated = malloc(cfg->hres * cfg->vres * sizeof(uint16_t));
+    TEST_ASSERT_NOT_NULL(rotated);
+
+    lvgl_port_rotate_rgb565(rotated, screen, cfg->hres, cfg->vres, cfg->rotation, LVGL_PORT_ROTATE_TILE);
+
+    for (uint32_t y = 0; y < fb_h; y++) {
+        for (uint32_t x = 0; x < fb_w; x++) {
+            const uint32_t dx = (cfg->mirror_x ? fb_w - 1 - x : x);
+            const uint32_t dy = (cfg->mirror_y ? fb_h - 1 - y : y);
+            uint16_t px = rotated[y * fb_w + x];
+            if (cfg->swap_bytes) {
+                px = (uint16_t)((px >> 8) | (px << 8));
+            }
+            if (cfg->rgb888) {
+                /* Stored as B, G, R; lower bits are filled by upper bits of the channel */
+                const uint32_t b = (px & 0x1F) << 3;
+                const uint32_t g = ((px >> 5) & 0x3F) << 2;
+                const uint32_t r = (px >> 11) << 3;
+                uint8_t *dst = fb + (dy * fb_w + dx) * 3;
+                dst[0] = (uint8_t)(b | (b >> 5));
+                dst[1] = (uint8_t)(g | (g >> 6));
+                dst[2] = (uint8_t)(r | (r >> 5));
+            } else {
+                ((uint16_t *)fb)[dy * fb_w + dx] = px;
+            }
+        }
+    }
+    free(rotated);
+}
+
+static void test_blit_compare(const lvgl_port_blit_cfg_t *cfg)
+{
+    const uint32_t pixels = cfg->hres * cfg->vres;
+    const uint32_t fb_size = pixels * (cfg->rgb888 ? 3 : 2);
+    uint16_t *screen = malloc(pixels * sizeof(uint16_t));
+    uint8_t *ref = malloc(fb_size);
+    uint8_t *out = malloc(fb_size);
+    TEST_ASSERT_NOT_NULL(screen);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+
+    for (uint32_t i = 0; i < pixels; i++) {
+        screen[i] = (uint16_t)(i * 2654435761u >> 7);
+    }
+    test_blit_ref(cfg, ref, screen);
+
+    /* Copy the screen in stripes of areas (as rendered in partial mode) */
+    memset(out, 0, fb_size);
+    for (int32_t y = 0; y < (int32_t)cfg->vres; y += 10) {
+        for (int32_t x = 0; x < (int32_t)cfg->hres; x += 20) {
+            lvgl_port_area_t area = {x, y, x + 19, y + 9};
+            if (area.x2 >= (int32_t)cfg->hres) {
+                area.x2 = cfg->hres - 1;
+            }
+            if (area.y2 >= (int32_t)cfg->vres) {
+                area.y2 = cfg->vres - 1;
+            }
+            lvgl_port_blit_rgb565(cfg, out, screen + y * cfg->hres + x, cfg->hres, &area);
+        }
+    }
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, fb_size);
+
+    free(screen);
+    free(ref);
+    free(out);
+}
+
+TEST_CASE("Blit matches reference for all rotations and mirrors", "[blit]")
+{
+    for (int r = LVGL_PORT_ROTATE_0; r <= LVGL_PORT_ROTATE_270; r++) {
+        for (int m = 0; m < 4; m++) {
+            for (int f = 0; f < 4; f++) {
+                lvgl_port_blit_cfg_t cfg = {
+                    .hres = TEST_BLIT_HRES,
+                    .vres = TEST_BLIT_VRES,
+                    .rotation = r,
+                    .mirror_x = (m & 1),
+                    .mirror_y = (m & 2),
+                    .swap_bytes = (f & 1),
+                    .rgb888 = (f & 2),
+                };
+                test_blit_compare(&cfg);
+            }
+        }
+    }
+}
+
+TEST_CASE("Blit area in frame buffer", "[blit]")
+{
+    const lvgl_port_area_t area = {10, 2, 19, 5};
+    lvgl_port_area_t out;
+    lvgl_port_blit_cfg_t cfg = {
+        .hres = TEST_BLIT_HRES,
+        .vres = TEST_BLIT_VRES,
+        .rotation = LVGL_PORT_ROTATE_90,
+    };
+
+    /* 90: [x, y] -> [y, hres - 1 - x] */
+    lvgl_port_blit_get_area(&cfg, &area, &out);
+    TEST_ASSERT_EQUAL(2, out.x1);
+    TEST_ASSERT_EQUAL(5, out.x2);
+    TEST_ASSERT_EQUAL(TEST_BLIT_HRES - 1 - 19, out.y1);
+    TEST_ASSERT_EQUAL(TEST_BLIT_HRES - 1 - 10, out.y2);
+
+    /* Mirror X on 32 px wide frame buffer */
+    cfg.mirror_x = true;
+    lvgl_port_blit_get_area(&cfg, &area, &out);
+    TEST_ASSERT_EQUAL(TEST_BLIT_VRES - 1 - 5, out.x1);
+    TEST_ASSERT_EQUAL(TEST_BLIT_VRES - 1 - 2, out.x2);
+
+    cfg.rotation = LVGL_PORT_ROTATE_0;
+    cfg.mirror_x = false;
+    lvgl_port_blit_get_area(&cfg, &area, &out);
+    TEST_ASSERT_EQUAL_MEMORY(&area, &out, sizeof(area));
+}
+
+TEST_CASE("Blit benchmark", "[blit][benchmark]")
+{
+    const uint32_t hres = 480;
+    const uint32_t vres = 800;
+    uint16_t *screen = calloc(hres * vres, sizeof(uint16_t));
+    uint8_t *fb = malloc(hres * vres * 3);
+    TEST_ASSERT_NOT_NULL(screen);
+    TEST_ASSERT_NOT_NULL(fb);
+
+    for (int r = LVGL_PORT_ROTATE_0; r <= LVGL_PORT_ROTATE_270; r++) {
+        lvgl_port_blit_cfg_t cfg = {
+            .hres = hres,
+            .vres = vres,
+            .rotation = r,
+            .rgb888 = true,
+        };
+        const lvgl_port_area_t area = {0, 0, hres - 1, vres - 1};
+        const int64_t start = test_host_time_us();
+        lvgl_port_blit_rgb565(&cfg, fb, screen, hres, &area);
+        printf("Blit %ux%u RGB565 -> RGB888, rotation %d: %u us\n", (unsigned)hres, (unsigned)vres, r * 90,
+               (unsigned)(test_host_time_us() - start));
+    }
+
+    free(screen);
+    free(fb);
+}
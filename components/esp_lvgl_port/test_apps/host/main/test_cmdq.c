@@ -0,0 +1,185 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "unity.h"
+#include "esp_lvgl_port_cmdq.h"
+
+#define TEST_CMDQ_LOG_SIZE      (64)
+#define TEST_CMDQ_PRODUCERS     (4)
+#define TEST_CMDQ_PER_PRODUCER  (10000)
+
+static uint32_t test_log[TEST_CMDQ_LOG_SIZE];
+static uint32_t test_log_cnt;
+
+static void test_cmd_log_cb(void *user_data, const void *data, size_t len)
+{
+    uint32_t value = (uint32_t)(uintptr_t)user_data;
+    if (data) {
+        TEST_ASSERT_EQUAL(sizeof(uint32_t), len);
+        memcpy(&value, data, sizeof(value));
+    }
+    if (test_log_cnt < TEST_CMDQ_LOG_SIZE) {
+        test_log[test_log_cnt++] = value;
+    }
+}
+
+TEST_CASE("Command queue order and blobs", "[cmdq]")
+{
+    const lvgl_port_cmd_queue_cfg_t cfg = {.queue_size = 8, .data_size = 4};
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq_create(&cfg);
+    TEST_ASSERT_NOT_NULL(queue);
+    test_log_cnt = 0;
+
+    /* Closure (user data) and blob (copied data) */
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, (void *)1, NULL, 0));
+    uint32_t value = 2;
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, NULL, &value, sizeof(value)));
+    value = 3;
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, NULL, &value, sizeof(value)));
+
+    TEST_ASSERT_EQUAL(3, lvgl_port_cmdq_run(queue));
+    TEST_ASSERT_EQUAL(3, test_log_cnt);
+    TEST_ASSERT_EQUAL(1, test_log[0]);
+    TEST_ASSERT_EQUAL(2, test_log[1]);
+    TEST_ASSERT_EQUAL(3, test_log[2]);
+    TEST_ASSERT_EQUAL(0, lvgl_port_cmdq_run(queue));
+
+    /* Full queue rejects new commands */
+    for (uint32_t i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, (void *)(uintptr_t)i, NULL, 0));
+    }
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_FULL, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, (void *)100, NULL, 0));
+
+    lvgl_port_cmd_stats_t stats;
+    lvgl_port_cmdq_get_stats(queue, &stats, true);
+    TEST_ASSERT_EQUAL(12, stats.posted);
+    TEST_ASSERT_EQUAL(3, stats.applied);
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+    TEST_ASSERT_EQUAL(8, stats.depth);
+    TEST_ASSERT_EQUAL(8, stats.max_depth);
+    TEST_ASSERT_EQUAL(1, stats.batches);
+    TEST_ASSERT_EQUAL(3, stats.max_batch);
+
+    test_log_cnt = 0;
+    TEST_ASSERT_EQUAL(8, lvgl_port_cmdq_run(queue));
+    TEST_ASSERT_EQUAL(7, test_log[7]);
+    lvgl_port_cmdq_get_stats(queue, &stats, false);
+    TEST_ASSERT_EQUAL(0, stats.depth);
+
+    lvgl_port_cmdq_delete(queue);
+}
+
+TEST_CASE("Command queue drop oldest and merge by key", "[cmdq]")
+{
+    const lvgl_port_cmd_queue_cfg_t cfg = {.queue_size = 4, .merge_keys = 2, .overflow = LVGL_PORT_CMD_OVERFLOW_DROP_OLDEST};
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq_create(&cfg);
+    TEST_ASSERT_NOT_NULL(queue);
+    test_log_cnt = 0;
+
+    /* Only the newest command of each key is applied, after the other ones */
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 1, test_cmd_log_cb, (void *)10, NULL, 0));
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_MERGED, lvgl_port_cmdq_post(queue, 1, test_cmd_log_cb, (void *)11, NULL, 0));
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, (void *)1, NULL, 0));
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_POSTED, lvgl_port_cmdq_post(queue, 2, test_cmd_log_cb, (void *)20, NULL, 0));
+    TEST_ASSERT_EQUAL(LVGL_PORT_CMDQ_MERGED, lvgl_port_cmdq_post(queue, 1, test_cmd_log_cb, (void *)12, NULL, 0));
+    TEST_ASSERT_EQUAL(3, lvgl_port_cmdq_run(queue));
+    TEST_ASSERT_EQUAL(1, test_log[0]);
+    TEST_ASSERT_EQUAL(12, test_log[1]);
+    TEST_ASSERT_EQUAL(20, test_log[2]);
+
+    /* Drop oldest: the newest four commands stay */
+    test_log_cnt = 0;
+    for (uint32_t i = 0; i < 6; i++) {
+        TEST_ASSERT_EQUAL(i < 4 ? LVGL_PORT_CMDQ_POSTED : LVGL_PORT_CMDQ_DROPPED,
+                          lvgl_port_cmdq_post(queue, 0, test_cmd_log_cb, (void *)(uintptr_t)i, NULL, 0));
+    }
+    TEST_ASSERT_EQUAL(4, lvgl_port_cmdq_run(queue));
+    TEST_ASSERT_EQUAL(2, test_log[0]);
+    TEST_ASSERT_EQUAL(5, test_log[3]);
+
+    lvgl_port_cmd_stats_t stats;
+    lvgl_port_cmdq_get_stats(queue, &stats, false);
+    TEST_ASSERT_EQUAL(11, stats.posted);
+    TEST_ASSERT_EQUAL(7, stats.applied);
+    TEST_ASSERT_EQUAL(2, stats.merged);
+    TEST_ASSERT_EQUAL(2, stats.dropped);
+    TEST_ASSERT_EQUAL(0, stats.depth);
+    TEST_ASSERT_EQUAL(4, stats.max_depth);
+
+    lvgl_port_cmdq_delete(queue);
+}
+
+static uint64_t test_sum;
+static uint32_t test_last[TEST_CMDQ_PRODUCERS];
+static uint32_t test_order_errors;
+
+static void test_cmd_sum_cb(void *user_data, const void *data, size_t len)
+{
+    uint32_t value[2];
+    TEST_ASSERT_NULL(user_data);
+    TEST_ASSERT_EQUAL(sizeof(value), len);
+    memcpy(value, data, sizeof(value));
+    test_sum += value[1];
+    /* Commands of one producer keep their order */
+    if (value[1] <= test_last[value[0]]) {
+        test_order_errors++;
+    }
+    test_last[value[0]] = value[1];
+}
+
+static void *test_cmd_producer(void *arg)
+{
+    lvgl_port_cmdq_t *queue = (lvgl_port_cmdq_t *)arg;
+    static uint32_t next_id;
+    uint32_t value[2] = {__atomic_fetch_add(&next_id, 1, __ATOMIC_RELAXED) % TEST_CMDQ_PRODUCERS, 0};
+
+    for (uint32_t i = 1; i <= TEST_CMDQ_PER_PRODUCER; i++) {
+        value[1] = i;
+        while (lvgl_port_cmdq_post(queue, 0, test_cmd_sum_cb, NULL, value, sizeof(value)) == LVGL_PORT_CMDQ_FULL) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+TEST_CASE("Command queue multiple producers", "[cmdq]")
+{
+    const lvgl_port_cmd_queue_cfg_t cfg = {.queue_size = 64};
+    lvgl_port_cmdq_t *queue = lvgl_port_cmdq_create(&cfg);
+    TEST_ASSERT_NOT_NULL(queue);
+    pthread_t threads[TEST_CMDQ_PRODUCERS];
+    test_sum = 0;
+    test_order_errors = 0;
+    memset(test_last, 0, sizeof(test_last));
+
+    for (int i = 0; i < TEST_CMDQ_PRODUCERS; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, test_cmd_producer, queue));
+    }
+
+    /* Single consumer */
+    const uint64_t expected = (uint64_t)TEST_CMDQ_PRODUCERS * TEST_CMDQ_PER_PRODUCER * (TEST_CMDQ_PER_PRODUCER + 1) / 2;
+    lvgl_port_cmd_stats_t stats;
+    do {
+        lvgl_port_cmdq_run(queue);
+        lvgl_port_cmdq_get_stats(queue, &stats, false);
+    } while (stats.applied < TEST_CMDQ_PRODUCERS * TEST_CMDQ_PER_PRODUCER);
+
+    for (int i = 0; i < TEST_CMDQ_PRODUCERS; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("Applied %u commands in %u batches, max batch %u, max depth %u\n", (unsigned)stats.applied, (unsigned)stats.batches,
+           (unsigned)stats.max_batch, (unsigned)stats.max_depth);
+    TEST_ASSERT_EQUAL(expected, test_sum);
+    TEST_ASSERT_EQUAL(0, test_order_errors);
+    TEST_ASSERT_EQUAL(0, stats.depth);
+    TEST_ASSERT_LESS_OR_EQUAL(64, stats.max_depth);
+
+    lvgl_port_cmdq_delete(queue);
+}
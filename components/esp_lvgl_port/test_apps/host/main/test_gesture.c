@@ -0,0 +1,202 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include "unity.h"
+#include "esp_lvgl_port_gesture.h"
+
+static lvgl_port_gesture_point_t test_out[2 * LVGL_PORT_GESTURE_POINTS_MAX];
+
+/* Two fingers at the same distance from the center, rotated by angle (degrees) */
+static uint8_t test_two_fingers(lvgl_port_gesture_tracker_t *tracker, int cx, int cy, float radius, float angle)
+{
+    const float rad = angle * 3.14159265f / 180.0f;
+    const uint16_t x[2] = {(uint16_t)lroundf(cx - radius * cosf(rad)), (uint16_t)lroundf(cx + radius * cosf(rad))};
+    const uint16_t y[2] = {(uint16_t)lroundf(cy - radius * sinf(rad)), (uint16_t)lroundf(cy + radius * sinf(rad))};
+    return lvgl_port_gesture_update(tracker, x, y, 2, test_out);
+}
+
+TEST_CASE("Touch IDs are stable while points move", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    lvgl_port_gesture_init(&tracker, NULL);
+
+    const uint16_t x1[2] = {100, 300};
+    const uint16_t y1[2] = {100, 100};
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, x1, y1, 2, test_out));
+    const uint8_t id_a = test_out[0].id;
+    const uint8_t id_b = test_out[1].id;
+    TEST_ASSERT_NOT_EQUAL(id_a, id_b);
+
+    /* Controller reports the points in other order, IDs follow positions, the older press stays first */
+    const uint16_t x2[2] = {290, 110};
+    const uint16_t y2[2] = {110, 105};
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, x2, y2, 2, test_out));
+    TEST_ASSERT_EQUAL(id_a, test_out[0].id);
+    TEST_ASSERT_EQUAL(110, test_out[0].x);
+    TEST_ASSERT_EQUAL(id_b, test_out[1].id);
+    TEST_ASSERT_EQUAL(290, test_out[1].x);
+    TEST_ASSERT_TRUE(test_out[0].pressed && test_out[1].pressed);
+
+    /* First finger released, it is reported once with its last position */
+    const uint16_t x3[1] = {280};
+    const uint16_t y3[1] = {120};
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, x3, y3, 1, test_out));
+    TEST_ASSERT_EQUAL(id_b, test_out[0].id);
+    TEST_ASSERT_TRUE(test_out[0].pressed);
+    TEST_ASSERT_EQUAL(id_a, test_out[1].id);
+    TEST_ASSERT_FALSE(test_out[1].pressed);
+    TEST_ASSERT_EQUAL(110, test_out[1].x);
+    TEST_ASSERT_EQUAL(105, test_out[1].y);
+
+    /* New press gets a new ID, even at the position of the released one */
+    const uint16_t x4[2] = {280, 110};
+    const uint16_t y4[2] = {120, 105};
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, x4, y4, 2, test_out));
+    TEST_ASSERT_EQUAL(id_b, test_out[0].id);
+    TEST_ASSERT_NOT_EQUAL(id_a, test_out[1].id);
+    TEST_ASSERT_NOT_EQUAL(id_b, test_out[1].id);
+
+    /* All released */
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, NULL, NULL, 0, test_out));
+    TEST_ASSERT_FALSE(test_out[0].pressed || test_out[1].pressed);
+    TEST_ASSERT_EQUAL(0, lvgl_port_gesture_update(&tracker, NULL, NULL, 0, test_out));
+}
+
+TEST_CASE("Touch point jumping over track distance gets new ID", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    const lvgl_port_gesture_cfg_t cfg = {
+        .track_dist = 50,
+        .pinch_permille = 100,
+        .rotate_decideg = 100,
+        .scroll_dist = 20,
+    };
+    lvgl_port_gesture_init(&tracker, &cfg);
+
+    uint16_t x = 10;
+    uint16_t y = 10;
+    TEST_ASSERT_EQUAL(1, lvgl_port_gesture_update(&tracker, &x, &y, 1, test_out));
+    const uint8_t id = test_out[0].id;
+
+    x = 40;
+    y = 50;
+    TEST_ASSERT_EQUAL(1, lvgl_port_gesture_update(&tracker, &x, &y, 1, test_out));
+    TEST_ASSERT_EQUAL(id, test_out[0].id);
+
+    x = 200;
+    TEST_ASSERT_EQUAL(2, lvgl_port_gesture_update(&tracker, &x, &y, 1, test_out));
+    TEST_ASSERT_TRUE(test_out[0].pressed);
+    TEST_ASSERT_NOT_EQUAL(id, test_out[0].id);
+    TEST_ASSERT_FALSE(test_out[1].pressed);
+    TEST_ASSERT_EQUAL(id, test_out[1].id);
+}
+
+TEST_CASE("Touch IDs are unique with all points", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    uint16_t x[LVGL_PORT_GESTURE_POINTS_MAX + 2];
+    uint16_t y[LVGL_PORT_GESTURE_POINTS_MAX + 2];
+    lvgl_port_gesture_init(&tracker, NULL);
+
+    /* Every read moves all points far away, all are released and pressed again many times (ID wraps) */
+    for (int r = 0; r < 100; r++) {
+        for (int i = 0; i < LVGL_PORT_GESTURE_POINTS_MAX + 2; i++) {
+            x[i] = (uint16_t)(i * 100 + (r & 1) * 1000);
+            y[i] = 10;
+        }
+        const uint8_t n = lvgl_port_gesture_update(&tracker, x, y, LVGL_PORT_GESTURE_POINTS_MAX + 2, test_out);
+        TEST_ASSERT_EQUAL((r == 0 ? 1 : 2) * LVGL_PORT_GESTURE_POINTS_MAX, n);
+        for (int i = 0; i < n; i++) {
+            for (int j = i + 1; j < n; j++) {
+                TEST_ASSERT_NOT_EQUAL(test_out[i].id, test_out[j].id);
+            }
+        }
+    }
+}
+
+TEST_CASE("Two-finger pinch", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    lvgl_port_gesture_init(&tracker, NULL);
+
+    test_two_fingers(&tracker, 240, 160, 50, 0);
+    TEST_ASSERT_TRUE(tracker.gesture.active);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.recognized);
+
+    /* 5 % is under threshold */
+    for (int r = 51; r <= 100; r++) {
+        test_two_fingers(&tracker, 240, 160, (float)r, 0);
+        if (r == 52) {
+            TEST_ASSERT_EQUAL(0, tracker.gesture.recognized);
+        }
+    }
+    TEST_ASSERT_TRUE(tracker.gesture.active);
+    TEST_ASSERT_EQUAL(LVGL_PORT_GESTURE_PINCH, tracker.gesture.recognized);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 2.0f, tracker.gesture.scale);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 0.0f, tracker.gesture.rotation);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.scroll_x);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.scroll_y);
+
+    /* Pinch in */
+    for (int r = 100; r >= 25; r--) {
+        test_two_fingers(&tracker, 240, 160, (float)r, 0);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.5f, tracker.gesture.scale);
+
+    /* Release of one finger ends the gesture, the last values are kept */
+    const uint16_t x = 215;
+    const uint16_t y = 160;
+    lvgl_port_gesture_update(&tracker, &x, &y, 1, test_out);
+    TEST_ASSERT_FALSE(tracker.gesture.active);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 0.5f, tracker.gesture.scale);
+}
+
+TEST_CASE("Two-finger rotate", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    lvgl_port_gesture_init(&tracker, NULL);
+
+    /* Rotation over +-180 degrees continues in the other direction */
+    for (int a = 0; a <= 200; a += 5) {
+        test_two_fingers(&tracker, 240, 160, 80, (float)a);
+        if (a == 90) {
+            TEST_ASSERT_FLOAT_WITHIN(1.0f, 90.0f, tracker.gesture.rotation);
+        }
+    }
+    TEST_ASSERT_TRUE(tracker.gesture.active);
+    TEST_ASSERT_EQUAL(LVGL_PORT_GESTURE_ROTATE, tracker.gesture.recognized);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, -160.0f, tracker.gesture.rotation);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 1.0f, tracker.gesture.scale);
+}
+
+TEST_CASE("Two-finger scroll", "[gesture]")
+{
+    lvgl_port_gesture_tracker_t tracker;
+    lvgl_port_gesture_init(&tracker, NULL);
+
+    for (int d = 0; d <= 60; d += 3) {
+        test_two_fingers(&tracker, 240, 100 + d, 40, 0);
+        if (d == 15) {
+            TEST_ASSERT_EQUAL(0, tracker.gesture.recognized);
+        }
+    }
+    TEST_ASSERT_EQUAL(LVGL_PORT_GESTURE_SCROLL, tracker.gesture.recognized);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.scroll_x);
+    TEST_ASSERT_EQUAL(60, tracker.gesture.scroll_y);
+    TEST_ASSERT_EQUAL(160, tracker.gesture.center_y);
+
+    /* Third finger ends the gesture, after its release a new gesture starts from zero */
+    const uint16_t x3[3] = {200, 280, 10};
+    const uint16_t y3[3] = {160, 160, 10};
+    lvgl_port_gesture_update(&tracker, x3, y3, 3, test_out);
+    TEST_ASSERT_FALSE(tracker.gesture.active);
+    lvgl_port_gesture_update(&tracker, x3, y3, 2, test_out);
+    TEST_ASSERT_TRUE(tracker.gesture.active);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.recognized);
+    TEST_ASSERT_EQUAL(0, tracker.gesture.scroll_y);
+}
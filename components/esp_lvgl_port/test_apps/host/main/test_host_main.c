@@ -0,0 +1,17 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+
+void app_main(void)
+{
+    printf("TEST ESP LVGL port (host)\n\r");
+    UNITY_BEGIN();
+    unity_run_all_tests();
+    exit(UNITY_END());
+}
@@ -0,0 +1,237 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "unity.h"
+#include "esp_lvgl_port_mono.h"
+#include "test_host.h"
+
+#define TEST_MONO_BENCH_LOOPS   (200)
+
+/* Previous per-pixel implementation (address and bit computed for every pixel) */
+static void test_mono_legacy(uint8_t *dst, const uint16_t *src, uint32_t w, uint32_t h, bool swap_xy)
+{
+    uint32_t res;
+    uint32_t out_x, out_y;
+
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            bool chroma_color = LVGL_PORT_MONO_RGB565_LIGHT(src[w * y + x]);
+
+            if (swap_xy) {
+                out_x = y;
+                out_y = x;
+                res = h;
+            } else {
+                out_x = x;
+                out_y = y;
+                res = w;
+            }
+
+            uint8_t *buf = dst + res * (out_y >> 3) + out_x;
+            if (chroma_color) {
+                (*buf) &= ~(1 << (out_y % 8));
+            } else {
+                (*buf) |= (1 << (out_y % 8));
+            }
+        }
+    }
+}
+
+/* Reference of I1 conversion, pixel by pixel */
+static void test_mono_i1_ref(uint8_t *dst, const uint8_t *src, uint32_t stride, uint32_t w, uint32_t h, bool swap_xy)
+{
+    memset(dst, 0, swap_xy ? lvgl_port_mono_pages_size(h, w) : lvgl_port_mono_pages_size(w, h));
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            const bool light = (src[y * stride + x / 8] >> (7 - x % 8)) & 1;
+            const uint32_t out_x = (swap_xy ? y : x);
+            const uint32_t out_y = (swap_xy ? x : y);
+            const uint32_t res = (swap_xy ? h : w);
+            if (!light) {
+                dst[res * (out_y >> 3) + out_x] |= (1 << (out_y % 8));
+            }
+        }
+    }
+}
+
+static void test_mono_fill(uint16_t *src, uint32_t len, uint32_t seed)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        seed = seed * 1103515245 + 12345;
+        src[i] = (uint16_t)(seed >> 8);
+    }
+}
+
+static void test_mono_compare(uint32_t w, uint32_t h)
+{
+    const uint32_t size = lvgl_port_mono_pages_size(w, h);
+    const uint32_t size_xy = lvgl_port_mono_pages_size(h, w);
+    uint16_t *src = malloc(w * h * sizeof(uint16_t));
+    uint8_t *ref = calloc(1, size_xy > size ? size_xy : size);
+    uint8_t *out = calloc(1, size_xy > size ? size_xy : size);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+
+    test_mono_fill(src, w * h, w * 31 + h);
+
+    test_mono_legacy(ref, src, w, h, false);
+    lvgl_port_mono_rgb565_to_pages(out, src, w, h);
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, size);
+
+    memset(ref, 0, size_xy);
+    test_mono_legacy(ref, src, w, h, true);
+    lvgl_port_mono_rgb565_to_pages_swap_xy(out, src, w, h);
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, size_xy);
+
+    free(src);
+    free(ref);
+    free(out);
+}
+
+TEST_CASE("Mono pages match previous implementation", "[mono]")
+{
+    test_mono_compare(128, 64);
+    test_mono_compare(128, 32);
+    test_mono_compare(64, 128);
+    /* Sizes not aligned to page */
+    test_mono_compare(13, 21);
+    test_mono_compare(1, 1);
+    test_mono_compare(7, 9);
+}
+
+static void test_mono_i1_compare(uint32_t w, uint32_t h, uint32_t stride)
+{
+    const uint32_t size = (lvgl_port_mono_pages_size(w, h) > lvgl_port_mono_pages_size(h, w) ? lvgl_port_mono_pages_size(w, h) : lvgl_port_mono_pages_size(h, w));
+    uint8_t *src = malloc(stride * h);
+    uint8_t *ref = malloc(size);
+    uint8_t *out = malloc(size);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+
+    test_mono_fill((uint16_t *)src, stride * h / 2, w * 17 + h);
+
+    test_mono_i1_ref(ref, src, stride, w, h, false);
+    lvgl_port_mono_i1_to_pages(out, src, stride, w, h);
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, lvgl_port_mono_pages_size(w, h));
+
+    test_mono_i1_ref(ref, src, stride, w, h, true);
+    lvgl_port_mono_i1_to_pages_swap_xy(out, src, stride, w, h);
+    TEST_ASSERT_EQUAL_MEMORY(ref, out, lvgl_port_mono_pages_size(h, w));
+
+    free(src);
+    free(ref);
+    free(out);
+}
+
+TEST_CASE("Mono pages from I1 match reference", "[mono]")
+{
+    test_mono_i1_compare(128, 64, 16);
+    test_mono_i1_compare(64, 128, 8);
+    test_mono_i1_compare(128, 16, 16);
+    /* Sizes not aligned to page and stride with padding */
+    test_mono_i1_compare(13, 21, 2);
+    test_mono_i1_compare(13, 21, 4);
+    test_mono_i1_compare(1, 1, 1);
+    test_mono_i1_compare(72, 40, 12);
+}
+
+TEST_CASE("Mono pages bit order", "[mono]")
+{
+    uint16_t src[2 * 9];
+    uint8_t out[2 * 2];
+
+    /* White everywhere except pixel [1, 0] and [0, 8] */
+    for (uint32_t i = 0; i < 2 * 9; i++) {
+        src[i] = 0xFFFF;
+    }
+    src[1] = 0x0000;
+    src[2 * 8] = 0x0000;
+
+    lvgl_port_mono_rgb565_to_pages(out, src, 2, 9);
+    TEST_ASSERT_EQUAL(0x00, out[0]);
+    TEST_ASSERT_EQUAL(0x01, out[1]);
+    TEST_ASSERT_EQUAL(0x01, out[2]);
+    TEST_ASSERT_EQUAL(0x00, out[3]);
+}
+
+TEST_CASE("Mono pages from I1 bit order", "[mono]")
+{
+    /* 9 columns, 2 lines, all light except pixel [8, 0] and [0, 1] */
+    const uint8_t src[] = {0xFF, 0x7F, 0x7F, 0xFF};
+    uint8_t out[9 * 2];
+
+    lvgl_port_mono_i1_to_pages(out, src, 2, 9, 2);
+    TEST_ASSERT_EQUAL(0x02, out[0]);
+    TEST_ASSERT_EQUAL(0x00, out[1]);
+    TEST_ASSERT_EQUAL(0x01, out[8]);
+
+    /* Destination is 2 wide, column 0 of page 0 contains source line 0 */
+    lvgl_port_mono_i1_to_pages_swap_xy(out, src, 2, 9, 2);
+    TEST_ASSERT_EQUAL(0x00, out[0]);
+    TEST_ASSERT_EQUAL(0x01, out[1]);
+    TEST_ASSERT_EQUAL(0x01, out[2]);
+    TEST_ASSERT_EQUAL(0x00, out[3]);
+}
+
+TEST_CASE("Mono pages benchmark", "[mono][benchmark]")
+{
+    const uint32_t sizes[][2] = {{128, 64}, {128, 32}, {64, 128}, {200, 200}};
+
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const uint32_t w = sizes[s][0];
+        const uint32_t h = sizes[s][1];
+        uint16_t *src = malloc(w * h * sizeof(uint16_t));
+        uint8_t *dst = calloc(1, lvgl_port_mono_pages_size(w > h ? w : h, w > h ? w : h));
+        TEST_ASSERT_NOT_NULL(src);
+        TEST_ASSERT_NOT_NULL(dst);
+        test_mono_fill(src, w * h, 1);
+
+        for (uint32_t swap_xy = 0; swap_xy < 2; swap_xy++) {
+            int64_t start = test_host_time_us();
+            for (uint32_t i = 0; i < TEST_MONO_BENCH_LOOPS; i++) {
+                test_mono_legacy(dst, src, w, h, swap_xy);
+            }
+            const int64_t legacy_us = test_host_time_us() - start;
+
+            start = test_host_time_us();
+            for (uint32_t i = 0; i < TEST_MONO_BENCH_LOOPS; i++) {
+                if (swap_xy) {
+                    lvgl_port_mono_rgb565_to_pages_swap_xy(dst, src, w, h);
+                } else {
+                    lvgl_port_mono_rgb565_to_pages(dst, src, w, h);
+                }
+            }
+            const int64_t new_us = test_host_time_us() - start;
+
+            /* Same area rendered by LVGL in I1 format */
+            const uint32_t stride = (w + 7) / 8;
+            start = test_host_time_us();
+            for (uint32_t i = 0; i < TEST_MONO_BENCH_LOOPS; i++) {
+                if (swap_xy) {
+                    lvgl_port_mono_i1_to_pages_swap_xy(dst, (const uint8_t *)src, stride, w, h);
+                } else {
+                    lvgl_port_mono_i1_to_pages(dst, (const uint8_t *)src, stride, w, h);
+                }
+            }
+            const int64_t i1_us = test_host_time_us() - start;
+
+            printf("%3ux%-3u %s: previous %6.2f us, pages %6.2f us (x%.1f), I1 %6.2f us (x%.1f), draw buffer %6u B -> %5u B\n",
+                   (unsigned)w, (unsigned)h, swap_xy ? "swap_xy" : "normal ", (double)legacy_us / TEST_MONO_BENCH_LOOPS,
+                   (double)new_us / TEST_MONO_BENCH_LOOPS, new_us ? (double)legacy_us / new_us : 0.0,
+                   (double)i1_us / TEST_MONO_BENCH_LOOPS, i1_us ? (double)legacy_us / i1_us : 0.0,
+                   (unsigned)(w * h * sizeof(uint16_t)), (unsigned)(stride * h + 8));
+        }
+
+        free(src);
+        free(dst);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_rotate.h"
+#include "test_host.h"
+
+#define TEST_ROTATE_BENCH_LOOPS   (50)
+
+/* Reference rotation, pixel by pixel (same as lv_draw_sw_rotate) */
+static void test_rotate_ref(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t px_size)
+{
+    for (uint32_t y = 0; y < h; y++) {
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t dx = x;
+            uint32_t dy = y;
+            uint32_t dst_w = w;
+            switch (rotation) {
+            case LVGL_PORT_ROTATE_90:
+                dx = y;
+                dy = w - 1 - x;
+                dst_w = h;
+                break;
+            case LVGL_PORT_ROTATE_180:
+                dx = w - 1 - x;
+                dy = h - 1 - y;
+                break;
+            case LVGL_PORT_ROTATE_270:
+                dx = h - 1 - y;
+                dy = x;
+                dst_w = h;
+                break;
+            default:
+                break;
+            }
+            memcpy(dst + (dy * dst_w + dx) * px_size, src + (y * w + x) * px_size, px_size);
+        }
+    }
+}
+
+static void test_rotate_run(uint8_t *dst, const uint8_t *src, uint32_t w, uint32_t h, lvgl_port_rotate_t rotation, uint32_t px_size, uint32_t tile)
+{
+    switch (px_size) {
+    case 2:
+        lvgl_port_rotate_rgb565((uint16_t *)dst, (const uint16_t *)src, w, h, rotation, tile);
+        break;
+    case 3:
+        lvgl_port_rotate_rgb888(dst, src, w, h, rotation, tile);
+        break;
+    default:
+        lvgl_port_rotate_argb8888((uint32_t *)dst, (const uint32_t *)src, w, h, rotation, tile);
+        break;
+    }
+}
+
+static void test_rotate_compare(uint32_t w, uint32_t h, uint32_t px_size, uint32_t tile)
+{
+    const uint32_t size = w * h * px_size;
+    uint8_t *src = malloc(size);
+    uint8_t *ref = malloc(size);
+    uint8_t *out = malloc(size);
+    TEST_ASSERT_NOT_NULL(src);
+    TEST_ASSERT_NOT_NULL(ref);
+    TEST_ASSERT_NOT_NULL(out);
+
+    for (uint32_t i = 0; i < size; i++) {
+        src[i] = (uint8_t)(i * 7 + i / 251);
+    }
+
+    for (int r = LVGL_PORT_ROTATE_0; r <= LVGL_PORT_ROTATE_270; r++) {
+        test_rotate_ref(ref, src, w, h, r, px_size);
+        memset(out, 0, size);
+        test_rotate_run(out, src, w, h, r, px_size, tile);
+        TEST_ASSERT_EQUAL_MEMORY(ref, out, size);
+    }
+
+    free(src);
+    free(ref);
+    free(out);
+}
+
+TEST_CASE("Rotate matches reference", "[rotate]")
+{
+    const uint32_t tiles[] = {0, 1, 7, 16, 32, 1000};
+
+    for (uint32_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+        for (uint32_t px_size = 2; px_size <= 4; px_size++) {
+            test_rotate_compare(64, 48, px_size, tiles[t]);
+            test_rotate_compare(37, 11, px_size, tiles[t]);
+            test_rotate_compare(1, 13, px_size, tiles[t]);
+        }
+    }
+}
+
+TEST_CASE("Rotate area coordinates", "[rotate]")
+{
+    /* Rotated screen 320x240, not rotated 240x320 for 90 and 270 */
+    lvgl_port_area_t area = {10, 20, 49, 29};
+
+    lvgl_port_rotate_area(&area, 320, 240, LVGL_PORT_ROTATE_90);
+    TEST_ASSERT_EQUAL(20, area.x1);
+    TEST_ASSERT_EQUAL(29, area.x2);
+    TEST_ASSERT_EQUAL(270, area.y1);
+    TEST_ASSERT_EQUAL(309, area.y2);
+
+    area = (lvgl_port_area_t) {10, 20, 49, 29};
+    lvgl_port_rotate_area(&area, 320, 240, LVGL_PORT_ROTATE_180);
+    TEST_ASSERT_EQUAL(270, area.x1);
+    TEST_ASSERT_EQUAL(309, area.x2);
+    TEST_ASSERT_EQUAL(210, area.y1);
+    TEST_ASSERT_EQUAL(219, area.y2);
+
+    area = (lvgl_port_area_t) {10, 20, 49, 29};
+    lvgl_port_rotate_area(&area, 320, 240, LVGL_PORT_ROTATE_270);
+    TEST_ASSERT_EQUAL(210, area.x1);
+    TEST_ASSERT_EQUAL(219, area.x2);
+    TEST_ASSERT_EQUAL(10, area.y1);
+    TEST_ASSERT_EQUAL(49, area.y2);
+}
+
+TEST_CASE("Rotate benchmark of tile sizes", "[rotate][benchmark]")
+{
+    /* Tile 0xFFFF means no tiling (whole area in one tile) */
+    const uint32_t tiles[] = {0xFFFF, 8, 16, 32, 64, 128};
+    const uint32_t sizes[][2] = {{320, 240}, {480, 80}, {800, 480}};
+
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        const uint32_t w = sizes[s][0];
+        const uint32_t h = sizes[s][1];
+        for (uint32_t px_size = 2; px_size <= 3; px_size++) {
+            uint8_t *src = calloc(w * h, px_size);
+            uint8_t *dst = calloc(w * h, px_size);
+            TEST_ASSERT_NOT_NULL(src);
+            TEST_ASSERT_NOT_NULL(dst);
+
+            printf("%ux%u %s 90deg:", (unsigned)w, (unsigned)h, px_size == 2 ? "RGB565" : "RGB888");
+            for (uint32_t t = 0; t < sizeof(tiles) / sizeof(tiles[0]); t++) {
+                const int64_t start = test_host_time_us();
+                for (uint32_t i = 0; i < TEST_ROTATE_BENCH_LOOPS; i++) {
+                    test_rotate_run(dst, src, w, h, LVGL_PORT_ROTATE_90, px_size, tiles[t]);
+                }
+                const int64_t time_us = test_host_time_us() - start;
+                if (tiles[t] == 0xFFFF) {
+                    printf(" untiled %6.1f us", (double)time_us / TEST_ROTATE_BENCH_LOOPS);
+                } else {
+                    printf(", tile %3u %6.1f us", (unsigned)tiles[t], (double)time_us / TEST_ROTATE_BENCH_LOOPS);
+                }
+            }
+            printf("\n");
+
+            free(src);
+            free(dst);
+        }
+    }
+}
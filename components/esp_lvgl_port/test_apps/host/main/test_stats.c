@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_stats.h"
+
+TEST_CASE("Stats latency histogram buckets", "[stats]")
+{
+    lvgl_port_disp_stats_t stats = {0};
+
+    lvgl_port_stats_add_latency(&stats, 0);
+    lvgl_port_stats_add_latency(&stats, 999);
+    lvgl_port_stats_add_latency(&stats, 1000);
+    lvgl_port_stats_add_latency(&stats, 16000);
+    lvgl_port_stats_add_latency(&stats, 63999);
+    lvgl_port_stats_add_latency(&stats, 64000);
+    lvgl_port_stats_add_latency(&stats, 5000000);
+
+    TEST_ASSERT_EQUAL(2, stats.latency_hist[0]);
+    TEST_ASSERT_EQUAL(1, stats.latency_hist[1]);
+    TEST_ASSERT_EQUAL(1, stats.latency_hist[5]);
+    TEST_ASSERT_EQUAL(1, stats.latency_hist[6]);
+    TEST_ASSERT_EQUAL(2, stats.latency_hist[7]);
+    TEST_ASSERT_EQUAL(5000000, stats.latency_max_us);
+    TEST_ASSERT_EQUAL(0 + 999 + 1000 + 16000 + 63999 + 64000 + 5000000, stats.latency_sum_us);
+}
+
+TEST_CASE("Stats compact log line", "[stats]")
+{
+    lvgl_port_disp_stats_t stats = {
+        .elapsed_us = 4000000,
+        .frames = 120,
+        .areas = 300,
+        .pixels = 120 * 4800,
+        .bytes = 120 * 4800 * 2,
+        .render_us = 120 * 7250,
+        .flush_wait_us = 120 * 1100,
+        .bus_busy_us = 1600000,
+    };
+    char line[192];
+
+    lvgl_port_stats_add_latency(&stats, 10000);
+    lvgl_port_stats_add_latency(&stats, 14800);
+
+    const int len = lvgl_port_stats_format(&stats, line, sizeof(line));
+    printf("%s\n", line);
+    TEST_ASSERT_LESS_THAN(sizeof(line), len);
+    TEST_ASSERT_EQUAL_STRING("frames 120 (30.0 fps), areas 2.5/frame, px 4800/frame, render 7.3 ms/frame, wait 1.1 ms/frame, "
+                             "bus 0.7 MB/s (40% busy), latency avg 12.4 ms max 14.8 ms, hist 0 0 0 0 2 0 0 0", line);
+}
+
+TEST_CASE("Stats empty line", "[stats]")
+{
+    const lvgl_port_disp_stats_t stats = {0};
+    char line[192];
+
+    lvgl_port_stats_format(&stats, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("frames 0 (0.0 fps), areas 0.0/frame, px 0/frame, render 0.0 ms/frame, wait 0.0 ms/frame, "
+                             "bus 0.0 MB/s (0% busy), latency avg 0.0 ms max 0.0 ms, hist 0 0 0 0 0 0 0 0", line);
+}
+
+TEST_CASE("Stats lock tasks and starving", "[stats]")
+{
+    static lvgl_port_lock_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+
+    const int lvgl = lvgl_port_lock_stats_task(&stats, (const void *)1, "LVGL task");
+    const int sensor = lvgl_port_lock_stats_task(&stats, (const void *)2, "sensor");
+    TEST_ASSERT_EQUAL(0, lvgl);
+    TEST_ASSERT_EQUAL(1, sensor);
+    TEST_ASSERT_EQUAL(sensor, lvgl_port_lock_stats_task(&stats, (const void *)2, "sensor"));
+
+    /* Sensor holds the lock for 30 ms, LVGL task waits for it */
+    lvgl_port_lock_stats_add_hold(&stats, sensor, 30000, (const void *)0x1234);
+    lvgl_port_lock_stats_add_hold(&stats, sensor, 5000, (const void *)0x5678);
+    lvgl_port_lock_stats_add_wait(&stats, lvgl, 25000, true, sensor, true);
+    lvgl_port_lock_stats_add_hold(&stats, lvgl, 10000, (const void *)0x9abc);
+    /* Sensor waits for LVGL task and times out, it is not starving */
+    lvgl_port_lock_stats_add_wait(&stats, sensor, 8000, false, lvgl, false);
+
+    TEST_ASSERT_EQUAL(2, stats.tasks[sensor].locks);
+    TEST_ASSERT_EQUAL(35000, stats.tasks[sensor].hold_us);
+    TEST_ASSERT_EQUAL(30000, stats.tasks[sensor].hold_max_us);
+    TEST_ASSERT_EQUAL_PTR((const void *)0x1234, stats.tasks[sensor].hold_max_caller);
+    TEST_ASSERT_EQUAL(1, stats.tasks[sensor].waits);
+    TEST_ASSERT_EQUAL(1, stats.tasks[sensor].timeouts);
+    TEST_ASSERT_EQUAL(1, stats.tasks[sensor].starved);
+    TEST_ASSERT_EQUAL(25000, stats.tasks[sensor].starved_us);
+    TEST_ASSERT_EQUAL(0, stats.tasks[lvgl].starved);
+    TEST_ASSERT_EQUAL(1, stats.starved);
+    TEST_ASSERT_EQUAL(25000, stats.starved_us);
+
+    /* Table full */
+    for (int i = 2; i < LVGL_PORT_LOCK_STATS_TASKS; i++) {
+        TEST_ASSERT_EQUAL(i, lvgl_port_lock_stats_task(&stats, &stats.tasks[i], "other"));
+    }
+    TEST_ASSERT_EQUAL(-1, lvgl_port_lock_stats_task(&stats, (const void *)100, "mqtt"));
+    TEST_ASSERT_EQUAL(1, stats.dropped);
+    lvgl_port_lock_stats_add_hold(&stats, -1, 1000, NULL);
+    lvgl_port_lock_stats_add_wait(&stats, -1, 1000, true, -1, false);
+}
+
+TEST_CASE("Stats lock ranking and line", "[stats]")
+{
+    static lvgl_port_lock_stats_t stats;
+    memset(&stats, 0, sizeof(stats));
+    char line[160];
+
+    const int lvgl = lvgl_port_lock_stats_task(&stats, (const void *)1, "LVGL task");
+    const int mqtt = lvgl_port_lock_stats_task(&stats, (const void *)2, "mqtt");
+    const int sensor = lvgl_port_lock_stats_task(&stats, (const void *)3, "sensor");
+
+    lvgl_port_lock_stats_add_hold(&stats, lvgl, 500000, NULL);
+    lvgl_port_lock_stats_add_hold(&stats, mqtt, 100000, (const void *)0x42001234);
+    lvgl_port_lock_stats_add_hold(&stats, sensor, 20000, NULL);
+    lvgl_port_lock_stats_add_wait(&stats, lvgl, 15000, true, sensor, true);
+    lvgl_port_lock_stats_add_wait(&stats, mqtt, 1200, true, lvgl, false);
+
+    lvgl_port_lock_stats_sort(&stats);
+    TEST_ASSERT_EQUAL_STRING("sensor", stats.tasks[0].name);
+    TEST_ASSERT_EQUAL_STRING("LVGL task", stats.tasks[1].name);
+    TEST_ASSERT_EQUAL_STRING("mqtt", stats.tasks[2].name);
+
+    const int len = lvgl_port_lock_stats_format(&stats.tasks[2], 1000000, line, sizeof(line));
+    printf("%s\n", line);
+    TEST_ASSERT_LESS_THAN(sizeof(line), len);
+    TEST_ASSERT_EQUAL_STRING("mqtt: locks 1, wait 1.2 ms (max 1.2 ms, 0 timeouts), hold 100.0 ms (10%, max 100.0 ms at 0x42001234), "
+                             "starved LVGL 0 times 0.0 ms", line);
+}
@@ -0,0 +1,111 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_swap.h"
+#include "test_host.h"
+
+#define TEST_SWAP_BENCH_PX      (320 * 48)
+#define TEST_SWAP_BENCH_LOOPS   (200)
+
+/* Reference implementation (one pixel per operation) */
+static void test_swap_ref(uint16_t *dst, const uint16_t *src, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        dst[i] = (uint16_t)((src[i] << 8) | (src[i] >> 8));
+    }
+}
+
+static void test_fill_pattern(uint16_t *buf, uint32_t len)
+{
+    for (uint32_t i = 0; i < len; i++) {
+        buf[i] = (uint16_t)(i * 0x1F3D + 0x0102);
+    }
+}
+
+TEST_CASE("RGB565 swap matches reference (alignment and length)", "[swap]")
+{
+    uint16_t src[80];
+    uint16_t dst[80];
+    uint16_t ref[80];
+
+    for (uint32_t src_off = 0; src_off < 2; src_off++) {
+        for (uint32_t dst_off = 0; dst_off < 2; dst_off++) {
+            for (uint32_t len = 0; len < 70; len++) {
+                test_fill_pattern(src, 80);
+                memset(dst, 0xAA, sizeof(dst));
+                memset(ref, 0xAA, sizeof(ref));
+
+                lvgl_port_rgb565_swap(dst + dst_off, src + src_off, len);
+                test_swap_ref(ref + dst_off, src + src_off, len);
+                /* Pixels around must not be touched */
+                TEST_ASSERT_EQUAL_MEMORY(ref, dst, sizeof(dst));
+            }
+        }
+    }
+}
+
+TEST_CASE("RGB565 swap in place", "[swap]")
+{
+    uint16_t buf[67];
+    uint16_t ref[67];
+
+    for (uint32_t off = 0; off < 2; off++) {
+        test_fill_pattern(buf, 67);
+        test_fill_pattern(ref, 67);
+        lvgl_port_rgb565_swap(buf + off, buf + off, 67 - off);
+        test_swap_ref(ref + off, ref + off, 67 - off);
+        TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+
+        /* Swap twice returns original data */
+        lvgl_port_rgb565_swap(buf + off, buf + off, 67 - off);
+        test_fill_pattern(ref, 67);
+        TEST_ASSERT_EQUAL_MEMORY(ref, buf, sizeof(buf));
+    }
+}
+
+TEST_CASE("RGB565 swap benchmark", "[swap][benchmark]")
+{
+    uint16_t *buf = malloc(TEST_SWAP_BENCH_PX * sizeof(uint16_t));
+    uint16_t *copy = malloc(TEST_SWAP_BENCH_PX * sizeof(uint16_t));
+    TEST_ASSERT_NOT_NULL(buf);
+    TEST_ASSERT_NOT_NULL(copy);
+    test_fill_pattern(buf, TEST_SWAP_BENCH_PX);
+
+    int64_t start = test_host_time_us();
+    for (int i = 0; i < TEST_SWAP_BENCH_LOOPS; i++) {
+        test_swap_ref(buf, buf, TEST_SWAP_BENCH_PX);
+    }
+    const int64_t ref_us = test_host_time_us() - start;
+
+    start = test_host_time_us();
+    for (int i = 0; i < TEST_SWAP_BENCH_LOOPS; i++) {
+        lvgl_port_rgb565_swap(buf, buf, TEST_SWAP_BENCH_PX);
+    }
+    const int64_t port_us = test_host_time_us() - start;
+
+    printf("RGB565 swap %d px x %d: reference %lld us, port %lld us\n", TEST_SWAP_BENCH_PX, TEST_SWAP_BENCH_LOOPS, (long long)ref_us, (long long)port_us);
+
+    /* Flush swaps into transport buffer or transmit FIFO */
+    start = test_host_time_us();
+    for (int i = 0; i < TEST_SWAP_BENCH_LOOPS; i++) {
+        test_swap_ref(copy, buf, TEST_SWAP_BENCH_PX);
+    }
+    const int64_t ref_copy_us = test_host_time_us() - start;
+
+    start = test_host_time_us();
+    for (int i = 0; i < TEST_SWAP_BENCH_LOOPS; i++) {
+        lvgl_port_rgb565_swap(copy, buf, TEST_SWAP_BENCH_PX);
+    }
+    const int64_t port_copy_us = test_host_time_us() - start;
+
+    printf("RGB565 swap copy %d px x %d: reference %lld us, port %lld us\n", TEST_SWAP_BENCH_PX, TEST_SWAP_BENCH_LOOPS, (long long)ref_copy_us, (long long)port_copy_us);
+    free(copy);
+    free(buf);
+}
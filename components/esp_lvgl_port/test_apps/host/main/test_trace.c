@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_tracebuf.h"
+
+TEST_CASE("Trace ring keeps the newest records", "[trace]")
+{
+    /* Rounded up to power of two */
+    TEST_ASSERT_EQUAL(lvgl_port_trace_ring_size(8), lvgl_port_trace_ring_size(5));
+    void *mem = malloc(lvgl_port_trace_ring_size(5));
+    TEST_ASSERT_NOT_NULL(mem);
+    lvgl_port_trace_ring_t *ring = lvgl_port_trace_ring_init(mem, 5);
+
+    uint32_t count;
+    TEST_ASSERT_EQUAL(0, lvgl_port_trace_ring_first(ring, &count));
+    TEST_ASSERT_EQUAL(0, count);
+
+    for (uint32_t i = 0; i < 3; i++) {
+        lvgl_port_trace_ring_put(ring, 100 + i, 1, LVGL_PORT_TRACE_EVENT, LVGL_PORT_TRACE_INSTANT, i, 0);
+    }
+    TEST_ASSERT_EQUAL(0, lvgl_port_trace_ring_first(ring, &count));
+    TEST_ASSERT_EQUAL(3, count);
+
+    /* Oldest records are overwritten */
+    for (uint32_t i = 3; i < 20; i++) {
+        lvgl_port_trace_ring_put(ring, 100 + i, 1, LVGL_PORT_TRACE_EVENT, LVGL_PORT_TRACE_INSTANT, i, 0);
+    }
+    const uint32_t first = lvgl_port_trace_ring_first(ring, &count);
+    TEST_ASSERT_EQUAL(12, first);
+    TEST_ASSERT_EQUAL(8, count);
+    for (uint32_t i = 0; i < count; i++) {
+        const lvgl_port_trace_entry_t *entry = lvgl_port_trace_ring_get(ring, first + i);
+        TEST_ASSERT_EQUAL(12 + i, entry->arg0);
+        TEST_ASSERT_EQUAL(112 + i, entry->ts);
+    }
+
+    lvgl_port_trace_ring_clear(ring);
+    lvgl_port_trace_ring_first(ring, &count);
+    TEST_ASSERT_EQUAL(0, count);
+
+    free(mem);
+}
+
+TEST_CASE("Trace Chrome JSON format", "[trace]")
+{
+    char buf[256];
+    lvgl_port_trace_entry_t entry = {.ts = 1500, .tid = 42, .event = LVGL_PORT_TRACE_TIMER_HANDLER, .phase = LVGL_PORT_TRACE_BEGIN};
+
+    /* Duration events */
+    lvgl_port_trace_format(&entry, 1000, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"lv_timer_handler\",\"cat\":\"lvgl\",\"ph\":\"B\",\"ts\":500,\"pid\":1,\"tid\":42}", buf);
+    entry.phase = LVGL_PORT_TRACE_END;
+    entry.arg0 = 33;
+    lvgl_port_trace_format(&entry, 1000, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"lv_timer_handler\",\"cat\":\"lvgl\",\"ph\":\"E\",\"ts\":500,\"pid\":1,\"tid\":42,\"args\":{\"next_ms\":33}}", buf);
+
+    /* Instant event with area, timestamp wraps */
+    entry = (lvgl_port_trace_entry_t) {
+        .ts = 10, .tid = 42, .event = LVGL_PORT_TRACE_FLUSH, .phase = LVGL_PORT_TRACE_INSTANT,
+        .arg0 = LVGL_PORT_TRACE_XY(-5, 0), .arg1 = LVGL_PORT_TRACE_XY(319, 239),
+    };
+    lvgl_port_trace_format(&entry, UINT32_MAX - 9, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"flush\",\"cat\":\"lvgl\",\"ph\":\"i\",\"s\":\"t\",\"ts\":20,\"pid\":1,\"tid\":42,\"args\":{\"x1\":-5,\"y1\":0,\"x2\":319,\"y2\":239}}", buf);
+
+    /* Not written record is skipped */
+    memset(&entry, 0, sizeof(entry));
+    TEST_ASSERT_EQUAL(0, lvgl_port_trace_format(&entry, 0, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("", buf);
+
+    lvgl_port_trace_format_thread(0, "ISR", buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"ISR\"}}", buf);
+}
@@ -0,0 +1,99 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lvgl_port_txfifo.h"
+
+#define TEST_TXFIFO_SIZE    (1000)
+#define TEST_TXFIFO_BLOCKS  (16)
+
+static uint8_t test_mem[TEST_TXFIFO_SIZE] __attribute__((aligned(LVGL_PORT_TXFIFO_ALIGN)));
+
+TEST_CASE("Transmit FIFO wraps contiguous blocks", "[txfifo]")
+{
+    lvgl_port_txfifo_t fifo;
+    lvgl_port_txfifo_init(&fifo, test_mem, sizeof(test_mem));
+
+    uint8_t *a = lvgl_port_txfifo_alloc(&fifo, 398);
+    uint8_t *b = lvgl_port_txfifo_alloc(&fifo, 400);
+    TEST_ASSERT_EQUAL_PTR(test_mem, a);
+    TEST_ASSERT_EQUAL_PTR(test_mem + 400, b);
+    TEST_ASSERT_EQUAL(800, lvgl_port_txfifo_used(&fifo));
+
+    /* 200 bytes at the end are not enough, the beginning is still used */
+    TEST_ASSERT_NULL(lvgl_port_txfifo_alloc(&fifo, 300));
+    TEST_ASSERT_NULL(lvgl_port_txfifo_alloc(&fifo, 0));
+    TEST_ASSERT_NULL(lvgl_port_txfifo_alloc(&fifo, TEST_TXFIFO_SIZE + 4));
+
+    /* Block is allocated from the beginning, the end is skipped */
+    lvgl_port_txfifo_free(&fifo, a, 398);
+    uint8_t *c = lvgl_port_txfifo_alloc(&fifo, 300);
+    TEST_ASSERT_EQUAL_PTR(test_mem, c);
+    TEST_ASSERT_EQUAL(700, lvgl_port_txfifo_used(&fifo));
+    TEST_ASSERT_EQUAL_PTR(test_mem + 300, lvgl_port_txfifo_alloc(&fifo, 100));
+    TEST_ASSERT_NULL(lvgl_port_txfifo_alloc(&fifo, 4));
+
+    /* Skipped end is free again, when the last block before it is freed */
+    lvgl_port_txfifo_free(&fifo, b, 400);
+    TEST_ASSERT_EQUAL(400, lvgl_port_txfifo_used(&fifo));
+    TEST_ASSERT_EQUAL_PTR(test_mem + 400, lvgl_port_txfifo_alloc(&fifo, 600));
+    TEST_ASSERT_EQUAL(TEST_TXFIFO_SIZE, lvgl_port_txfifo_used(&fifo));
+    TEST_ASSERT_NULL(lvgl_port_txfifo_alloc(&fifo, 4));
+}
+
+TEST_CASE("Transmit FIFO blocks never overlap", "[txfifo]")
+{
+    lvgl_port_txfifo_t fifo;
+    struct {
+        uint8_t *data;
+        uint32_t len;
+    } blocks[TEST_TXFIFO_BLOCKS];
+    uint32_t first = 0;
+    uint32_t cnt = 0;
+    uint32_t allocated = 0;
+    uint32_t used = 0;
+
+    lvgl_port_txfifo_init(&fifo, test_mem, sizeof(test_mem));
+    srand(1);
+
+    for (int i = 0; i < 100000; i++) {
+        if (cnt < TEST_TXFIFO_BLOCKS && (rand() & 1)) {
+            const uint32_t len = 1 + rand() % 500;
+            uint8_t *data = lvgl_port_txfifo_alloc(&fifo, len);
+            if (data) {
+                TEST_ASSERT_EQUAL(0, (uintptr_t)data % LVGL_PORT_TXFIFO_ALIGN);
+                TEST_ASSERT(data + len <= test_mem + TEST_TXFIFO_SIZE);
+                /* Live blocks are marked by their index, new block must cover only free memory */
+                for (uint32_t j = 0; j < len; j++) {
+                    TEST_ASSERT_EQUAL(0, data[j]);
+                }
+                memset(data, 1 + (first + cnt) % 255, len);
+                blocks[(first + cnt) % TEST_TXFIFO_BLOCKS].data = data;
+                blocks[(first + cnt) % TEST_TXFIFO_BLOCKS].len = len;
+                cnt++;
+                allocated++;
+                used += (len + LVGL_PORT_TXFIFO_ALIGN - 1) & ~(LVGL_PORT_TXFIFO_ALIGN - 1);
+            } else {
+                /* Empty FIFO must have space for any block up to its size */
+                TEST_ASSERT_GREATER_THAN(0, cnt);
+            }
+        } else if (cnt > 0) {
+            const uint32_t idx = first % TEST_TXFIFO_BLOCKS;
+            memset(blocks[idx].data, 0, blocks[idx].len);
+            lvgl_port_txfifo_free(&fifo, blocks[idx].data, blocks[idx].len);
+            used -= (blocks[idx].len + LVGL_PORT_TXFIFO_ALIGN - 1) & ~(LVGL_PORT_TXFIFO_ALIGN - 1);
+            first++;
+            cnt--;
+        }
+        TEST_ASSERT_EQUAL(used, lvgl_port_txfifo_used(&fifo));
+    }
+
+    printf("Allocated %u blocks\n", (unsigned)allocated);
+    TEST_ASSERT_GREATER_THAN(10000, allocated);
+}
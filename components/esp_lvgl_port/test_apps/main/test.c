@@ -4,10 +4,13 @@
  * SPDX-License-Identifier: CC0-1.0
  */
 
-
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_check.h"
+#include "esp_rom_sys.h"
 #include "driver/i2c.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
@@ -18,6 +21,10 @@
 
 #include "esp_lcd_touch_tt21100.h"
 
+#if LVGL_VERSION_MAJOR >= 9 && LV_USE_DEMO_BENCHMARK
+#include "demos/lv_demos.h"
+#endif
+
 #include "unity.h"
 
 /* LCD size */
@@ -180,7 +187,7 @@ static esp_err_t app_touch_deinit(void)
     return ESP_OK;
 }
 
-static esp_err_t app_lvgl_init(void)
+static esp_err_t app_lvgl_init(bool tickless)
 {
     /* Initialize LVGL */
     const lvgl_port_cfg_t lvgl_cfg = {
@@ -188,7 +195,8 @@ static esp_err_t app_lvgl_init(void)
         .task_stack = 4096,         /* LVGL task stack size */
         .task_affinity = -1,        /* LVGL task pinned to core (-1 is no affinity) */
         .task_max_sleep_ms = 500,   /* Maximum sleep in LVGL task */
-        .timer_period_ms = 5        /* LVGL timer tick period in ms */
+        .timer_period_ms = 5,       /* LVGL timer tick period in ms */
+        .tickless = tickless,       /* LVGL tick from esp_timer_get_time() */
     };
     ESP_RETURN_ON_ERROR(lvgl_port_init(&lvgl_cfg), TAG, "LVGL port initialization failed");
 
@@ -311,7 +319,7 @@ TEST_CASE("Main test LVGL port", "[lvgl port]")
     ESP_LOGI(TAG, "Initilize LVGL.");
 
     /* LVGL initialization */
-    TEST_ASSERT_EQUAL(app_lvgl_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
 
     /* Show LVGL objects */
     app_main_display();
@@ -349,6 +357,387 @@ TEST_CASE("Main test LVGL port", "[lvgl port]")
 
 }
 
+#if LVGL_VERSION_MAJOR >= 9
+TEST_CASE("Tickless LVGL port idle wakeups", "[lvgl port][tickless]")
+{
+    lvgl_port_task_stats_t stats;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(true), ESP_OK);
+
+    /* Static screen, wait until it is drawn */
+    app_main_display();
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+
+    /* Idle UI (touch in interrupt mode): LVGL task must not wake up at all */
+    TEST_ASSERT_EQUAL(lvgl_port_task_get_stats(&stats, true), ESP_OK);
+    vTaskDelay(5000 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(lvgl_port_task_get_stats(&stats, true), ESP_OK);
+    printf("Idle 5 s: passes %u, timeouts %u, events %u\n", (unsigned)stats.passes, (unsigned)stats.timeouts, (unsigned)stats.events);
+    TEST_ASSERT_EQUAL(0, stats.timeouts);
+
+    /* Invalidated screen must be still refreshed */
+    lvgl_port_lock(0);
+    lv_obj_invalidate(lv_scr_act());
+    lvgl_port_unlock();
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(lvgl_port_task_get_stats(&stats, true), ESP_OK);
+    TEST_ASSERT_GREATER_THAN(0, stats.passes);
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
+static void test_lock_holder_task(void *arg)
+{
+    volatile bool *run = (volatile bool *)arg;
+
+    /* Bad application task: holds LVGL mutex for a long time */
+    while (*run) {
+        lvgl_port_lock(0);
+        esp_rom_delay_us(30 * 1000);
+        lvgl_port_unlock();
+        vTaskDelay(1);
+    }
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("Lock statistics blame holder task", "[lvgl port][lock]")
+{
+    static lvgl_port_lock_stats_t stats;
+    volatile bool run = true;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
+    app_main_display();
+
+    TEST_ASSERT_EQUAL(lvgl_port_lock_stats_enable(true), ESP_OK);
+    xTaskCreate(test_lock_holder_task, "lock holder", 4096, (void *)&run, 4, NULL);
+    vTaskDelay(3000 / portTICK_PERIOD_MS);
+    run = false;
+    vTaskDelay(100 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(lvgl_port_lock_log_stats(false), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_lock_get_stats(&stats, true), ESP_OK);
+    TEST_ASSERT_GREATER_THAN(0, stats.starved);
+    TEST_ASSERT_EQUAL_STRING("lock holder", stats.tasks[0].name);
+    TEST_ASSERT_GREATER_OR_EQUAL(30000, stats.tasks[0].hold_max_us);
+    TEST_ASSERT_NOT_NULL(stats.tasks[0].hold_max_caller);
+    TEST_ASSERT_EQUAL(lvgl_port_lock_stats_enable(false), ESP_OK);
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+
+#if LVGL_VERSION_MAJOR >= 9
+#define TEST_CMD_PER_TASK   (500)
+
+static void test_cmd_set_value(void *user_data, const void *data, size_t len)
+{
+    lv_label_set_text_fmt((lv_obj_t *)user_data, "%d", (int) * (const uint32_t *)data);
+}
+
+static void test_cmd_producer_task(void *arg)
+{
+    lv_obj_t *label = (lv_obj_t *)arg;
+
+    for (uint32_t i = 1; i <= TEST_CMD_PER_TASK; i++) {
+        while (lvgl_port_cmd_post(test_cmd_set_value, label, &i, sizeof(i)) == ESP_ERR_NO_MEM) {
+            vTaskDelay(1);
+        }
+        lvgl_port_cmd_post_merge(1, test_cmd_set_value, label, &i, sizeof(i));
+    }
+    vTaskDelete(NULL);
+}
+
+TEST_CASE("UI command queue", "[lvgl port][cmd]")
+{
+    const lvgl_port_cmd_queue_cfg_t cmd_cfg = {
+        .queue_size = 16,
+        .merge_keys = 1,
+    };
+    lvgl_port_cmd_stats_t stats;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_cmd_queue_init(&cmd_cfg), ESP_OK);
+
+    lvgl_port_lock(0);
+    lv_obj_t *label = lv_label_create(lv_scr_act());
+    lvgl_port_unlock();
+
+    xTaskCreate(test_cmd_producer_task, "cmd producer 1", 4096, label, 3, NULL);
+    xTaskCreate(test_cmd_producer_task, "cmd producer 2", 4096, label, 3, NULL);
+    vTaskDelay(3000 / portTICK_PERIOD_MS);
+
+    TEST_ASSERT_EQUAL(lvgl_port_cmd_get_stats(&stats, false), ESP_OK);
+    printf("Commands: posted %u, applied %u, merged %u, dropped %u, batches %u (max %u), depth %u (max %u)\n",
+           (unsigned)stats.posted, (unsigned)stats.applied, (unsigned)stats.merged, (unsigned)stats.dropped,
+           (unsigned)stats.batches, (unsigned)stats.max_batch, (unsigned)stats.depth, (unsigned)stats.max_depth);
+    TEST_ASSERT_EQUAL(0, stats.depth);
+    TEST_ASSERT_EQUAL(stats.posted, stats.applied + stats.merged + stats.dropped);
+    TEST_ASSERT_GREATER_OR_EQUAL(2 * TEST_CMD_PER_TASK, stats.applied);
+    TEST_ASSERT_LESS_OR_EQUAL(16, stats.max_depth);
+
+    /* The last merged command is applied the last one */
+    lvgl_port_lock(0);
+    TEST_ASSERT_EQUAL_STRING("500", lv_label_get_text(label));
+    lvgl_port_unlock();
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+static void test_governor_anim_cb(void *var, int32_t value)
+{
+    lv_obj_set_x((lv_obj_t *)var, value);
+}
+
+TEST_CASE("Refresh governor idle and active period", "[lvgl port][governor]")
+{
+    const lvgl_port_governor_cfg_t gov_cfg = {
+        .active_period_ms = 20,
+        .idle_period_ms = 200,
+        .active_hold_ms = 500,
+        .pm_lock = true,
+    };
+    lvgl_port_governor_stats_t stats;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
+    app_main_display();
+    TEST_ASSERT_EQUAL(lvgl_port_governor_init(&gov_cfg), ESP_OK);
+
+    /* No touch, no animation */
+    vTaskDelay(1000 / portTICK_PERIOD_MS);
+    lvgl_port_lock(0);
+    TEST_ASSERT_EQUAL(200, lv_timer_get_period(lv_display_get_refr_timer(lvgl_disp)));
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, lv_obj_get_child(lv_scr_act(), 0));
+    lv_anim_set_exec_cb(&anim, test_governor_anim_cb);
+    lv_anim_set_values(&anim, 0, 100);
+    lv_anim_set_duration(&anim, 1000);
+    lv_anim_start(&anim);
+    lvgl_port_unlock();
+
+    /* Animation runs */
+    vTaskDelay(300 / portTICK_PERIOD_MS);
+    lvgl_port_lock(0);
+    TEST_ASSERT_EQUAL(20, lv_timer_get_period(lv_display_get_refr_timer(lvgl_disp)));
+    lvgl_port_unlock();
+
+    /* Back to idle after the animation */
+    vTaskDelay(1500 / portTICK_PERIOD_MS);
+    lvgl_port_lock(0);
+    TEST_ASSERT_EQUAL(200, lv_timer_get_period(lv_display_get_refr_timer(lvgl_disp)));
+    lvgl_port_unlock();
+
+    TEST_ASSERT_EQUAL(lvgl_port_governor_get_stats(&stats, true), ESP_OK);
+    printf("Governor: switches %u, active %u ms, idle %u ms, renders %u (%u ms)\n", (unsigned)stats.switches,
+           (unsigned)(stats.active_us / 1000), (unsigned)(stats.idle_us / 1000), (unsigned)stats.renders, (unsigned)(stats.render_us / 1000));
+    TEST_ASSERT_EQUAL(2, stats.switches);
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+#define TEST_TRACE_DUMP_SIZE    (32 * 1024)
+
+TEST_CASE("Trace recorder Chrome JSON dump", "[lvgl port][trace]")
+{
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_trace_start(256), ESP_OK);
+    app_main_display();
+    vTaskDelay(500 / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(lvgl_port_trace_stop(), ESP_OK);
+
+    /* Dump into memory, the console shows only the end */
+    char *dump = calloc(1, TEST_TRACE_DUMP_SIZE);
+    TEST_ASSERT_NOT_NULL(dump);
+    FILE *stream = fmemopen(dump, TEST_TRACE_DUMP_SIZE, "w");
+    TEST_ASSERT_NOT_NULL(stream);
+    TEST_ASSERT_EQUAL(lvgl_port_trace_dump(stream), ESP_OK);
+    fclose(stream);
+    printf("Trace dump %u bytes\n", (unsigned)strlen(dump));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "\"traceEvents\":["));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "\"name\":\"lv_timer_handler\""));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "\"name\":\"flush\""));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "\"name\":\"lvgl lock\""));
+    TEST_ASSERT_NOT_NULL(strstr(dump, "\n]}"));
+    free(dump);
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9
+#define TEST_TX_RUN_MS  (3000)
+
+static void test_tx_anim_cb(void *var, int32_t value)
+{
+    lv_obj_set_style_bg_color((lv_obj_t *)var, lv_color_hsv_to_rgb(value, 100, 100), 0);
+}
+
+/* The whole screen is redrawn continuously on display with or without transmit task */
+static void test_tx_run(uint32_t tx_size, lvgl_port_disp_stats_t *stats, lvgl_port_tx_stats_t *tx_stats)
+{
+    const lvgl_port_display_cfg_t disp_cfg = {
+        .io_handle = lcd_io,
+        .panel_handle = lcd_panel,
+        .buffer_size = EXAMPLE_LCD_H_RES * EXAMPLE_LCD_DRAW_BUFF_HEIGHT * sizeof(uint16_t),
+        .double_buffer = EXAMPLE_LCD_DRAW_BUFF_DOUBLE,
+        .hres = EXAMPLE_LCD_H_RES,
+        .vres = EXAMPLE_LCD_V_RES,
+        .rotation = {
+            .mirror_x = true,
+            .mirror_y = true,
+        },
+        .tx_task = {
+            .size = tx_size,
+            .affinity = -1,
+        },
+        .flags = {
+            .buff_dma = true,
+            .swap_bytes = true,
+        }
+    };
+
+    lvgl_disp = lvgl_port_add_disp(&disp_cfg);
+    TEST_ASSERT_NOT_NULL(lvgl_disp);
+    TEST_ASSERT_EQUAL(lvgl_port_disp_stats_enable(lvgl_disp, true), ESP_OK);
+
+    lvgl_port_lock(0);
+    lv_obj_t *scr = lv_display_get_screen_active(lvgl_disp);
+    lv_anim_t anim;
+    lv_anim_init(&anim);
+    lv_anim_set_var(&anim, scr);
+    lv_anim_set_exec_cb(&anim, test_tx_anim_cb);
+    lv_anim_set_values(&anim, 0, 359);
+    lv_anim_set_duration(&anim, 1000);
+    lv_anim_set_repeat_count(&anim, LV_ANIM_REPEAT_INFINITE);
+    lv_anim_start(&anim);
+    lvgl_port_unlock();
+
+    vTaskDelay(TEST_TX_RUN_MS / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(lvgl_port_disp_get_stats(lvgl_disp, stats, true), ESP_OK);
+    lvgl_port_disp_log_stats(lvgl_disp, false);
+    if (tx_size) {
+        TEST_ASSERT_EQUAL(lvgl_port_disp_get_tx_stats(lvgl_disp, tx_stats, true), ESP_OK);
+    } else {
+        TEST_ASSERT_EQUAL(ESP_ERR_INVALID_STATE, lvgl_port_disp_get_tx_stats(lvgl_disp, tx_stats, true));
+    }
+
+    lvgl_port_lock(0);
+    lv_anim_delete(scr, test_tx_anim_cb);
+    lvgl_port_unlock();
+    TEST_ASSERT_EQUAL(lvgl_port_remove_disp(lvgl_disp), ESP_OK);
+    lvgl_disp = NULL;
+}
+
+TEST_CASE("Transmit task throughput on SPI display", "[lvgl port][tx task]")
+{
+    const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
+    lvgl_port_disp_stats_t copy, tx;
+    lvgl_port_tx_stats_t tx_stats;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_init(&lvgl_cfg), ESP_OK);
+
+    /* The same animation flushed from LVGL task and through transmit task */
+    test_tx_run(0, &copy, &tx_stats);
+    test_tx_run(EXAMPLE_LCD_H_RES * EXAMPLE_LCD_DRAW_BUFF_HEIGHT, &tx, &tx_stats);
+
+    TEST_ASSERT_GREATER_THAN(0, copy.frames);
+    TEST_ASSERT_GREATER_THAN(0, tx.frames);
+    TEST_ASSERT_GREATER_THAN(0, copy.bus_busy_us);
+    TEST_ASSERT_GREATER_THAN(0, tx.bus_busy_us);
+    printf("Without transmit task: %u fps, bus %u kB/s, flush wait %u ms\n", (unsigned)(copy.frames * 1000 / TEST_TX_RUN_MS),
+           (unsigned)(copy.bytes * 1000 / copy.bus_busy_us), (unsigned)(copy.flush_wait_us / 1000));
+    printf("With transmit task: %u fps, bus %u kB/s, flush wait %u ms\n", (unsigned)(tx.frames * 1000 / TEST_TX_RUN_MS),
+           (unsigned)(tx.bytes * 1000 / tx.bus_busy_us), (unsigned)(tx.flush_wait_us / 1000));
+    printf("Transmit task: flushes %u, transfers %u, copy %u ms, stalls %u (%u ms), max pending %u, max fill %u bytes\n",
+           (unsigned)tx_stats.flushes, (unsigned)tx_stats.transfers, (unsigned)(tx_stats.copy_us / 1000), (unsigned)tx_stats.stalls,
+           (unsigned)(tx_stats.stall_time_us / 1000), (unsigned)tx_stats.max_pending, (unsigned)tx_stats.max_fill);
+    TEST_ASSERT_GREATER_THAN(0, tx_stats.flushes);
+    TEST_ASSERT_GREATER_OR_EQUAL(tx_stats.flushes, tx_stats.transfers);
+
+    TEST_ASSERT_EQUAL(lvgl_port_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
+#if LVGL_VERSION_MAJOR >= 9 && LV_USE_DEMO_BENCHMARK
+#define TEST_BENCHMARK_RUN_MS   (20000)
+
+static void test_benchmark_run(bool worker, lvgl_port_disp_stats_t *stats)
+{
+    TEST_ASSERT_EQUAL(lvgl_port_draw_worker_enable(worker), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_disp_stats_enable(lvgl_disp, true), ESP_OK);
+
+    lvgl_port_lock(0);
+    lv_obj_clean(lv_scr_act());
+    lv_demo_benchmark();
+    lvgl_port_unlock();
+
+    vTaskDelay(TEST_BENCHMARK_RUN_MS / portTICK_PERIOD_MS);
+    TEST_ASSERT_EQUAL(lvgl_port_disp_get_stats(lvgl_disp, stats, true), ESP_OK);
+    lvgl_port_disp_log_stats(lvgl_disp, false);
+    TEST_ASSERT_EQUAL(lvgl_port_disp_stats_enable(lvgl_disp, false), ESP_OK);
+}
+
+TEST_CASE("Draw worker speedup on benchmark demo", "[lvgl port][draw worker][benchmark]")
+{
+    lvgl_port_disp_stats_t single, dual;
+    lvgl_port_draw_worker_stats_t worker_stats;
+
+    TEST_ASSERT_EQUAL(app_lcd_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_init(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lvgl_init(false), ESP_OK);
+    TEST_ASSERT_EQUAL(lvgl_port_draw_worker_init(NULL), ESP_OK);
+
+    /* The same scenes rendered on one core and split between two cores */
+    test_benchmark_run(false, &single);
+    TEST_ASSERT_EQUAL(lvgl_port_draw_worker_get_stats(&worker_stats, true), ESP_OK);
+    test_benchmark_run(true, &dual);
+    TEST_ASSERT_EQUAL(lvgl_port_draw_worker_get_stats(&worker_stats, true), ESP_OK);
+
+    /* Render time without waiting for flush */
+    TEST_ASSERT_GREATER_THAN(0, single.frames);
+    TEST_ASSERT_GREATER_THAN(0, dual.frames);
+    const uint64_t single_us = (single.render_us - single.flush_wait_us) / single.frames;
+    const uint64_t dual_us = (dual.render_us - dual.flush_wait_us) / dual.frames;
+    TEST_ASSERT_GREATER_THAN(0, dual_us);
+    printf("Render one core: %u us/frame, two cores: %u us/frame, speedup %u.%02u\n", (unsigned)single_us, (unsigned)dual_us,
+           (unsigned)(single_us / dual_us), (unsigned)(single_us * 100 / dual_us % 100));
+    printf("Draw tasks: software %u (%u kpx), worker %u (%u kpx), worker busy %u ms\n",
+           (unsigned)worker_stats.sw_tasks, (unsigned)(worker_stats.sw_px / 1000), (unsigned)worker_stats.worker_tasks,
+           (unsigned)(worker_stats.worker_px / 1000), (unsigned)(worker_stats.worker_busy_us / 1000));
+    TEST_ASSERT_GREATER_THAN(0, worker_stats.worker_tasks);
+
+    TEST_ASSERT_EQUAL(app_lvgl_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_touch_deinit(), ESP_OK);
+    TEST_ASSERT_EQUAL(app_lcd_deinit(), ESP_OK);
+}
+#endif
+
 void app_main(void)
 {
     printf("TEST ESP LVGL port\n\r");
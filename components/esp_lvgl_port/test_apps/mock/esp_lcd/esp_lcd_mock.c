@@ -0,0 +1,492 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <inttypes.h>
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_check.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_mock.h"
+
+static const char *TAG = "LCD mock";
+
+/* Defaults of mock panel */
+#define ESP_LCD_MOCK_QUEUE_DEPTH    (10)
+#define ESP_LCD_MOCK_TASK_STACK     (4096)
+#define ESP_LCD_MOCK_STOP_MS        (5000)
+
+/* Host C library has no __containerof */
+#define ESP_LCD_MOCK_FROM_PANEL(p)  ((esp_lcd_mock_t *)((char *)(p) - offsetof(esp_lcd_mock_t, panel)))
+#define ESP_LCD_MOCK_FROM_IO(p)     ((esp_lcd_mock_t *)((char *)(p) - offsetof(esp_lcd_mock_t, io)))
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_lcd_panel_io_t {
+    uint8_t                 deleted;
+};
+
+struct esp_lcd_panel_t {
+    uint8_t                 deleted;
+};
+
+/* Queued transfer (data NULL: stop the bus task) */
+typedef struct {
+    const uint8_t           *data;
+    int                     x1;
+    int                     y1;
+    int                     x2;
+    int                     y2;
+    int64_t                 queued_us;
+} esp_lcd_mock_trans_t;
+
+typedef struct {
+    struct esp_lcd_panel_io_t io;
+    struct esp_lcd_panel_t  panel;
+    esp_lcd_mock_config_t   cfg;
+    uint32_t                px_size;        /* Bytes per pixel */
+    uint8_t                 *mem;           /* Panel memory (hres x vres) */
+    bool                    mirror_x;
+    bool                    mirror_y;
+    bool                    swap_xy;
+    int                     x_gap;
+    int                     y_gap;
+    esp_lcd_panel_io_color_trans_done_cb_t on_color_trans_done;
+    void                    *user_ctx;
+    QueueHandle_t           queue;          /* Queued transfers */
+    TaskHandle_t            task;           /* Bus task, it finishes transfers */
+    SemaphoreHandle_t       lock;           /* Panel memory, pending count, statistics and records */
+    SemaphoreHandle_t       idle;           /* Given when the last pending transfer is finished */
+    SemaphoreHandle_t       stopped;        /* Given by bus task, when it is stopped */
+    volatile uint32_t       pending;        /* Count of queued and not finished transfers */
+    int64_t                 bus_free_us;    /* Simulated end of the last transfer on the bus */
+    esp_lcd_mock_stats_t    stats;
+    esp_lcd_mock_record_t   *records;       /* Ring of the newest transfers */
+    uint32_t                records_cnt;    /* Count of recorded transfers since reset */
+} esp_lcd_mock_t;
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+static void esp_lcd_mock_task(void *arg);
+static void esp_lcd_mock_write(esp_lcd_mock_t *mock, const esp_lcd_mock_trans_t *trans);
+static void esp_lcd_mock_free(esp_lcd_mock_t *mock);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+esp_err_t esp_lcd_new_mock_panel(const esp_lcd_mock_config_t *config, esp_lcd_panel_io_handle_t *ret_io, esp_lcd_panel_handle_t *ret_panel)
+{
+    esp_err_t ret = ESP_OK;
+
+    ESP_RETURN_ON_FALSE(config && ret_io && ret_panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(config->hres > 0 && config->vres > 0, ESP_ERR_INVALID_ARG, TAG, "invalid resolution");
+    ESP_RETURN_ON_FALSE(config->bits_per_pixel == 16 || config->bits_per_pixel == 24, ESP_ERR_INVALID_ARG, TAG, "only 16 and 24 bits per pixel are supported");
+
+    esp_lcd_mock_t *mock = calloc(1, sizeof(esp_lcd_mock_t));
+    ESP_RETURN_ON_FALSE(mock, ESP_ERR_NO_MEM, TAG, "no memory for mock panel");
+    memcpy(&mock->cfg, config, sizeof(esp_lcd_mock_config_t));
+    mock->px_size = config->bits_per_pixel / 8;
+    if (mock->cfg.trans_queue_depth == 0) {
+        mock->cfg.trans_queue_depth = ESP_LCD_MOCK_QUEUE_DEPTH;
+    }
+
+    mock->mem = calloc(config->hres * config->vres, mock->px_size);
+    ESP_GOTO_ON_FALSE(mock->mem, ESP_ERR_NO_MEM, err, TAG, "no memory for panel memory");
+    if (config->max_records > 0) {
+        mock->records = calloc(config->max_records, sizeof(esp_lcd_mock_record_t));
+        ESP_GOTO_ON_FALSE(mock->records, ESP_ERR_NO_MEM, err, TAG, "no memory for records");
+    }
+
+    mock->queue = xQueueCreate(mock->cfg.trans_queue_depth, sizeof(esp_lcd_mock_trans_t));
+    ESP_GOTO_ON_FALSE(mock->queue, ESP_ERR_NO_MEM, err, TAG, "create queue failed");
+    mock->lock = xSemaphoreCreateMutex();
+    ESP_GOTO_ON_FALSE(mock->lock, ESP_ERR_NO_MEM, err, TAG, "create mutex failed");
+    mock->idle = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(mock->idle, ESP_ERR_NO_MEM, err, TAG, "create semaphore failed");
+    mock->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(mock->stopped, ESP_ERR_NO_MEM, err, TAG, "create semaphore failed");
+
+    /* Bus task stands for transfer done interrupt, it preempts the callers of draw_bitmap */
+    BaseType_t res = xTaskCreate(esp_lcd_mock_task, "LCD mock bus", ESP_LCD_MOCK_TASK_STACK, mock, configMAX_PRIORITIES - 1, &mock->task);
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_FAIL, err, TAG, "create bus task failed");
+
+    *ret_io = &mock->io;
+    *ret_panel = &mock->panel;
+    ESP_LOGI(TAG, "Mock panel %"PRIu32"x%"PRIu32", %u bpp, bus %"PRIu32" B/s", config->hres, config->vres, config->bits_per_pixel, config->bus_bytes_per_sec);
+
+    return ESP_OK;
+
+err:
+    esp_lcd_mock_free(mock);
+    return ret;
+}
+
+esp_err_t esp_lcd_mock_wait_idle(esp_lcd_panel_handle_t panel, uint32_t timeout_ms)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    const TickType_t end = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+
+    while (mock->pending > 0) {
+        const TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(end - now) <= 0 || xSemaphoreTake(mock->idle, end - now) != pdTRUE) {
+            return (mock->pending > 0 ? ESP_ERR_TIMEOUT : ESP_OK);
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_mock_get_stats(esp_lcd_panel_handle_t panel, esp_lcd_mock_stats_t *stats, bool reset)
+{
+    ESP_RETURN_ON_FALSE(panel && stats, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    memcpy(stats, &mock->stats, sizeof(esp_lcd_mock_stats_t));
+    if (reset) {
+        memset(&mock->stats, 0, sizeof(esp_lcd_mock_stats_t));
+        mock->records_cnt = 0;
+    }
+    xSemaphoreGive(mock->lock);
+
+    return ESP_OK;
+}
+
+uint32_t esp_lcd_mock_get_records(esp_lcd_panel_handle_t panel, esp_lcd_mock_record_t *records, uint32_t max)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    const uint32_t size = mock->cfg.max_records;
+    uint32_t cnt = 0;
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    const uint32_t total = mock->records_cnt;
+    const uint32_t kept = (total < size ? total : size);
+    for (uint32_t i = total - kept; i < total && cnt < max; i++) {
+        records[cnt++] = mock->records[i % size];
+    }
+    xSemaphoreGive(mock->lock);
+
+    return cnt;
+}
+
+esp_err_t esp_lcd_mock_dump_ppm(esp_lcd_panel_handle_t panel, const char *path)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    const uint32_t width = mock->cfg.hres;
+    const uint32_t height = mock->cfg.vres;
+    esp_err_t ret = ESP_OK;
+
+    FILE *f = fopen(path, "wb");
+    ESP_RETURN_ON_FALSE(f, ESP_FAIL, TAG, "cannot open %s", path);
+
+    uint8_t *line = malloc(width * 3);
+    ESP_GOTO_ON_FALSE(line, ESP_ERR_NO_MEM, err, TAG, "no memory for line");
+    fprintf(f, "P6\n%"PRIu32" %"PRIu32"\n255\n", width, height);
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    for (uint32_t y = 0; y < height && ret == ESP_OK; y++) {
+        const uint8_t *px = mock->mem + y * width * mock->px_size;
+        for (uint32_t x = 0; x < width; x++, px += mock->px_size) {
+            if (mock->px_size == 2) {
+                const uint16_t c = (mock->cfg.flags.swap_bytes ? (px[0] << 8) | px[1] : (px[1] << 8) | px[0]);
+                line[x * 3 + 0] = ((c >> 11) & 0x1f) * 255 / 31;
+                line[x * 3 + 1] = ((c >> 5) & 0x3f) * 255 / 63;
+                line[x * 3 + 2] = (c & 0x1f) * 255 / 31;
+            } else {
+                /* LVGL RGB888 is stored as B, G, R */
+                line[x * 3 + 0] = px[2];
+                line[x * 3 + 1] = px[1];
+                line[x * 3 + 2] = px[0];
+            }
+        }
+        if (fwrite(line, 3, width, f) != width) {
+            ret = ESP_FAIL;
+        }
+    }
+    xSemaphoreGive(mock->lock);
+
+err:
+    free(line);
+    fclose(f);
+    return ret;
+}
+
+esp_err_t esp_lcd_panel_io_register_event_callbacks(esp_lcd_panel_io_handle_t io, const esp_lcd_panel_io_callbacks_t *cbs, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(io && cbs, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_IO(io);
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    mock->on_color_trans_done = cbs->on_color_trans_done;
+    mock->user_ctx = user_ctx;
+    xSemaphoreGive(mock->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_io_del(esp_lcd_panel_io_handle_t io)
+{
+    ESP_RETURN_ON_FALSE(io, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_IO(io);
+
+    mock->io.deleted = 1;
+    if (mock->panel.deleted) {
+        esp_lcd_mock_free(mock);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_reset(esp_lcd_panel_handle_t panel)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    memset(mock->mem, 0, mock->cfg.hres * mock->cfg.vres * mock->px_size);
+    xSemaphoreGive(mock->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_init(esp_lcd_panel_handle_t panel)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_del(esp_lcd_panel_handle_t panel)
+{
+    ESP_RETURN_ON_FALSE(panel, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+
+    mock->panel.deleted = 1;
+    if (mock->io.deleted) {
+        esp_lcd_mock_free(mock);
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_draw_bitmap(esp_lcd_panel_handle_t panel, int x_start, int y_start, int x_end, int y_end, const void *color_data)
+{
+    ESP_RETURN_ON_FALSE(panel && color_data, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(x_start < x_end && y_start < y_end, ESP_ERR_INVALID_ARG, TAG, "start position must be smaller than end position");
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    const esp_lcd_mock_trans_t trans = {
+        .data = color_data,
+        .x1 = x_start,
+        .y1 = y_start,
+        .x2 = x_end,
+        .y2 = y_end,
+        .queued_us = esp_timer_get_time(),
+    };
+    int64_t color_wait = 0;
+    int64_t queue_wait = 0;
+
+    /* Commands are sent only when the bus is free of color transfers */
+    if (mock->cfg.flags.wait_color_done) {
+        while (mock->pending > 0) {
+            xSemaphoreTake(mock->idle, portMAX_DELAY);
+        }
+        color_wait = esp_timer_get_time() - trans.queued_us;
+    }
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    mock->pending++;
+    if (mock->pending > mock->stats.max_queued) {
+        mock->stats.max_queued = mock->pending;
+    }
+    xSemaphoreGive(mock->lock);
+
+    if (xQueueSend(mock->queue, &trans, 0) != pdTRUE) {
+        const int64_t start = esp_timer_get_time();
+        xQueueSend(mock->queue, &trans, portMAX_DELAY);
+        queue_wait = esp_timer_get_time() - start;
+    }
+
+    xSemaphoreTake(mock->lock, portMAX_DELAY);
+    mock->stats.color_wait_us += color_wait;
+    mock->stats.queue_wait_us += queue_wait;
+    xSemaphoreGive(mock->lock);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_mirror(esp_lcd_panel_handle_t panel, bool mirror_x, bool mirror_y)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    mock->mirror_x = mirror_x;
+    mock->mirror_y = mirror_y;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_swap_xy(esp_lcd_panel_handle_t panel, bool swap_axes)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    mock->swap_xy = swap_axes;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_set_gap(esp_lcd_panel_handle_t panel, int x_gap, int y_gap)
+{
+    esp_lcd_mock_t *mock = ESP_LCD_MOCK_FROM_PANEL(panel);
+    mock->x_gap = x_gap;
+    mock->y_gap = y_gap;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_invert_color(esp_lcd_panel_handle_t panel, bool invert_color_data)
+{
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_panel_disp_on_off(esp_lcd_panel_handle_t panel, bool on_off)
+{
+    return ESP_OK;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_lcd_mock_task(void *arg)
+{
+    esp_lcd_mock_t *mock = (esp_lcd_mock_t *)arg;
+    const int64_t tick_us = portTICK_PERIOD_MS * 1000;
+    esp_lcd_mock_trans_t trans;
+
+    while (xQueueReceive(mock->queue, &trans, portMAX_DELAY) == pdTRUE && trans.data) {
+        const uint32_t bytes = (trans.x2 - trans.x1) * (trans.y2 - trans.y1) * mock->px_size;
+        int64_t now = esp_timer_get_time();
+        const int64_t start = (mock->bus_free_us > now ? mock->bus_free_us : now);
+        int64_t duration = mock->cfg.trans_overhead_us;
+        if (mock->cfg.bus_bytes_per_sec > 0) {
+            duration += (int64_t)bytes * 1000000 / mock->cfg.bus_bytes_per_sec;
+        }
+        const int64_t done = start + duration;
+        mock->bus_free_us = done;
+
+        /* Simulated bus runs ahead of real time by less than one tick, shorter transfers are not slept */
+        while ((now = esp_timer_get_time()) + tick_us <= done) {
+            vTaskDelay((done - now) / tick_us);
+        }
+
+        /* Color data are read at the end of the transfer, like by DMA */
+        xSemaphoreTake(mock->lock, portMAX_DELAY);
+        esp_lcd_mock_write(mock, &trans);
+        mock->stats.transfers++;
+        mock->stats.bytes += bytes;
+        mock->stats.bus_busy_us += duration;
+        if (mock->records) {
+            esp_lcd_mock_record_t *rec = &mock->records[mock->records_cnt++ % mock->cfg.max_records];
+            rec->x1 = trans.x1;
+            rec->y1 = trans.y1;
+            rec->x2 = trans.x2;
+            rec->y2 = trans.y2;
+            rec->bytes = bytes;
+            rec->queued_us = trans.queued_us;
+            rec->start_us = start;
+            rec->done_us = done;
+        }
+        const bool idle = (--mock->pending == 0);
+        esp_lcd_panel_io_color_trans_done_cb_t cb = mock->on_color_trans_done;
+        void *user_ctx = mock->user_ctx;
+        xSemaphoreGive(mock->lock);
+
+        if (idle) {
+            xSemaphoreGive(mock->idle);
+        }
+        if (cb) {
+            cb(&mock->io, NULL, user_ctx);
+        }
+    }
+
+    xSemaphoreGive(mock->stopped);
+    vTaskDelete(NULL);
+}
+
+/* Called with lock */
+static void esp_lcd_mock_write(esp_lcd_mock_t *mock, const esp_lcd_mock_trans_t *trans)
+{
+    const int hres = mock->cfg.hres;
+    const int vres = mock->cfg.vres;
+    const uint32_t px_size = mock->px_size;
+    const uint32_t line_len = (trans->x2 - trans->x1) * px_size;
+    const uint8_t *src = trans->data;
+    bool out_of_bounds = false;
+
+    for (int y = trans->y1 + mock->y_gap; y < trans->y2 + mock->y_gap; y++, src += line_len) {
+        /* Fast path without panel orientation */
+        if (!mock->swap_xy && !mock->mirror_x && !mock->mirror_y) {
+            if (y < 0 || y >= vres || trans->x1 + mock->x_gap < 0 || trans->x2 + mock->x_gap > hres) {
+                out_of_bounds = true;
+                continue;
+            }
+            memcpy(mock->mem + (y * hres + trans->x1 + mock->x_gap) * px_size, src, line_len);
+            continue;
+        }
+
+        const uint8_t *px = src;
+        for (int x = trans->x1 + mock->x_gap; x < trans->x2 + mock->x_gap; x++, px += px_size) {
+            int mx = (mock->swap_xy ? y : x);
+            int my = (mock->swap_xy ? x : y);
+            if (mock->mirror_x) {
+                mx = hres - 1 - mx;
+            }
+            if (mock->mirror_y) {
+                my = vres - 1 - my;
+            }
+            if (mx < 0 || mx >= hres || my < 0 || my >= vres) {
+                out_of_bounds = true;
+                continue;
+            }
+            memcpy(mock->mem + (my * hres + mx) * px_size, px, px_size);
+        }
+    }
+
+    if (out_of_bounds) {
+        mock->stats.out_of_bounds++;
+    }
+}
+
+static void esp_lcd_mock_free(esp_lcd_mock_t *mock)
+{
+    if (mock->task) {
+        if (esp_lcd_mock_wait_idle(&mock->panel, ESP_LCD_MOCK_STOP_MS) != ESP_OK) {
+            ESP_LOGW(TAG, "Transfers are still pending");
+        }
+        const esp_lcd_mock_trans_t stop = { .data = NULL };
+        xQueueSend(mock->queue, &stop, portMAX_DELAY);
+        xSemaphoreTake(mock->stopped, portMAX_DELAY);
+    }
+    if (mock->queue) {
+        vQueueDelete(mock->queue);
+    }
+    if (mock->lock) {
+        vSemaphoreDelete(mock->lock);
+    }
+    if (mock->idle) {
+        vSemaphoreDelete(mock->idle);
+    }
+    if (mock->stopped) {
+        vSemaphoreDelete(mock->stopped);
+    }
+    free(mock->records);
+    free(mock->mem);
+    free(mock);
+}
@@ -0,0 +1,131 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Headless mock of LCD panel and panel IO (host build)
+ *
+ * Transfers are queued like in SPI/I2C/I8080 panel IO and finished by the mock bus task after the time given by
+ * configured bus bandwidth. The color data are read at the end of the transfer (like DMA), so the panel memory shows
+ * the data, which were in the buffer at that time.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "esp_lcd_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Mock panel configuration
+ */
+typedef struct {
+    uint32_t hres;                  /*!< Horizontal resolution of panel memory */
+    uint32_t vres;                  /*!< Vertical resolution of panel memory */
+    uint8_t  bits_per_pixel;        /*!< Color depth, 16 (RGB565) or 24 (RGB888) */
+    uint32_t bus_bytes_per_sec;     /*!< Simulated bus bandwidth (0: transfers are finished immediately) */
+    uint32_t trans_overhead_us;     /*!< Simulated time of commands before each transfer (column and row address) */
+    uint8_t  trans_queue_depth;     /*!< Count of queued transfers, draw_bitmap waits when the queue is full (0: 10) */
+    uint16_t max_records;           /*!< Count of recorded transfers, the newest ones are kept (0: no records) */
+    struct {
+        unsigned int swap_bytes: 1;         /*!< RGB565 data are big-endian (esp_lvgl_port swap_bytes) */
+        unsigned int wait_color_done: 1;    /*!< Like SPI panel IO, draw_bitmap waits for all pending transfers before it sends the commands */
+    } flags;
+} esp_lcd_mock_config_t;
+
+/**
+ * @brief Recorded transfer
+ */
+typedef struct {
+    int      x1;                    /*!< Start of area on x-axis (included) */
+    int      y1;                    /*!< Start of area on y-axis (included) */
+    int      x2;                    /*!< End of area on x-axis (not included) */
+    int      y2;                    /*!< End of area on y-axis (not included) */
+    uint32_t bytes;                 /*!< Size of color data */
+    int64_t  queued_us;             /*!< Time when draw_bitmap was called */
+    int64_t  start_us;              /*!< Simulated start of transfer on the bus */
+    int64_t  done_us;               /*!< Simulated end of transfer on the bus */
+} esp_lcd_mock_record_t;
+
+/**
+ * @brief Mock panel statistics
+ */
+typedef struct {
+    uint32_t transfers;             /*!< Count of finished transfers */
+    uint64_t bytes;                 /*!< Count of transferred bytes */
+    uint64_t bus_busy_us;           /*!< Simulated time of transfers on the bus */
+    uint64_t color_wait_us;         /*!< Time spent in draw_bitmap waiting for pending transfers (flags.wait_color_done) */
+    uint64_t queue_wait_us;         /*!< Time spent in draw_bitmap waiting for space in the queue */
+    uint8_t  max_queued;            /*!< Maximum count of queued transfers */
+    uint32_t out_of_bounds;         /*!< Count of transfers outside of panel memory */
+} esp_lcd_mock_stats_t;
+
+/**
+ * @brief Create mock panel and its panel IO
+ *
+ * @param[in] config Mock panel configuration
+ * @param[out] ret_io Returned panel IO handle
+ * @param[out] ret_panel Returned panel handle
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *      - ESP_ERR_NO_MEM        if memory allocation fails
+ */
+esp_err_t esp_lcd_new_mock_panel(const esp_lcd_mock_config_t *config, esp_lcd_panel_io_handle_t *ret_io, esp_lcd_panel_handle_t *ret_panel);
+
+/**
+ * @brief Wait until all queued transfers are finished
+ *
+ * @param[in] panel Mock panel handle
+ * @param[in] timeout_ms Timeout in milliseconds
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_TIMEOUT       if transfers are still pending
+ */
+esp_err_t esp_lcd_mock_wait_idle(esp_lcd_panel_handle_t panel, uint32_t timeout_ms);
+
+/**
+ * @brief Get statistics of mock panel
+ *
+ * @param[in] panel Mock panel handle
+ * @param[out] stats Statistics
+ * @param[in] reset Reset statistics and records after reading
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_ERR_INVALID_ARG   if parameter is invalid
+ */
+esp_err_t esp_lcd_mock_get_stats(esp_lcd_panel_handle_t panel, esp_lcd_mock_stats_t *stats, bool reset);
+
+/**
+ * @brief Get recorded transfers, the oldest first
+ *
+ * @param[in] panel Mock panel handle
+ * @param[out] records Buffer for records
+ * @param[in] max Size of buffer in records
+ * @return
+ *      - Count of copied records
+ */
+uint32_t esp_lcd_mock_get_records(esp_lcd_panel_handle_t panel, esp_lcd_mock_record_t *records, uint32_t max);
+
+/**
+ * @brief Write panel memory into binary PPM image (P6)
+ *
+ * @param[in] panel Mock panel handle
+ * @param[in] path Path of image file
+ * @return
+ *      - ESP_OK                on success
+ *      - ESP_FAIL              if the file cannot be written
+ */
+esp_err_t esp_lcd_mock_dump_ppm(esp_lcd_panel_handle_t panel, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
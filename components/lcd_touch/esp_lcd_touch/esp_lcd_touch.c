@@ -1,25 +1,71 @@
 /*
- * SPDX-FileCopyrightText: 2015-2023 Espressif Systems (Shanghai) CO LTD
+ * SPDX-FileCopyrightText: 2015-2024 Espressif Systems (Shanghai) CO LTD
  *
  * SPDX-License-Identifier: Apache-2.0
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "driver/gpio.h"
 #include "esp_system.h"
 #include "esp_err.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "nvs.h"
 #include "esp_lcd_touch.h"
+#include "esp_lcd_touch_predict.h"
+#include "esp_lcd_touch_filter.h"
+#include "esp_lcd_touch_calibration.h"
 
 static const char *TAG = "TP";
 
+#define ESP_LCD_TOUCH_SAMPLER_POLL_MS       (10)
+#define ESP_LCD_TOUCH_SAMPLER_PRIORITY      (5)
+#define ESP_LCD_TOUCH_SAMPLER_STACK         (3072)
+#define ESP_LCD_TOUCH_PREDICT_RESET_MS      (100)
+#define ESP_LCD_TOUCH_CALIBRATION_READ_MS   (10)
+#define ESP_LCD_TOUCH_CALIBRATION_SKIP      (3)     /* Reads skipped after press, position is not stable yet */
+#define ESP_LCD_TOUCH_CALIBRATION_NVS       "esp_lcd_touch"
+
+/*******************************************************************************
+* Types definitions
+*******************************************************************************/
+
+struct esp_lcd_touch_sampler_s {
+    esp_lcd_touch_sampler_config_t  config;
+    esp_lcd_touch_handle_t  tp;         /* Touch handler */
+    TaskHandle_t            task;       /* Reader task */
+    SemaphoreHandle_t       stopped;    /* Given by reader task before exit */
+    volatile bool           stop;       /* Request to exit reader task */
+    int64_t                 irq_us;     /* Time of the last touch interrupt (under lock of touch data) */
+    bool                    use_irq;    /* Reader task waits for touch interrupt */
+    esp_lcd_touch_sample_t  *ring;      /* Ring of samples */
+    uint16_t                head;       /* Index of the oldest sample */
+    uint16_t                count;      /* Count of samples in ring */
+    esp_lcd_touch_sample_t  last;       /* The newest sample */
+    esp_lcd_touch_sampler_stats_t stats;
+    portMUX_TYPE            lock;       /* Lock of ring, the newest sample and statistics */
+    uint32_t                users;      /* Count of readers using the sampler (under lock of touch data) */
+};
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
 
+static void esp_lcd_touch_process_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num);
+static esp_err_t esp_lcd_touch_update_isr(esp_lcd_touch_handle_t tp);
+static void esp_lcd_touch_isr(void *arg);
+static void esp_lcd_touch_sampler_task(void *arg);
+static esp_lcd_touch_sampler_t *esp_lcd_touch_sampler_take(esp_lcd_touch_handle_t tp);
+static void esp_lcd_touch_sampler_give(esp_lcd_touch_handle_t tp, esp_lcd_touch_sampler_t *sampler);
+static void esp_lcd_touch_predict_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint8_t point_num, int64_t time_us, bool predict);
+static void esp_lcd_touch_calibrate_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint8_t point_num);
+static void esp_lcd_touch_filter_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num, int64_t time_us);
+
 /*******************************************************************************
 * Local variables
 *******************************************************************************/
@@ -55,6 +101,11 @@ esp_err_t esp_lcd_touch_read_data(esp_lcd_touch_handle_t tp)
     assert(tp != NULL);
     assert(tp->read_data != NULL);
 
+    /* Reader task owns the bus */
+    if (tp->sampler != NULL) {
+        return ESP_OK;
+    }
+
     return tp->read_data(tp);
 }
 
@@ -67,40 +118,47 @@ bool esp_lcd_touch_get_coordinates(esp_lcd_touch_handle_t tp, uint16_t *x, uint1
     assert(y != NULL);
     assert(tp->get_xy != NULL);
 
-    touched = tp->get_xy(tp, x, y, strength, point_num, max_point_num);
-    if (!touched) {
-        return false;
+    /* The newest sample of reader task, it is already processed */
+    esp_lcd_touch_sampler_t *sampler = esp_lcd_touch_sampler_take(tp);
+    if (sampler != NULL) {
+        portENTER_CRITICAL(&sampler->lock);
+        *point_num = (sampler->last.points > max_point_num ? max_point_num : sampler->last.points);
+        for (int i = 0; i < *point_num; i++) {
+            x[i] = sampler->last.x[i];
+            y[i] = sampler->last.y[i];
+            if (strength) {
+                strength[i] = sampler->last.strength[i];
+            }
+        }
+        portEXIT_CRITICAL(&sampler->lock);
+        esp_lcd_touch_sampler_give(tp, sampler);
+        esp_lcd_touch_predict_points(tp, x, y, *point_num, esp_timer_get_time(), true);
+        return (*point_num > 0);
     }
 
-    /* Process coordinates by user */
-    if (tp->config.process_coordinates != NULL) {
-        tp->config.process_coordinates(tp, x, y, strength, point_num, max_point_num);
+    touched = tp->get_xy(tp, x, y, strength, point_num, max_point_num);
+    if (touched) {
+        esp_lcd_touch_process_points(tp, x, y, strength, point_num, max_point_num);
+        esp_lcd_touch_calibrate_points(tp, x, y, *point_num);
+    } else {
+        *point_num = 0;
     }
 
-    /* Software coordinates adjustment needed */
-    bool sw_adj_needed = ((tp->config.flags.mirror_x && (tp->set_mirror_x == NULL)) ||
-                          (tp->config.flags.mirror_y && (tp->set_mirror_y == NULL)) ||
-                          (tp->config.flags.swap_xy && (tp->set_swap_xy == NULL)));
-
-    /* Adjust all coordinates */
-    for (int i = 0; (sw_adj_needed && i < *point_num); i++) {
-
-        /*  Mirror X coordinates (if not supported by HW) */
-        if (tp->config.flags.mirror_x && tp->set_mirror_x == NULL) {
-            x[i] = tp->config.x_max - x[i];
-        }
-
-        /*  Mirror Y coordinates (if not supported by HW) */
-        if (tp->config.flags.mirror_y && tp->set_mirror_y == NULL) {
-            y[i] = tp->config.y_max - y[i];
-        }
+    /* Release can be held by the filter chain */
+    if (tp->filter != NULL) {
+        esp_lcd_touch_filter_points(tp, x, y, strength, point_num, max_point_num, esp_timer_get_time());
+        touched = (*point_num > 0);
+    }
+    if (!touched) {
+        esp_lcd_touch_predict_points(tp, x, y, 0, 0, false);
+        return false;
+    }
 
-        /* Swap X and Y coordinates (if not supported by HW) */
-        if (tp->config.flags.swap_xy && tp->set_swap_xy == NULL) {
-            uint16_t tmp = x[i];
-            x[i] = y[i];
-            y[i] = tmp;
-        }
+    /* Prediction is updated with the read, the output is predicted ahead of it */
+    if (tp->predict != NULL) {
+        const int64_t now = esp_timer_get_time();
+        esp_lcd_touch_predict_points(tp, x, y, *point_num, now, false);
+        esp_lcd_touch_predict_points(tp, x, y, *point_num, now, true);
     }
 
     return touched;
@@ -215,6 +273,16 @@ esp_err_t esp_lcd_touch_del(esp_lcd_touch_handle_t tp)
 {
     assert(tp != NULL);
 
+    if (tp->sampler != NULL) {
+        esp_lcd_touch_sampler_stop(tp);
+    }
+    free(tp->predict);
+    tp->predict = NULL;
+    free(tp->calibration);
+    tp->calibration = NULL;
+    free(tp->filter);
+    tp->filter = NULL;
+
     if (tp->del != NULL) {
         return tp->del(tp);
     }
@@ -224,7 +292,6 @@ esp_err_t esp_lcd_touch_del(esp_lcd_touch_handle_t tp)
 
 esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, esp_lcd_touch_interrupt_callback_t callback)
 {
-    esp_err_t ret = ESP_OK;
     assert(tp != NULL);
 
     /* Interrupt pin is not selected */
@@ -234,7 +301,477 @@ esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, e
 
     tp->config.interrupt_callback = callback;
 
-    if (callback != NULL) {
+    return esp_lcd_touch_update_isr(tp);
+}
+
+esp_err_t esp_lcd_touch_register_interrupt_callback_with_data(esp_lcd_touch_handle_t tp, esp_lcd_touch_interrupt_callback_t callback, void *user_data)
+{
+    assert(tp != NULL);
+
+    tp->config.user_data = user_data;
+    return esp_lcd_touch_register_interrupt_callback(tp, callback);
+}
+
+esp_err_t esp_lcd_touch_sampler_start(esp_lcd_touch_handle_t tp, const esp_lcd_touch_sampler_config_t *config)
+{
+    esp_err_t ret = ESP_OK;
+    esp_lcd_touch_sampler_t *sampler = NULL;
+    BaseType_t res;
+
+    assert(tp != NULL);
+    ESP_RETURN_ON_FALSE(config && config->ring_size > 0, ESP_ERR_INVALID_ARG, TAG, "invalid arguments");
+    ESP_RETURN_ON_FALSE(tp->sampler == NULL, ESP_ERR_INVALID_STATE, TAG, "Sampler already started");
+
+    sampler = calloc(1, sizeof(esp_lcd_touch_sampler_t));
+    ESP_GOTO_ON_FALSE(sampler, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sampler!");
+    sampler->ring = calloc(config->ring_size, sizeof(esp_lcd_touch_sample_t));
+    ESP_GOTO_ON_FALSE(sampler->ring, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sample ring!");
+    sampler->stopped = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(sampler->stopped, ESP_ERR_NO_MEM, err, TAG, "Not enough memory for sampler semaphore!");
+    sampler->config = *config;
+    if (sampler->config.poll_period_ms == 0) {
+        sampler->config.poll_period_ms = ESP_LCD_TOUCH_SAMPLER_POLL_MS;
+    }
+    sampler->tp = tp;
+    sampler->use_irq = (tp->config.int_gpio_num != GPIO_NUM_NC);
+    sampler->lock.owner = portMUX_FREE_VAL;
+
+    const int priority = (config->task_priority > 0 ? config->task_priority : ESP_LCD_TOUCH_SAMPLER_PRIORITY);
+    const uint32_t stack = (config->task_stack > 0 ? config->task_stack : ESP_LCD_TOUCH_SAMPLER_STACK);
+    if (config->task_affinity < 0) {
+        res = xTaskCreate(esp_lcd_touch_sampler_task, "touch reader", stack, sampler, priority, &sampler->task);
+    } else {
+        res = xTaskCreatePinnedToCore(esp_lcd_touch_sampler_task, "touch reader", stack, sampler, priority, &sampler->task, config->task_affinity);
+    }
+    ESP_GOTO_ON_FALSE(res == pdPASS, ESP_ERR_NO_MEM, err, TAG, "Create touch reader task fail!");
+
+    /* Reader task waits for the first notification, it starts reading after the sampler is published */
+    portENTER_CRITICAL(&tp->data.lock);
+    tp->sampler = sampler;
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    if (sampler->use_irq) {
+        ret = esp_lcd_touch_update_isr(tp);
+        if (ret != ESP_OK) {
+            esp_lcd_touch_sampler_stop(tp);
+            return ret;
+        }
+    }
+    xTaskNotifyGive(sampler->task);
+
+    return ESP_OK;
+
+err:
+    if (sampler) {
+        if (sampler->stopped) {
+            vSemaphoreDelete(sampler->stopped);
+        }
+        free(sampler->ring);
+        free(sampler);
+    }
+    return ret;
+}
+
+esp_err_t esp_lcd_touch_sampler_stop(esp_lcd_touch_handle_t tp)
+{
+    assert(tp != NULL);
+
+    /* Interrupt and new readers do not get the sampler after it is unpublished */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_sampler_t *sampler = tp->sampler;
+    tp->sampler = NULL;
+    portEXIT_CRITICAL(&tp->data.lock);
+    ESP_RETURN_ON_FALSE(sampler, ESP_ERR_INVALID_STATE, TAG, "Sampler not started");
+    if (sampler->use_irq) {
+        esp_lcd_touch_update_isr(tp);
+    }
+
+    sampler->stop = true;
+    xTaskNotifyGive(sampler->task);
+    xSemaphoreTake(sampler->stopped, portMAX_DELAY);
+
+    /* Readers which took the sampler before it was unpublished copy out of it in short critical sections */
+    while (true) {
+        portENTER_CRITICAL(&tp->data.lock);
+        const bool used = (sampler->users > 0);
+        portEXIT_CRITICAL(&tp->data.lock);
+        if (!used) {
+            break;
+        }
+        vTaskDelay(1);
+    }
+
+    vSemaphoreDelete(sampler->stopped);
+    free(sampler->ring);
+    free(sampler);
+
+    return ESP_OK;
+}
+
+bool esp_lcd_touch_get_sample(esp_lcd_touch_handle_t tp, esp_lcd_touch_sample_t *sample, uint16_t *remaining)
+{
+    bool taken = false;
+
+    assert(tp != NULL);
+    assert(sample != NULL);
+
+    esp_lcd_touch_sampler_t *sampler = esp_lcd_touch_sampler_take(tp);
+    if (sampler == NULL) {
+        if (remaining) {
+            *remaining = 0;
+        }
+        return false;
+    }
+
+    portENTER_CRITICAL(&sampler->lock);
+    if (sampler->count > 0) {
+        memcpy(sample, &sampler->ring[sampler->head], sizeof(esp_lcd_touch_sample_t));
+        sampler->head = (sampler->head + 1) % sampler->config.ring_size;
+        sampler->count--;
+        taken = true;
+    }
+    if (remaining) {
+        *remaining = sampler->count;
+    }
+    portEXIT_CRITICAL(&sampler->lock);
+    esp_lcd_touch_sampler_give(tp, sampler);
+
+    return taken;
+}
+
+esp_err_t esp_lcd_touch_sampler_get_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_sampler_stats_t *stats, bool reset)
+{
+    assert(tp != NULL);
+    assert(stats != NULL);
+    esp_lcd_touch_sampler_t *sampler = esp_lcd_touch_sampler_take(tp);
+    ESP_RETURN_ON_FALSE(sampler, ESP_ERR_INVALID_STATE, TAG, "Sampler not started");
+
+    portENTER_CRITICAL(&sampler->lock);
+    memcpy(stats, &sampler->stats, sizeof(esp_lcd_touch_sampler_stats_t));
+    if (reset) {
+        memset(&sampler->stats, 0, sizeof(esp_lcd_touch_sampler_stats_t));
+    }
+    portEXIT_CRITICAL(&sampler->lock);
+    esp_lcd_touch_sampler_give(tp, sampler);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_set_prediction(esp_lcd_touch_handle_t tp, const esp_lcd_touch_predict_config_t *config)
+{
+    esp_lcd_touch_predict_t *predict = NULL;
+
+    assert(tp != NULL);
+
+    if (config != NULL) {
+        ESP_RETURN_ON_FALSE(config->alpha > 0.0f && config->alpha <= 1.0f, ESP_ERR_INVALID_ARG, TAG, "Invalid alpha");
+        ESP_RETURN_ON_FALSE(config->beta >= 0.0f && config->beta <= 2.0f, ESP_ERR_INVALID_ARG, TAG, "Invalid beta");
+        predict = malloc(sizeof(esp_lcd_touch_predict_t));
+        ESP_RETURN_ON_FALSE(predict, ESP_ERR_NO_MEM, TAG, "Not enough memory for prediction!");
+
+        const esp_lcd_touch_predict_cfg_t cfg = {
+            .alpha = config->alpha,
+            .beta = config->beta,
+            .lead_us = config->lead_ms * 1000,
+            .max_lead = config->max_lead,
+            .reset_us = (config->reset_ms > 0 ? config->reset_ms : ESP_LCD_TOUCH_PREDICT_RESET_MS) * 1000,
+            .reset_dist = config->jump_dist,
+        };
+        esp_lcd_touch_predict_init(predict, &cfg);
+    }
+
+    /* Reader task uses the state only under the lock */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_predict_t *old = tp->predict;
+    tp->predict = predict;
+    portEXIT_CRITICAL(&tp->data.lock);
+    free(old);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_calibration_compute(const esp_lcd_touch_calibration_point_t *points, uint8_t count, esp_lcd_touch_calibration_t *calibration)
+{
+    esp_lcd_touch_calibration_fit_t fit;
+    int32_t matrix[6];
+
+    assert(points != NULL);
+    assert(calibration != NULL);
+    ESP_RETURN_ON_FALSE(count >= 3, ESP_ERR_INVALID_ARG, TAG, "At least three calibration points needed");
+
+    esp_lcd_touch_calibration_fit_init(&fit);
+    for (int i = 0; i < count; i++) {
+        esp_lcd_touch_calibration_fit_add(&fit, points[i].raw_x, points[i].raw_y, points[i].x, points[i].y);
+    }
+    const esp_lcd_touch_calibration_fit_result_t result = esp_lcd_touch_calibration_fit_solve(&fit, matrix);
+    ESP_RETURN_ON_FALSE(result != ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR, ESP_ERR_INVALID_ARG, TAG, "Calibration points are on one line");
+    ESP_RETURN_ON_FALSE(result == ESP_LCD_TOUCH_CALIBRATION_FIT_OK, ESP_ERR_INVALID_ARG, TAG, "Calibration out of range");
+
+    calibration->a = matrix[0];
+    calibration->b = matrix[1];
+    calibration->c = matrix[2];
+    calibration->d = matrix[3];
+    calibration->e = matrix[4];
+    calibration->f = matrix[5];
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_set_calibration(esp_lcd_touch_handle_t tp, const esp_lcd_touch_calibration_t *calibration)
+{
+    esp_lcd_touch_calibration_t *cal = NULL;
+
+    assert(tp != NULL);
+
+    if (calibration != NULL) {
+        cal = malloc(sizeof(esp_lcd_touch_calibration_t));
+        ESP_RETURN_ON_FALSE(cal, ESP_ERR_NO_MEM, TAG, "Not enough memory for calibration!");
+        memcpy(cal, calibration, sizeof(esp_lcd_touch_calibration_t));
+    }
+
+    /* Reader task uses the matrix only under the lock */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_calibration_t *old = tp->calibration;
+    tp->calibration = cal;
+    portEXIT_CRITICAL(&tp->data.lock);
+    free(old);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_get_calibration(esp_lcd_touch_handle_t tp, esp_lcd_touch_calibration_t *calibration)
+{
+    bool calibrated = false;
+
+    assert(tp != NULL);
+    assert(calibration != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->calibration != NULL) {
+        memcpy(calibration, tp->calibration, sizeof(esp_lcd_touch_calibration_t));
+        calibrated = true;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return (calibrated ? ESP_OK : ESP_ERR_NOT_FOUND);
+}
+
+esp_err_t esp_lcd_touch_calibration_capture(esp_lcd_touch_handle_t tp, esp_lcd_touch_calibration_point_t *point, uint32_t timeout_ms)
+{
+    uint16_t x[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint16_t y[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint32_t sum_x = 0;
+    uint32_t sum_y = 0;
+    uint32_t reads = 0;
+    uint32_t count = 0;
+
+    assert(tp != NULL);
+    assert(point != NULL);
+    assert(tp->read_data != NULL);
+    assert(tp->get_xy != NULL);
+    ESP_RETURN_ON_FALSE(tp->sampler == NULL, ESP_ERR_INVALID_STATE, TAG, "Sampler is running");
+    /* Interrupt callback starts reads of the application (e.g. LVGL input), they would race with the reads here */
+    ESP_RETURN_ON_FALSE(tp->config.interrupt_callback == NULL, ESP_ERR_INVALID_STATE, TAG, "Interrupt callback is registered");
+
+    const int64_t end_us = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while (esp_timer_get_time() < end_us) {
+        uint8_t point_num = 0;
+        ESP_RETURN_ON_ERROR(tp->read_data(tp), TAG, "Touch read failed");
+        if (tp->get_xy(tp, x, y, NULL, &point_num, CONFIG_ESP_LCD_TOUCH_MAX_POINTS)) {
+            esp_lcd_touch_process_points(tp, x, y, NULL, &point_num, CONFIG_ESP_LCD_TOUCH_MAX_POINTS);
+        } else {
+            point_num = 0;
+        }
+
+        if (point_num > 0) {
+            reads++;
+            if (reads > ESP_LCD_TOUCH_CALIBRATION_SKIP) {
+                sum_x += x[0];
+                sum_y += y[0];
+                count++;
+            }
+        } else if (count > 0) {
+            /* Released after a stable press */
+            point->raw_x = (sum_x + count / 2) / count;
+            point->raw_y = (sum_y + count / 2) / count;
+            return ESP_OK;
+        } else {
+            /* Too short tap is ignored */
+            reads = 0;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(ESP_LCD_TOUCH_CALIBRATION_READ_MS));
+    }
+
+    return ESP_ERR_TIMEOUT;
+}
+
+esp_err_t esp_lcd_touch_calibration_save(esp_lcd_touch_handle_t tp, const char *key)
+{
+    esp_err_t ret = ESP_OK;
+    esp_lcd_touch_calibration_t calibration;
+    nvs_handle_t nvs;
+
+    assert(tp != NULL);
+    assert(key != NULL);
+    ESP_RETURN_ON_ERROR(esp_lcd_touch_get_calibration(tp, &calibration), TAG, "Not calibrated");
+
+    ESP_RETURN_ON_ERROR(nvs_open(ESP_LCD_TOUCH_CALIBRATION_NVS, NVS_READWRITE, &nvs), TAG, "NVS open failed");
+    ESP_GOTO_ON_ERROR(nvs_set_blob(nvs, key, &calibration, sizeof(calibration)), err, TAG, "NVS write failed");
+    ESP_GOTO_ON_ERROR(nvs_commit(nvs), err, TAG, "NVS commit failed");
+
+err:
+    nvs_close(nvs);
+    return ret;
+}
+
+esp_err_t esp_lcd_touch_calibration_load(esp_lcd_touch_handle_t tp, const char *key)
+{
+    esp_err_t ret = ESP_OK;
+    esp_lcd_touch_calibration_t calibration;
+    size_t size = sizeof(calibration);
+    nvs_handle_t nvs;
+
+    assert(tp != NULL);
+    assert(key != NULL);
+
+    /* Namespace does not exist before the first save */
+    ret = nvs_open(ESP_LCD_TOUCH_CALIBRATION_NVS, NVS_READONLY, &nvs);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    ret = nvs_get_blob(nvs, key, &calibration, &size);
+    nvs_close(nvs);
+    if (ret == ESP_ERR_NVS_INVALID_LENGTH || (ret == ESP_OK && size != sizeof(calibration))) {
+        ESP_LOGE(TAG, "Saved calibration has wrong size");
+        return ESP_ERR_INVALID_SIZE;
+    }
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    return esp_lcd_touch_set_calibration(tp, &calibration);
+}
+
+esp_err_t esp_lcd_touch_set_filter(esp_lcd_touch_handle_t tp, const esp_lcd_touch_filter_config_t *config)
+{
+    esp_lcd_touch_filter_t *filter = NULL;
+
+    assert(tp != NULL);
+
+    if (config != NULL) {
+        ESP_RETURN_ON_FALSE(config->median <= ESP_LCD_TOUCH_FILTER_MEDIAN_MAX && (config->median <= 1 || (config->median & 1)),
+                            ESP_ERR_INVALID_ARG, TAG, "Median window must be odd and at most %d", ESP_LCD_TOUCH_FILTER_MEDIAN_MAX);
+        filter = malloc(sizeof(esp_lcd_touch_filter_t));
+        ESP_RETURN_ON_FALSE(filter, ESP_ERR_NO_MEM, TAG, "Not enough memory for filter!");
+
+        const esp_lcd_touch_filter_cfg_t cfg = {
+            .median = config->median,
+            .smooth = config->smooth,
+            .dead_zone = config->dead_zone,
+            .release_us = config->release_ms * 1000,
+        };
+        esp_lcd_touch_filter_init(filter, &cfg);
+    }
+
+    /* Reader task uses the state only under the lock */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_filter_t *old = tp->filter;
+    tp->filter = filter;
+    portEXIT_CRITICAL(&tp->data.lock);
+    free(old);
+
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_touch_get_filter_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_filter_stats_t *stats, bool reset)
+{
+    esp_err_t ret = ESP_OK;
+
+    assert(tp != NULL);
+    assert(stats != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->filter != NULL) {
+        const esp_lcd_touch_filter_t *filter = tp->filter;
+        stats->samples = filter->metrics.samples;
+        stats->releases_held = filter->metrics.releases_held;
+        stats->path_raw = filter->metrics.path_raw;
+        stats->path_filtered = filter->metrics.path_filtered;
+        stats->lag_sum = filter->metrics.lag_sum;
+        stats->lag_max = filter->metrics.lag_max;
+        stats->time_max_us = filter->metrics.time_max_us;
+        if (reset) {
+            memset(&tp->filter->metrics, 0, sizeof(tp->filter->metrics));
+        }
+    } else {
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    ESP_RETURN_ON_FALSE(ret == ESP_OK, ret, TAG, "Filter not enabled");
+    return ESP_OK;
+}
+
+bool esp_lcd_touch_release_pending(esp_lcd_touch_handle_t tp)
+{
+    bool pending = false;
+
+    assert(tp != NULL);
+
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->filter != NULL) {
+        pending = (tp->filter->releasing && tp->filter->points > 0);
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return pending;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static void esp_lcd_touch_process_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num)
+{
+    /* Process coordinates by user */
+    if (tp->config.process_coordinates != NULL) {
+        tp->config.process_coordinates(tp, x, y, strength, point_num, max_point_num);
+    }
+
+    /* Software coordinates adjustment needed */
+    bool sw_adj_needed = ((tp->config.flags.mirror_x && (tp->set_mirror_x == NULL)) ||
+                          (tp->config.flags.mirror_y && (tp->set_mirror_y == NULL)) ||
+                          (tp->config.flags.swap_xy && (tp->set_swap_xy == NULL)));
+
+    /* Adjust all coordinates */
+    for (int i = 0; (sw_adj_needed && i < *point_num); i++) {
+
+        /*  Mirror X coordinates (if not supported by HW) */
+        if (tp->config.flags.mirror_x && tp->set_mirror_x == NULL) {
+            x[i] = tp->config.x_max - x[i];
+        }
+
+        /*  Mirror Y coordinates (if not supported by HW) */
+        if (tp->config.flags.mirror_y && tp->set_mirror_y == NULL) {
+            y[i] = tp->config.y_max - y[i];
+        }
+
+        /* Swap X and Y coordinates (if not supported by HW) */
+        if (tp->config.flags.swap_xy && tp->set_swap_xy == NULL) {
+            uint16_t tmp = x[i];
+            x[i] = y[i];
+            y[i] = tmp;
+        }
+    }
+}
+
+static esp_err_t esp_lcd_touch_update_isr(esp_lcd_touch_handle_t tp)
+{
+    esp_err_t ret = ESP_OK;
+
+    /* One GPIO ISR handler serves the user callback and the reader task */
+    if (tp->config.interrupt_callback != NULL || tp->sampler != NULL) {
         ret = gpio_install_isr_service(0);
         /* ISR service can be installed from user before, then it returns invalid state */
         if (ret != ESP_OK && ret != ESP_ERR_INVALID_STATE) {
@@ -244,7 +781,7 @@ esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, e
         /* Add GPIO ISR handler */
         ret = gpio_intr_enable(tp->config.int_gpio_num);
         ESP_RETURN_ON_ERROR(ret, TAG, "GPIO ISR install failed");
-        ret = gpio_isr_handler_add(tp->config.int_gpio_num, (gpio_isr_t)tp->config.interrupt_callback, tp);
+        ret = gpio_isr_handler_add(tp->config.int_gpio_num, esp_lcd_touch_isr, tp);
         ESP_RETURN_ON_ERROR(ret, TAG, "GPIO ISR install failed");
     } else {
         /* Remove GPIO ISR handler */
@@ -257,10 +794,224 @@ esp_err_t esp_lcd_touch_register_interrupt_callback(esp_lcd_touch_handle_t tp, e
     return ESP_OK;
 }
 
-esp_err_t esp_lcd_touch_register_interrupt_callback_with_data(esp_lcd_touch_handle_t tp, esp_lcd_touch_interrupt_callback_t callback, void *user_data)
+static void IRAM_ATTR esp_lcd_touch_isr(void *arg)
 {
-    assert(tp != NULL);
+    esp_lcd_touch_handle_t tp = (esp_lcd_touch_handle_t)arg;
+    BaseType_t need_yield = pdFALSE;
+
+    /* Wake reader task, the sample gets the time of interrupt */
+    portENTER_CRITICAL_ISR(&tp->data.lock);
+    if (tp->sampler != NULL) {
+        tp->sampler->irq_us = esp_timer_get_time();
+        vTaskNotifyGiveFromISR(tp->sampler->task, &need_yield);
+    }
+    portEXIT_CRITICAL_ISR(&tp->data.lock);
 
-    tp->config.user_data = user_data;
-    return esp_lcd_touch_register_interrupt_callback(tp, callback);
+    if (tp->config.interrupt_callback != NULL) {
+        tp->config.interrupt_callback(tp);
+    }
+
+    if (need_yield == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+static void esp_lcd_touch_sampler_task(void *arg)
+{
+    esp_lcd_touch_sampler_t *sampler = (esp_lcd_touch_sampler_t *)arg;
+    esp_lcd_touch_handle_t tp = sampler->tp;
+    esp_lcd_touch_sample_t sample;
+    bool was_touched = false;
+    bool release_held = false;
+
+    /* Sampler is published before the first notification (or stopped, when start failed) */
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (!sampler->stop) {
+        /* Release held by the filter chain is polled, there is no interrupt after it */
+        const bool wait_irq = (sampler->use_irq && !release_held);
+        const TickType_t timeout = (wait_irq ? portMAX_DELAY : pdMS_TO_TICKS(sampler->config.poll_period_ms));
+        const bool notified = (ulTaskNotifyTake(pdTRUE, (timeout > 0 ? timeout : 1)) > 0);
+        if (sampler->stop) {
+            break;
+        }
+
+        if (tp->read_data(tp) != ESP_OK) {
+            portENTER_CRITICAL(&sampler->lock);
+            sampler->stats.read_errors++;
+            portEXIT_CRITICAL(&sampler->lock);
+            continue;
+        }
+        if (sampler->use_irq && notified) {
+            portENTER_CRITICAL(&tp->data.lock);
+            sample.timestamp_us = sampler->irq_us;
+            portEXIT_CRITICAL(&tp->data.lock);
+        } else {
+            sample.timestamp_us = esp_timer_get_time();
+        }
+        sample.points = 0;
+        if (tp->get_xy(tp, sample.x, sample.y, sample.strength, &sample.points, CONFIG_ESP_LCD_TOUCH_MAX_POINTS)) {
+            esp_lcd_touch_process_points(tp, sample.x, sample.y, sample.strength, &sample.points, CONFIG_ESP_LCD_TOUCH_MAX_POINTS);
+            esp_lcd_touch_calibrate_points(tp, sample.x, sample.y, sample.points);
+        } else {
+            sample.points = 0;
+        }
+        const uint8_t read_points = sample.points;
+        esp_lcd_touch_filter_points(tp, sample.x, sample.y, sample.strength, &sample.points, CONFIG_ESP_LCD_TOUCH_MAX_POINTS, sample.timestamp_us);
+        release_held = (read_points == 0 && sample.points > 0);
+        esp_lcd_touch_predict_points(tp, sample.x, sample.y, sample.points, sample.timestamp_us, false);
+
+        /* Released state is saved only once */
+        const bool touched = (sample.points > 0);
+        if (!touched && !was_touched) {
+            continue;
+        }
+        was_touched = touched;
+
+        portENTER_CRITICAL(&sampler->lock);
+        if (sampler->count == sampler->config.ring_size) {
+            /* Ring is full, the oldest sample is overwritten */
+            sampler->head = (sampler->head + 1) % sampler->config.ring_size;
+            sampler->count--;
+            sampler->stats.overwritten++;
+        }
+        memcpy(&sampler->ring[(sampler->head + sampler->count) % sampler->config.ring_size], &sample, sizeof(esp_lcd_touch_sample_t));
+        sampler->count++;
+        memcpy(&sampler->last, &sample, sizeof(esp_lcd_touch_sample_t));
+        sampler->stats.samples++;
+        if (sampler->count > sampler->stats.max_queued) {
+            sampler->stats.max_queued = sampler->count;
+        }
+        portEXIT_CRITICAL(&sampler->lock);
+
+        if (sampler->config.on_sample) {
+            sampler->config.on_sample(tp, sampler->config.user_data);
+        }
+    }
+
+    xSemaphoreGive(sampler->stopped);
+    vTaskDelete(NULL);
+}
+
+static esp_lcd_touch_sampler_t *esp_lcd_touch_sampler_take(esp_lcd_touch_handle_t tp)
+{
+    /* Sampler is not freed by esp_lcd_touch_sampler_stop, until it is given back */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_sampler_t *sampler = tp->sampler;
+    if (sampler != NULL) {
+        sampler->users++;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    return sampler;
+}
+
+static void esp_lcd_touch_sampler_give(esp_lcd_touch_handle_t tp, esp_lcd_touch_sampler_t *sampler)
+{
+    portENTER_CRITICAL(&tp->data.lock);
+    sampler->users--;
+    portEXIT_CRITICAL(&tp->data.lock);
+}
+
+static void esp_lcd_touch_predict_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint8_t point_num, int64_t time_us, bool predict)
+{
+    esp_lcd_touch_predict_t state;
+
+    if (tp->predict == NULL) {
+        return;
+    }
+
+    /* Float math runs on a copy, not in the critical section */
+    portENTER_CRITICAL(&tp->data.lock);
+    esp_lcd_touch_predict_t *current = tp->predict;
+    if (current != NULL) {
+        memcpy(&state, current, sizeof(esp_lcd_touch_predict_t));
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+    if (current == NULL) {
+        return;
+    }
+
+    if (predict) {
+        /* Swapped coordinates have swapped limits */
+        const bool swap = tp->config.flags.swap_xy;
+        esp_lcd_touch_predict_get(&state, x, y, point_num, time_us,
+                                  (swap ? tp->config.y_max : tp->config.x_max), (swap ? tp->config.x_max : tp->config.y_max));
+        return;
+    }
+
+    esp_lcd_touch_predict_update(&state, x, y, point_num, time_us);
+
+    /* Updates come from one reader (reader task or application), the result is dropped, when prediction was reconfigured */
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->predict == current) {
+        memcpy(current, &state, sizeof(esp_lcd_touch_predict_t));
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+}
+
+static void esp_lcd_touch_calibrate_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint8_t point_num)
+{
+    int32_t matrix[6];
+
+    if (tp->calibration == NULL || point_num == 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&tp->data.lock);
+    const esp_lcd_touch_calibration_t *cal = tp->calibration;
+    if (cal != NULL) {
+        matrix[0] = cal->a;
+        matrix[1] = cal->b;
+        matrix[2] = cal->c;
+        matrix[3] = cal->d;
+        matrix[4] = cal->e;
+        matrix[5] = cal->f;
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+    if (cal == NULL) {
+        return;
+    }
+
+    /* Swapped coordinates have swapped limits */
+    const bool swap = tp->config.flags.swap_xy;
+    esp_lcd_touch_calibration_apply(matrix, x, y, point_num, (swap ? tp->config.y_max : tp->config.x_max), (swap ? tp->config.x_max : tp->config.y_max));
+}
+
+static void esp_lcd_touch_filter_points(esp_lcd_touch_handle_t tp, uint16_t *x, uint16_t *y, uint16_t *strength, uint8_t *point_num, uint8_t max_point_num, int64_t time_us)
+{
+    uint16_t fx[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    uint16_t fy[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];
+    const uint8_t in_num = (*point_num > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : *point_num);
+    uint8_t out_num = in_num;
+
+    if (tp->filter == NULL) {
+        return;
+    }
+
+    /* Held points are written into local arrays, the caller can have less points */
+    memcpy(fx, x, in_num * sizeof(uint16_t));
+    memcpy(fy, y, in_num * sizeof(uint16_t));
+
+    portENTER_CRITICAL(&tp->data.lock);
+    if (tp->filter != NULL) {
+        const int64_t start_us = esp_timer_get_time();
+        out_num = esp_lcd_touch_filter_update(tp->filter, fx, fy, in_num, time_us);
+        const uint32_t elapsed_us = (uint32_t)(esp_timer_get_time() - start_us);
+        if (elapsed_us > tp->filter->metrics.time_max_us) {
+            tp->filter->metrics.time_max_us = elapsed_us;
+        }
+    }
+    portEXIT_CRITICAL(&tp->data.lock);
+
+    if (out_num > max_point_num) {
+        out_num = max_point_num;
+    }
+    memcpy(x, fx, out_num * sizeof(uint16_t));
+    memcpy(y, fy, out_num * sizeof(uint16_t));
+    /* Points held after release have no strength */
+    if (strength != NULL && in_num == 0) {
+        memset(strength, 0, out_num * sizeof(uint16_t));
+    }
+    *point_num = out_num;
 }
@@ -0,0 +1,122 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <math.h>
+#include "esp_lcd_touch_calibration.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static bool esp_lcd_touch_calibration_to_q16(double value, int32_t *q16);
+static uint16_t esp_lcd_touch_calibration_clamp(int64_t value, uint16_t max);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void esp_lcd_touch_calibration_fit_init(esp_lcd_touch_calibration_fit_t *fit)
+{
+    memset(fit, 0, sizeof(esp_lcd_touch_calibration_fit_t));
+}
+
+void esp_lcd_touch_calibration_fit_add(esp_lcd_touch_calibration_fit_t *fit, uint16_t raw_x, uint16_t raw_y, uint16_t x, uint16_t y)
+{
+    const int64_t rx = raw_x;
+    const int64_t ry = raw_y;
+    const int64_t t[2] = {x, y};
+
+    fit->n++;
+    fit->sx += rx;
+    fit->sy += ry;
+    fit->sxx += rx * rx;
+    fit->sxy += rx * ry;
+    fit->syy += ry * ry;
+    for (int i = 0; i < 2; i++) {
+        fit->st[i] += t[i];
+        fit->sxt[i] += rx * t[i];
+        fit->syt[i] += ry * t[i];
+    }
+}
+
+esp_lcd_touch_calibration_fit_result_t esp_lcd_touch_calibration_fit_solve(const esp_lcd_touch_calibration_fit_t *fit, int32_t matrix[6])
+{
+    int32_t result[6];
+
+    if (fit->n < 3) {
+        return ESP_LCD_TOUCH_CALIBRATION_FIT_FEW_POINTS;
+    }
+
+    /* Least squares of t = a * x + b * y + c, sums centered to the mean point and scaled by n (exact in integers) */
+    const int64_t n = fit->n;
+    const double sxx = (double)(n * fit->sxx - fit->sx * fit->sx);
+    const double sxy = (double)(n * fit->sxy - fit->sx * fit->sy);
+    const double syy = (double)(n * fit->syy - fit->sy * fit->sy);
+
+    /* Points on one line do not define the transform */
+    const double det = sxx * syy - sxy * sxy;
+    if (!(det > 1e-6 * sxx * syy)) {
+        return ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        const double sxt = (double)(n * fit->sxt[i] - fit->sx * fit->st[i]);
+        const double syt = (double)(n * fit->syt[i] - fit->sy * fit->st[i]);
+        const double a = (sxt * syy - syt * sxy) / det;
+        const double b = (syt * sxx - sxt * sxy) / det;
+        const double c = ((double)fit->st[i] - a * (double)fit->sx - b * (double)fit->sy) / (double)n;
+        if (!esp_lcd_touch_calibration_to_q16(a, &result[i * 3]) ||
+                !esp_lcd_touch_calibration_to_q16(b, &result[i * 3 + 1]) ||
+                !esp_lcd_touch_calibration_to_q16(c, &result[i * 3 + 2])) {
+            return ESP_LCD_TOUCH_CALIBRATION_FIT_RANGE;
+        }
+    }
+    memcpy(matrix, result, sizeof(result));
+
+    return ESP_LCD_TOUCH_CALIBRATION_FIT_OK;
+}
+
+void esp_lcd_touch_calibration_apply(const int32_t matrix[6], uint16_t *x, uint16_t *y, uint8_t cnt, uint16_t x_max, uint16_t y_max)
+{
+    for (int i = 0; i < cnt; i++) {
+        const int64_t rx = x[i];
+        const int64_t ry = y[i];
+        /* Rounded to nearest, halves up (shift of negative value is floor) */
+        const int64_t cx = (matrix[0] * rx + matrix[1] * ry + matrix[2] + (1 << 15)) >> 16;
+        const int64_t cy = (matrix[3] * rx + matrix[4] * ry + matrix[5] + (1 << 15)) >> 16;
+        x[i] = esp_lcd_touch_calibration_clamp(cx, x_max);
+        y[i] = esp_lcd_touch_calibration_clamp(cy, y_max);
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static bool esp_lcd_touch_calibration_to_q16(double value, int32_t *q16)
+{
+    const double scaled = value * 65536.0;
+
+    if (!(fabs(scaled) < (double)INT32_MAX)) {
+        return false;
+    }
+    *q16 = (int32_t)lround(scaled);
+
+    return true;
+}
+
+static uint16_t esp_lcd_touch_calibration_clamp(int64_t value, uint16_t max)
+{
+    if (value < 0) {
+        return 0;
+    }
+    if (value > max) {
+        return max;
+    }
+
+    return (uint16_t)value;
+}
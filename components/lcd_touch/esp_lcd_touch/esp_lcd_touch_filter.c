@@ -0,0 +1,163 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <stdlib.h>
+#include "esp_lcd_touch_filter.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint16_t esp_lcd_touch_filter_median(const uint16_t *hist, uint8_t count);
+static uint16_t esp_lcd_touch_filter_dead_zone(uint16_t in, uint16_t out, uint16_t dead_zone);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void esp_lcd_touch_filter_init(esp_lcd_touch_filter_t *filter, const esp_lcd_touch_filter_cfg_t *cfg)
+{
+    memset(filter, 0, sizeof(esp_lcd_touch_filter_t));
+    filter->cfg = *cfg;
+    if (filter->cfg.median > ESP_LCD_TOUCH_FILTER_MEDIAN_MAX) {
+        filter->cfg.median = ESP_LCD_TOUCH_FILTER_MEDIAN_MAX;
+    }
+}
+
+uint8_t esp_lcd_touch_filter_update(esp_lcd_touch_filter_t *filter, uint16_t *x, uint16_t *y, uint8_t cnt, int64_t time_us)
+{
+    const esp_lcd_touch_filter_cfg_t *cfg = &filter->cfg;
+
+    if (cnt > ESP_LCD_TOUCH_FILTER_POINTS_MAX) {
+        cnt = ESP_LCD_TOUCH_FILTER_POINTS_MAX;
+    }
+
+    /* Release debounce, the last points are reported until no touch lasts release_us */
+    if (cnt == 0) {
+        if (filter->points > 0 && cfg->release_us > 0) {
+            if (!filter->releasing) {
+                filter->releasing = true;
+                filter->release_start_us = time_us;
+            }
+            if (time_us - filter->release_start_us < (int64_t)cfg->release_us) {
+                for (int i = 0; i < filter->points; i++) {
+                    x[i] = filter->point[i].x;
+                    y[i] = filter->point[i].y;
+                }
+                return filter->points;
+            }
+        }
+        filter->releasing = false;
+        filter->points = 0;
+        return 0;
+    }
+
+    /* Touch came back during release debounce, or it is a new press without read after the release time */
+    if (filter->releasing) {
+        filter->releasing = false;
+        if (time_us - filter->release_start_us < (int64_t)cfg->release_us) {
+            filter->metrics.releases_held++;
+        } else {
+            filter->points = 0;
+        }
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        typeof(filter->point[0]) *p = &filter->point[i];
+        const bool first = (i >= filter->points);
+        const uint16_t raw_x = x[i];
+        const uint16_t raw_y = y[i];
+
+        if (first) {
+            p->hist_count = 0;
+            p->hist_pos = 0;
+        }
+
+        /* Median of the newest points removes spikes */
+        if (cfg->median > 1) {
+            p->hist_x[p->hist_pos] = raw_x;
+            p->hist_y[p->hist_pos] = raw_y;
+            p->hist_pos = (p->hist_pos + 1) % cfg->median;
+            if (p->hist_count < cfg->median) {
+                p->hist_count++;
+            }
+            x[i] = esp_lcd_touch_filter_median(p->hist_x, p->hist_count);
+            y[i] = esp_lcd_touch_filter_median(p->hist_y, p->hist_count);
+        }
+
+        /* Exponential smoothing in Q8 */
+        if (first) {
+            p->smooth_x = (int32_t)x[i] << 8;
+            p->smooth_y = (int32_t)y[i] << 8;
+        } else if (cfg->smooth > 0) {
+            p->smooth_x += (((int32_t)x[i] << 8) - p->smooth_x) * cfg->smooth / 256;
+            p->smooth_y += (((int32_t)y[i] << 8) - p->smooth_y) * cfg->smooth / 256;
+            x[i] = (uint16_t)((p->smooth_x + 128) >> 8);
+            y[i] = (uint16_t)((p->smooth_y + 128) >> 8);
+        }
+
+        /* Dead-zone hysteresis keeps the output still until the point moves away */
+        if (!first && cfg->dead_zone > 0) {
+            x[i] = esp_lcd_touch_filter_dead_zone(x[i], p->x, cfg->dead_zone);
+            y[i] = esp_lcd_touch_filter_dead_zone(y[i], p->y, cfg->dead_zone);
+        }
+
+        if (i == 0) {
+            esp_lcd_touch_filter_metrics_t *metrics = &filter->metrics;
+            if (!first) {
+                metrics->path_raw += abs(raw_x - p->raw_x) + abs(raw_y - p->raw_y);
+                metrics->path_filtered += abs(x[0] - p->x) + abs(y[0] - p->y);
+            }
+            const uint32_t lag = abs(raw_x - x[0]) + abs(raw_y - y[0]);
+            metrics->lag_sum += lag;
+            if (lag > metrics->lag_max) {
+                metrics->lag_max = (uint16_t)(lag > UINT16_MAX ? UINT16_MAX : lag);
+            }
+            metrics->samples++;
+        }
+
+        p->x = x[i];
+        p->y = y[i];
+        p->raw_x = raw_x;
+        p->raw_y = raw_y;
+    }
+    filter->points = cnt;
+
+    return cnt;
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint16_t esp_lcd_touch_filter_median(const uint16_t *hist, uint8_t count)
+{
+    uint16_t sorted[ESP_LCD_TOUCH_FILTER_MEDIAN_MAX];
+
+    /* Insertion sort of at most ESP_LCD_TOUCH_FILTER_MEDIAN_MAX values */
+    for (int i = 0; i < count; i++) {
+        int j = i;
+        while (j > 0 && sorted[j - 1] > hist[i]) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = hist[i];
+    }
+
+    return sorted[count / 2];
+}
+
+static uint16_t esp_lcd_touch_filter_dead_zone(uint16_t in, uint16_t out, uint16_t dead_zone)
+{
+    if (in > out + dead_zone) {
+        return in - dead_zone;
+    }
+    if (in + dead_zone < out) {
+        return in + dead_zone;
+    }
+    return out;
+}
@@ -0,0 +1,134 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <math.h>
+#include "esp_lcd_touch_predict.h"
+
+/*******************************************************************************
+* Function definitions
+*******************************************************************************/
+
+static uint16_t esp_lcd_touch_predict_clamp(float value, uint16_t max);
+
+/*******************************************************************************
+* Public API functions
+*******************************************************************************/
+
+void esp_lcd_touch_predict_init(esp_lcd_touch_predict_t *predict, const esp_lcd_touch_predict_cfg_t *cfg)
+{
+    memset(predict, 0, sizeof(esp_lcd_touch_predict_t));
+    predict->cfg = *cfg;
+}
+
+void esp_lcd_touch_predict_update(esp_lcd_touch_predict_t *predict, const uint16_t *x, const uint16_t *y, uint8_t cnt, int64_t time_us)
+{
+    const esp_lcd_touch_predict_cfg_t *cfg = &predict->cfg;
+
+    if (cnt > ESP_LCD_TOUCH_PREDICT_POINTS_MAX) {
+        cnt = ESP_LCD_TOUCH_PREDICT_POINTS_MAX;
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        typeof(predict->point[0]) *p = &predict->point[i];
+        const int64_t dt_us = time_us - p->time_us;
+        bool reset = (i >= predict->points || p->updates == 0 || dt_us > (int64_t)cfg->reset_us);
+
+        if (!reset && dt_us <= 0) {
+            /* The same read again, only position is smoothed */
+            p->x += cfg->alpha * ((float)x[i] - p->x);
+            p->y += cfg->alpha * ((float)y[i] - p->y);
+            continue;
+        }
+
+        if (!reset) {
+            const float dt = (float)dt_us / 1000.0f;
+            const float px = p->x + p->vx * dt;
+            const float py = p->y + p->vy * dt;
+            const float rx = (float)x[i] - px;
+            const float ry = (float)y[i] - py;
+
+            /* Other finger at the same index (or a big jump) starts again */
+            if (cfg->reset_dist > 0 && (rx * rx + ry * ry) > (float)cfg->reset_dist * (float)cfg->reset_dist) {
+                reset = true;
+            } else if (p->updates == 1) {
+                /* Velocity of the first two points */
+                p->vx = ((float)x[i] - p->x) / dt;
+                p->vy = ((float)y[i] - p->y) / dt;
+                p->x = x[i];
+                p->y = y[i];
+            } else {
+                p->x = px + cfg->alpha * rx;
+                p->y = py + cfg->alpha * ry;
+                p->vx += cfg->beta * rx / dt;
+                p->vy += cfg->beta * ry / dt;
+            }
+        }
+
+        if (reset) {
+            p->x = x[i];
+            p->y = y[i];
+            p->vx = 0;
+            p->vy = 0;
+            p->updates = 0;
+        }
+        p->time_us = time_us;
+        if (p->updates < UINT8_MAX) {
+            p->updates++;
+        }
+    }
+
+    for (int i = cnt; i < predict->points; i++) {
+        predict->point[i].updates = 0;
+    }
+    predict->points = cnt;
+}
+
+void esp_lcd_touch_predict_get(const esp_lcd_touch_predict_t *predict, uint16_t *x, uint16_t *y, uint8_t cnt, int64_t now_us,
+                               uint16_t x_max, uint16_t y_max)
+{
+    const esp_lcd_touch_predict_cfg_t *cfg = &predict->cfg;
+
+    if (cnt > predict->points) {
+        cnt = predict->points;
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        const typeof(predict->point[0]) *p = &predict->point[i];
+        float dx = 0;
+        float dy = 0;
+
+        if (p->updates >= 2) {
+            /* Extrapolate from the newest point to the time ahead of now */
+            const float lead = (float)(now_us - p->time_us + (int64_t)cfg->lead_us) / 1000.0f;
+            dx = p->vx * lead;
+            dy = p->vy * lead;
+            const float dist = sqrtf(dx * dx + dy * dy);
+            if (cfg->max_lead > 0 && dist > (float)cfg->max_lead) {
+                dx *= (float)cfg->max_lead / dist;
+                dy *= (float)cfg->max_lead / dist;
+            }
+        }
+
+        x[i] = esp_lcd_touch_predict_clamp(p->x + dx, x_max);
+        y[i] = esp_lcd_touch_predict_clamp(p->y + dy, y_max);
+    }
+}
+
+/*******************************************************************************
+* Private functions
+*******************************************************************************/
+
+static uint16_t esp_lcd_touch_predict_clamp(float value, uint16_t max)
+{
+    if (value <= 0.0f) {
+        return 0;
+    }
+    if (value >= (float)max) {
+        return max;
+    }
+    return (uint16_t)(value + 0.5f);
+}
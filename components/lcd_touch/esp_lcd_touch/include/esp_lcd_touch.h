@@ -88,6 +88,160 @@ typedef struct {
     portMUX_TYPE lock; /*!< Lock for read/write */
 } esp_lcd_touch_data_t;
 
+/**
+ * @brief Sample ring and reader task are available (esp_lcd_touch_sampler_start, esp_lcd_touch_get_sample)
+ *
+ * @note Defined from version 1.2.0, components which also accept older versions test it before using the sampler
+ *
+ */
+#define ESP_LCD_TOUCH_SAMPLER_SUPPORTED 1
+
+/**
+ * @brief Timestamped touch sample (processed coordinates)
+ *
+ */
+typedef struct {
+    int64_t timestamp_us;   /*!< Time of touch interrupt, or of read without interrupt pin (esp_timer_get_time) */
+    uint8_t points;         /*!< Count of touch points, 0 when released */
+    uint16_t x[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];        /*!< X coordinates */
+    uint16_t y[CONFIG_ESP_LCD_TOUCH_MAX_POINTS];        /*!< Y coordinates */
+    uint16_t strength[CONFIG_ESP_LCD_TOUCH_MAX_POINTS]; /*!< Strengths */
+} esp_lcd_touch_sample_t;
+
+/**
+ * @brief Callback called from reader task after a new sample is saved into the ring
+ *
+ */
+typedef void (*esp_lcd_touch_sample_callback_t)(esp_lcd_touch_handle_t tp, void *user_data);
+
+/**
+ * @brief Sample ring and reader task configuration
+ *
+ */
+typedef struct {
+    uint16_t ring_size;         /*!< Count of samples in ring, the oldest sample is overwritten when the ring is full */
+    uint32_t poll_period_ms;    /*!< Read period, when the interrupt pin is not used (0: 10 ms) */
+    int task_priority;          /*!< Reader task priority (0: 5) */
+    uint32_t task_stack;        /*!< Reader task stack size (0: 3072) */
+    int task_affinity;          /*!< Reader task pinned to core (-1 is no affinity) */
+    esp_lcd_touch_sample_callback_t on_sample; /*!< Called after each saved sample (can be NULL) */
+    void *user_data;            /*!< User data passed to on_sample */
+} esp_lcd_touch_sampler_config_t;
+
+/**
+ * @brief Statistics of sample ring
+ *
+ */
+typedef struct {
+    uint32_t samples;       /*!< Count of saved samples */
+    uint32_t overwritten;   /*!< Count of samples overwritten before they were taken */
+    uint32_t read_errors;   /*!< Count of failed reads from touch controller */
+    uint16_t max_queued;    /*!< Maximum count of samples waiting in ring */
+} esp_lcd_touch_sampler_stats_t;
+
+/**
+ * @brief Sample ring and reader task (private)
+ *
+ */
+typedef struct esp_lcd_touch_sampler_s esp_lcd_touch_sampler_t;
+
+/**
+ * @brief Motion prediction configuration
+ *
+ * Each point is filtered by alpha-beta filter (position and velocity) and extrapolated to the time ahead of the read.
+ * Lower alpha and beta give smoother but slower estimate.
+ *
+ */
+typedef struct {
+    float alpha;            /*!< Position gain (0 .. 1) */
+    float beta;             /*!< Velocity gain (0 .. 2) */
+    uint32_t lead_ms;       /*!< Prediction time ahead of the read, usually latency of the display (render and flush) */
+    uint16_t max_lead;      /*!< Maximum distance of predicted point from the filtered position (pixels, 0: no limit) */
+    uint16_t jump_dist;     /*!< Filter of a point starts again, when it is further from the estimate (pixels, 0: never) */
+    uint32_t reset_ms;      /*!< Velocity starts again after a longer gap between reads (0: 100 ms) */
+} esp_lcd_touch_predict_config_t;
+
+/**
+ * @brief Motion prediction configuration, scored by the replay tool (test_apps/replay) for 60 Hz display
+ *
+ */
+#define ESP_LCD_TOUCH_PREDICT_CONFIG()  \
+    {                                   \
+        .alpha = 0.7f,                  \
+        .beta = 0.2f,                   \
+        .lead_ms = 16,                  \
+        .max_lead = 40,                 \
+        .jump_dist = 100,               \
+        .reset_ms = 100,                \
+    }
+
+/**
+ * @brief Noise filter chain configuration, stages are applied in this order
+ *
+ */
+typedef struct {
+    uint8_t median;         /*!< Window of median filter removing spikes, odd (0 or 1: off, max 7) */
+    uint8_t smooth;         /*!< Weight of a new point in exponential smoothing in 1/256 (0: off) */
+    uint16_t dead_zone;     /*!< Reported point moves only when the point is further on an axis (pixels, 0: off) */
+    uint32_t release_ms;    /*!< Release is reported after no touch this long, shorter releases are ignored (0: off) */
+} esp_lcd_touch_filter_config_t;
+
+/**
+ * @brief Noise filter chain is available (esp_lcd_touch_set_filter, esp_lcd_touch_release_pending)
+ *
+ */
+#define ESP_LCD_TOUCH_FILTER_SUPPORTED 1
+
+/**
+ * @brief Default noise filter chain configuration for resistive and low cost capacitive controllers
+ *
+ */
+#define ESP_LCD_TOUCH_FILTER_CONFIG()   \
+    {                                   \
+        .median = 3,                    \
+        .smooth = 128,                  \
+        .dead_zone = 2,                 \
+        .release_ms = 30,               \
+    }
+
+/**
+ * @brief Jitter and latency metrics of the noise filter chain (the first point)
+ *
+ */
+typedef struct {
+    uint32_t samples;       /*!< Count of reads with touch */
+    uint32_t releases_held; /*!< Count of releases shorter than release_ms (touch came back) */
+    uint32_t path_raw;      /*!< Sum of moves of the raw point (pixels, |dx| + |dy|) */
+    uint32_t path_filtered; /*!< Sum of moves of the filtered point, path_filtered / path_raw of a held finger is the jitter left */
+    uint32_t lag_sum;       /*!< Sum of distances between the raw and the filtered point, lag_sum / samples is the mean lag */
+    uint16_t lag_max;       /*!< Maximum distance between the raw and the filtered point */
+    uint32_t time_max_us;   /*!< Maximum time of the filter chain for one read */
+} esp_lcd_touch_filter_stats_t;
+
+/**
+ * @brief Calibration matrix, affine transform in Q16 fixed point (the last row of 3x3 matrix is 0, 0, 1)
+ *
+ */
+typedef struct {
+    int32_t a;  /*!< x' = a * x + b * y + c */
+    int32_t b;
+    int32_t c;
+    int32_t d;  /*!< y' = d * x + e * y + f */
+    int32_t e;
+    int32_t f;
+} esp_lcd_touch_calibration_t;
+
+/**
+ * @brief Calibration point, target on the display and the point read when it was touched
+ *
+ */
+typedef struct {
+    uint16_t raw_x; /*!< X coordinate read from touch (esp_lcd_touch_calibration_capture) */
+    uint16_t raw_y; /*!< Y coordinate read from touch */
+    uint16_t x;     /*!< X coordinate of the target on the display */
+    uint16_t y;     /*!< Y coordinate of the target on the display */
+} esp_lcd_touch_calibration_point_t;
+
 /**
  * @brief Declare of Touch Type
  *
@@ -253,6 +407,26 @@ struct esp_lcd_touch_s {
      * @brief Data structure
      */
     esp_lcd_touch_data_t data;
+
+    /**
+     * @brief Sample ring filled by reader task (NULL when not started)
+     */
+    esp_lcd_touch_sampler_t *sampler;
+
+    /**
+     * @brief Motion prediction state (NULL when disabled)
+     */
+    struct esp_lcd_touch_predict_s *predict;
+
+    /**
+     * @brief Calibration matrix (NULL when not calibrated)
+     */
+    esp_lcd_touch_calibration_t *calibration;
+
+    /**
+     * @brief Noise filter chain state (NULL when disabled)
+     */
+    struct esp_lcd_touch_filter_s *filter;
 };
 
 /**
@@ -424,6 +598,217 @@ esp_err_t esp_lcd_touch_enter_sleep(esp_lcd_touch_handle_t tp);
  */
 esp_err_t esp_lcd_touch_exit_sleep(esp_lcd_touch_handle_t tp);
 
+/**
+ * @brief Start reader task filling timestamped samples into ring
+ *
+ * The reader task reads the touch controller after each touch interrupt (or periodically without interrupt pin)
+ * and saves processed coordinates with the timestamp. Released state is saved once after the last touch.
+ * While running, esp_lcd_touch_read_data does not access the bus and esp_lcd_touch_get_coordinates returns the newest
+ * sample.
+ *
+ * @param tp: Touch handler
+ * @param config: Sample ring and reader task configuration
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if parameter is invalid
+ *      - ESP_ERR_INVALID_STATE     if already started
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t esp_lcd_touch_sampler_start(esp_lcd_touch_handle_t tp, const esp_lcd_touch_sampler_config_t *config);
+
+/**
+ * @brief Stop reader task and free sample ring
+ *
+ * @note Reads running in other tasks (esp_lcd_touch_get_sample, esp_lcd_touch_get_coordinates) are finished before
+ *       the ring is freed, later reads see a stopped sampler.
+ *
+ * @param tp: Touch handler
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if not started
+ */
+esp_err_t esp_lcd_touch_sampler_stop(esp_lcd_touch_handle_t tp);
+
+/**
+ * @brief Take the oldest sample from ring
+ *
+ * @param tp: Touch handler
+ * @param sample: Sample
+ * @param remaining: Count of samples left in ring (can be NULL)
+ *
+ * @return
+ *      - Returns true, when a sample was taken. Otherwise returns false (empty ring or not started).
+ */
+bool esp_lcd_touch_get_sample(esp_lcd_touch_handle_t tp, esp_lcd_touch_sample_t *sample, uint16_t *remaining);
+
+/**
+ * @brief Get statistics of sample ring
+ *
+ * @param tp: Touch handler
+ * @param stats: Statistics
+ * @param reset: Reset statistics after reading
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if not started
+ */
+esp_err_t esp_lcd_touch_sampler_get_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_sampler_stats_t *stats, bool reset);
+
+/**
+ * @brief Enable motion prediction of touch points
+ *
+ * Every read (or sample of reader task) updates the filter. esp_lcd_touch_get_coordinates then returns points
+ * extrapolated lead_ms ahead of the call, clamped to x_max and y_max.
+ *
+ * @note Samples taken by esp_lcd_touch_get_sample are not predicted, they keep the recorded positions and times.
+ *       Prediction and reading of the sample ring (e.g. LVGL port with sampler) are mutually exclusive.
+ *
+ * @param tp: Touch handler
+ * @param config: Motion prediction configuration (NULL: disable prediction)
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if parameter is invalid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t esp_lcd_touch_set_prediction(esp_lcd_touch_handle_t tp, const esp_lcd_touch_predict_config_t *config);
+
+/**
+ * @brief Compute calibration matrix from touched targets
+ *
+ * Three points give exact transform, more points (e.g. five: four corners and center) are fitted by least squares.
+ *
+ * @param points: Calibration points (at least three, not on one line)
+ * @param count: Count of calibration points
+ * @param calibration: Computed calibration matrix
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if less than three points or the points are on one line
+ */
+esp_err_t esp_lcd_touch_calibration_compute(const esp_lcd_touch_calibration_point_t *points, uint8_t count, esp_lcd_touch_calibration_t *calibration);
+
+/**
+ * @brief Set calibration matrix
+ *
+ * The matrix is applied to all points after processing (user callback, mirror and swap) and the result is clamped
+ * to x_max and y_max.
+ *
+ * @param tp: Touch handler
+ * @param calibration: Calibration matrix (NULL: no calibration)
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t esp_lcd_touch_set_calibration(esp_lcd_touch_handle_t tp, const esp_lcd_touch_calibration_t *calibration);
+
+/**
+ * @brief Get calibration matrix
+ *
+ * @param tp: Touch handler
+ * @param calibration: Calibration matrix
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_FOUND         if not calibrated
+ */
+esp_err_t esp_lcd_touch_get_calibration(esp_lcd_touch_handle_t tp, esp_lcd_touch_calibration_t *calibration);
+
+/**
+ * @brief Wait for touch of a calibration target and save the averaged point without calibration
+ *
+ * The touch is read every 10 ms. The first reads after press are skipped and the rest is averaged until release.
+ * The sampler must not run and no interrupt callback may be registered. Other reads of the touch (e.g. LVGL input
+ * polled by esp_lvgl_port) must be paused during capture, they would take the reads and points of this function.
+ *
+ * @param tp: Touch handler
+ * @param point: Calibration point, raw_x and raw_y are filled
+ * @param timeout_ms: Timeout of press and release
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if sampler is running or interrupt callback is registered
+ *      - ESP_ERR_TIMEOUT           if the target was not touched and released in time
+ */
+esp_err_t esp_lcd_touch_calibration_capture(esp_lcd_touch_handle_t tp, esp_lcd_touch_calibration_point_t *point, uint32_t timeout_ms);
+
+/**
+ * @brief Save calibration matrix into NVS
+ *
+ * @note NVS flash must be initialized (nvs_flash_init).
+ *
+ * @param tp: Touch handler
+ * @param key: NVS key (e.g. name of the touch controller)
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NOT_FOUND         if not calibrated
+ *      - Error of NVS
+ */
+esp_err_t esp_lcd_touch_calibration_save(esp_lcd_touch_handle_t tp, const char *key);
+
+/**
+ * @brief Load calibration matrix from NVS and set it
+ *
+ * @note NVS flash must be initialized (nvs_flash_init).
+ *
+ * @param tp: Touch handler
+ * @param key: NVS key
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_NVS_NOT_FOUND     if the matrix was not saved
+ *      - ESP_ERR_INVALID_SIZE      if the saved data is not a matrix
+ *      - Error of NVS
+ */
+esp_err_t esp_lcd_touch_calibration_load(esp_lcd_touch_handle_t tp, const char *key);
+
+/**
+ * @brief Enable noise filter chain
+ *
+ * Points are filtered after processing and calibration by median, exponential smoothing, dead-zone and release
+ * debounce (before motion prediction). Each read takes bounded time (at most 7 values sorted per axis and point).
+ *
+ * @param tp: Touch handler
+ * @param config: Filter chain configuration (NULL: disable filter)
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_ARG       if parameter is invalid
+ *      - ESP_ERR_NO_MEM            if memory allocation fails
+ */
+esp_err_t esp_lcd_touch_set_filter(esp_lcd_touch_handle_t tp, const esp_lcd_touch_filter_config_t *config);
+
+/**
+ * @brief Get jitter and latency metrics of noise filter chain
+ *
+ * @param tp: Touch handler
+ * @param stats: Metrics
+ * @param reset: Reset metrics after reading
+ *
+ * @return
+ *      - ESP_OK                    on success
+ *      - ESP_ERR_INVALID_STATE     if filter is not enabled
+ */
+esp_err_t esp_lcd_touch_get_filter_stats(esp_lcd_touch_handle_t tp, esp_lcd_touch_filter_stats_t *stats, bool reset);
+
+/**
+ * @brief Check, if noise filter chain holds a release
+ *
+ * While release debounce runs, esp_lcd_touch_get_coordinates returns the last points. No touch interrupt comes after
+ * the release, so the user reading after touch interrupts (without the sampler) must read again, until this returns
+ * false. The reader task of the sampler polls by itself.
+ *
+ * @param tp: Touch handler
+ *
+ * @return
+ *      - Returns true, when the last read reported held points and the release is not reported yet
+ */
+bool esp_lcd_touch_release_pending(esp_lcd_touch_handle_t tp);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,88 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LCD touch calibration (least squares fit and apply of affine transform in Q16)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Result of calibration fit
+ */
+typedef enum {
+    ESP_LCD_TOUCH_CALIBRATION_FIT_OK = 0,
+    ESP_LCD_TOUCH_CALIBRATION_FIT_FEW_POINTS,   /* Less than three points */
+    ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR,    /* Points are on one line */
+    ESP_LCD_TOUCH_CALIBRATION_FIT_RANGE,        /* Coefficient does not fit into Q16 */
+} esp_lcd_touch_calibration_fit_result_t;
+
+/**
+ * @brief Sums of calibration points (integer sums are exact for up to 255 points of 16 bits)
+ */
+typedef struct {
+    uint32_t n;             /* Count of points */
+    int64_t  sx;            /* Sums of raw coordinates */
+    int64_t  sy;
+    int64_t  sxx;
+    int64_t  sxy;
+    int64_t  syy;
+    int64_t  st[2];         /* Sums with target coordinate, [0]: x, [1]: y */
+    int64_t  sxt[2];
+    int64_t  syt[2];
+} esp_lcd_touch_calibration_fit_t;
+
+/**
+ * @brief Initialize calibration fit
+ *
+ * @param fit       Sums of calibration points
+ */
+void esp_lcd_touch_calibration_fit_init(esp_lcd_touch_calibration_fit_t *fit);
+
+/**
+ * @brief Add calibration point
+ *
+ * @param fit       Sums of calibration points
+ * @param raw_x     X coordinate read from touch
+ * @param raw_y     Y coordinate read from touch
+ * @param x         X coordinate of the target
+ * @param y         Y coordinate of the target
+ */
+void esp_lcd_touch_calibration_fit_add(esp_lcd_touch_calibration_fit_t *fit, uint16_t raw_x, uint16_t raw_y, uint16_t x, uint16_t y);
+
+/**
+ * @brief Compute matrix by least squares (exact for three points)
+ *
+ * @param fit       Sums of calibration points
+ * @param matrix    Matrix in Q16: x' = m[0] * x + m[1] * y + m[2], y' = m[3] * x + m[4] * y + m[5]
+ *
+ * @return Result, matrix is written only on ESP_LCD_TOUCH_CALIBRATION_FIT_OK
+ */
+esp_lcd_touch_calibration_fit_result_t esp_lcd_touch_calibration_fit_solve(const esp_lcd_touch_calibration_fit_t *fit, int32_t matrix[6]);
+
+/**
+ * @brief Apply matrix to points, results are rounded to nearest and clamped
+ *
+ * @param matrix    Matrix in Q16
+ * @param x         Positions on x-axis
+ * @param y         Positions on y-axis
+ * @param cnt       Count of points
+ * @param x_max     Maximum of x coordinate
+ * @param y_max     Maximum of y coordinate
+ */
+void esp_lcd_touch_calibration_apply(const int32_t matrix[6], uint16_t *x, uint16_t *y, uint8_t cnt, uint16_t x_max, uint16_t y_max);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,103 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LCD touch noise filter chain (median, smoothing, dead-zone, release debounce)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum count of filtered points (maximum of CONFIG_ESP_LCD_TOUCH_MAX_POINTS)
+ */
+#define ESP_LCD_TOUCH_FILTER_POINTS_MAX     (10)
+
+/**
+ * @brief Maximum window of median filter
+ */
+#define ESP_LCD_TOUCH_FILTER_MEDIAN_MAX     (7)
+
+/**
+ * @brief Filter chain configuration, stages are applied in this order
+ */
+typedef struct {
+    uint8_t  median;        /* Window of median filter, odd (0 or 1: off, max ESP_LCD_TOUCH_FILTER_MEDIAN_MAX) */
+    uint8_t  smooth;        /* Weight of a new point in exponential smoothing in 1/256 (0: off) */
+    uint16_t dead_zone;     /* Output moves only when the point is further on an axis (pixels, 0: off) */
+    uint32_t release_us;    /* Release is reported after no touch this long (0: off) */
+} esp_lcd_touch_filter_cfg_t;
+
+/**
+ * @brief Jitter and latency metrics of the first point
+ */
+typedef struct {
+    uint32_t samples;           /* Count of reads with touch */
+    uint32_t releases_held;     /* Count of releases shorter than release_us (touch came back) */
+    uint32_t path_raw;          /* Sum of moves of the raw point (pixels, |dx| + |dy|) */
+    uint32_t path_filtered;     /* Sum of moves of the filtered point */
+    uint32_t lag_sum;           /* Sum of distances between the raw and the filtered point */
+    uint16_t lag_max;           /* Maximum distance between the raw and the filtered point */
+    uint32_t time_max_us;       /* Maximum time of one update (measured by the caller) */
+} esp_lcd_touch_filter_metrics_t;
+
+/**
+ * @brief Filter chain state
+ */
+typedef struct esp_lcd_touch_filter_s {
+    esp_lcd_touch_filter_cfg_t cfg;
+    uint8_t points;             /* Count of reported points, 0 when released */
+    bool    releasing;          /* No touch since release_start_us, the last points are reported */
+    int64_t release_start_us;
+    struct {
+        uint16_t hist_x[ESP_LCD_TOUCH_FILTER_MEDIAN_MAX];  /* The newest raw points for median filter */
+        uint16_t hist_y[ESP_LCD_TOUCH_FILTER_MEDIAN_MAX];
+        uint8_t  hist_count;
+        uint8_t  hist_pos;      /* Index of the next point in history */
+        int32_t  smooth_x;      /* Smoothed position (Q8) */
+        int32_t  smooth_y;
+        uint16_t x;             /* Reported position */
+        uint16_t y;
+        uint16_t raw_x;         /* The last raw position (for metrics) */
+        uint16_t raw_y;
+    } point[ESP_LCD_TOUCH_FILTER_POINTS_MAX];
+    esp_lcd_touch_filter_metrics_t metrics;
+} esp_lcd_touch_filter_t;
+
+/**
+ * @brief Initialize filter chain
+ *
+ * @param filter    Filter chain state
+ * @param cfg       Configuration
+ */
+void esp_lcd_touch_filter_init(esp_lcd_touch_filter_t *filter, const esp_lcd_touch_filter_cfg_t *cfg);
+
+/**
+ * @brief Filter points of one read in place
+ *
+ * Points are tracked by their index, new points start without history. Each point takes at most
+ * ESP_LCD_TOUCH_FILTER_MEDIAN_MAX steps of insertion sort per axis.
+ *
+ * @param filter    Filter chain state
+ * @param x         Positions on x-axis (ESP_LCD_TOUCH_FILTER_POINTS_MAX, held points are written on release)
+ * @param y         Positions on y-axis
+ * @param cnt       Count of points, 0 is released
+ * @param time_us   Time of the read
+ * @return
+ *      - Count of points to report (points of the previous read while release is debounced)
+ */
+uint8_t esp_lcd_touch_filter_update(esp_lcd_touch_filter_t *filter, uint16_t *x, uint16_t *y, uint8_t cnt, int64_t time_us);
+
+#ifdef __cplusplus
+}
+#endif
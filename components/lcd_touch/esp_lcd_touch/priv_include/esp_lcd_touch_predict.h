@@ -0,0 +1,91 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ESP LCD touch motion prediction (alpha-beta filter)
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Maximum count of predicted points (maximum of CONFIG_ESP_LCD_TOUCH_MAX_POINTS)
+ */
+#define ESP_LCD_TOUCH_PREDICT_POINTS_MAX    (10)
+
+/**
+ * @brief Motion prediction configuration
+ */
+typedef struct {
+    float    alpha;         /* Position gain (0 .. 1) */
+    float    beta;          /* Velocity gain (0 .. 2) */
+    uint32_t lead_us;       /* Prediction time ahead of the newest point */
+    uint32_t max_lead;      /* Maximum distance of predicted point from the filtered position (pixels, 0: no limit) */
+    uint32_t reset_us;      /* Velocity is reset after longer gap between points */
+    uint32_t reset_dist;    /* Filter is reset, when the point is further from the estimate (pixels, 0: never) */
+} esp_lcd_touch_predict_cfg_t;
+
+/**
+ * @brief Motion prediction state
+ */
+typedef struct esp_lcd_touch_predict_s {
+    esp_lcd_touch_predict_cfg_t cfg;
+    uint8_t points;             /* Count of tracked points, 0 when released */
+    struct {
+        float   x;              /* Filtered position */
+        float   y;
+        float   vx;             /* Velocity in pixels per millisecond */
+        float   vy;
+        int64_t time_us;        /* Time of the newest point */
+        uint8_t updates;        /* Count of points since reset (velocity is known from the second one) */
+    } point[ESP_LCD_TOUCH_PREDICT_POINTS_MAX];
+} esp_lcd_touch_predict_t;
+
+/**
+ * @brief Initialize motion prediction
+ *
+ * @param predict   Motion prediction state
+ * @param cfg       Configuration
+ */
+void esp_lcd_touch_predict_init(esp_lcd_touch_predict_t *predict, const esp_lcd_touch_predict_cfg_t *cfg);
+
+/**
+ * @brief Update filter with points of one read
+ *
+ * @note Points are tracked by their index, change of count resets the new points. Count 0 resets all points.
+ *
+ * @param predict   Motion prediction state
+ * @param x         Positions on x-axis
+ * @param y         Positions on y-axis
+ * @param cnt       Count of points
+ * @param time_us   Time of the read
+ */
+void esp_lcd_touch_predict_update(esp_lcd_touch_predict_t *predict, const uint16_t *x, const uint16_t *y, uint8_t cnt, int64_t time_us);
+
+/**
+ * @brief Get predicted positions at now_us + lead_us
+ *
+ * @param predict   Motion prediction state
+ * @param x         Predicted positions on x-axis
+ * @param y         Predicted positions on y-axis
+ * @param cnt       Count of points (only updated points are written)
+ * @param now_us    Current time
+ * @param x_max     Maximum of x coordinate
+ * @param y_max     Maximum of y coordinate
+ */
+void esp_lcd_touch_predict_get(const esp_lcd_touch_predict_t *predict, uint16_t *x, uint16_t *y, uint8_t cnt, int64_t now_us,
+                               uint16_t x_max, uint16_t y_max);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,171 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "unity.h"
+#include "esp_lcd_touch_calibration.h"
+
+/* Read point and target on the display */
+typedef struct {
+    uint16_t raw_x;
+    uint16_t raw_y;
+    uint16_t x;
+    uint16_t y;
+} test_point_t;
+
+static esp_lcd_touch_calibration_fit_result_t test_fit(const test_point_t *points, int count, int32_t *matrix)
+{
+    esp_lcd_touch_calibration_fit_t fit;
+
+    esp_lcd_touch_calibration_fit_init(&fit);
+    for (int i = 0; i < count; i++) {
+        esp_lcd_touch_calibration_fit_add(&fit, points[i].raw_x, points[i].raw_y, points[i].x, points[i].y);
+    }
+
+    return esp_lcd_touch_calibration_fit_solve(&fit, matrix);
+}
+
+TEST_CASE("Three points give exact matrix", "[calibration]")
+{
+    /* x' = 0.5 * x + 0.25 * y + 10, y' = -0.125 * x + 0.75 * y + 20 */
+    const test_point_t points[] = {
+        { 80, 160,  90, 130},
+        {800, 240, 470, 100},
+        {400, 880, 430, 630},
+    };
+    const int32_t expected[6] = {32768, 16384, 10 << 16, -8192, 49152, 20 << 16};
+    int32_t matrix[6];
+
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_OK, test_fit(points, 3, matrix));
+    TEST_ASSERT_EQUAL_INT32_ARRAY(expected, matrix, 6);
+
+    for (int i = 0; i < 3; i++) {
+        uint16_t x = points[i].raw_x;
+        uint16_t y = points[i].raw_y;
+        esp_lcd_touch_calibration_apply(matrix, &x, &y, 1, 1023, 1023);
+        TEST_ASSERT_EQUAL(points[i].x, x);
+        TEST_ASSERT_EQUAL(points[i].y, y);
+    }
+}
+
+TEST_CASE("Five noisy points give least squares matrix", "[calibration]")
+{
+    /* Resistive panel 0 .. 4095 with offset and slight rotation against display 320x240, reads with noise */
+    const uint16_t targets[5][2] = {{20, 20}, {300, 20}, {300, 220}, {20, 220}, {160, 120}};
+    const int16_t noise[5][2] = {{3, -2}, {-2, 4}, {1, -3}, {-3, 1}, {2, 2}};
+    test_point_t points[5];
+    int32_t matrix[6];
+    int32_t exact[6];
+
+    for (int i = 0; i < 5; i++) {
+        const double x = targets[i][0];
+        const double y = targets[i][1];
+        points[i].x = targets[i][0];
+        points[i].y = targets[i][1];
+        points[i].raw_x = (uint16_t)(200 + x * 11.5 + y * 0.5);
+        points[i].raw_y = (uint16_t)(300 - x * 0.25 + y * 14.5);
+    }
+    /* Reads without noise are on the affine transform */
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_OK, test_fit(points, 5, exact));
+
+    for (int i = 0; i < 5; i++) {
+        points[i].raw_x += noise[i][0];
+        points[i].raw_y += noise[i][1];
+    }
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_OK, test_fit(points, 5, matrix));
+
+    /* Noise of few raw units changes the matrix only slightly */
+    for (int i = 0; i < 6; i++) {
+        const int32_t tolerance = (i == 2 || i == 5 ? 65536 : 65);
+        TEST_ASSERT_INT32_WITHIN(tolerance, exact[i], matrix[i]);
+    }
+
+    /* Residuals are spread over all points, no target is missed by more than one pixel */
+    int32_t sum_x = 0;
+    int32_t sum_y = 0;
+    for (int i = 0; i < 5; i++) {
+        uint16_t x = points[i].raw_x;
+        uint16_t y = points[i].raw_y;
+        esp_lcd_touch_calibration_apply(matrix, &x, &y, 1, 319, 239);
+        TEST_ASSERT_INT_WITHIN(1, points[i].x, x);
+        TEST_ASSERT_INT_WITHIN(1, points[i].y, y);
+        sum_x += x - points[i].x;
+        sum_y += y - points[i].y;
+    }
+    TEST_ASSERT_INT_WITHIN(2, 0, sum_x);
+    TEST_ASSERT_INT_WITHIN(2, 0, sum_y);
+}
+
+TEST_CASE("Points on one line are rejected", "[calibration]")
+{
+    const test_point_t line[] = {
+        {100, 100,  10,  10},
+        {200, 200, 100, 100},
+        {300, 300, 200, 200},
+        {400, 400, 300, 300},
+        {250, 250, 150, 150},
+    };
+    const test_point_t same[] = {
+        {500, 500, 10, 10},
+        {500, 500, 20, 20},
+        {500, 500, 30, 30},
+    };
+    int32_t matrix[6] = {1, 2, 3, 4, 5, 6};
+    const int32_t untouched[6] = {1, 2, 3, 4, 5, 6};
+
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_FEW_POINTS, test_fit(line, 2, matrix));
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR, test_fit(line, 3, matrix));
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR, test_fit(line, 5, matrix));
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_COLLINEAR, test_fit(same, 3, matrix));
+    TEST_ASSERT_EQUAL_INT32_ARRAY(untouched, matrix, 6);
+}
+
+TEST_CASE("Matrix and points are rounded to nearest", "[calibration]")
+{
+    /* x' = x / 3, y' = 2 * y / 3: 21845.33 and 43690.67 in Q16 */
+    const test_point_t points[] = {
+        {0, 0, 0, 0},
+        {3, 0, 1, 0},
+        {0, 3, 0, 2},
+    };
+    int32_t matrix[6];
+
+    TEST_ASSERT_EQUAL(ESP_LCD_TOUCH_CALIBRATION_FIT_OK, test_fit(points, 3, matrix));
+    TEST_ASSERT_EQUAL_INT32(21845, matrix[0]);
+    TEST_ASSERT_EQUAL_INT32(0, matrix[1]);
+    TEST_ASSERT_EQUAL_INT32(0, matrix[2]);
+    TEST_ASSERT_EQUAL_INT32(0, matrix[3]);
+    TEST_ASSERT_EQUAL_INT32(43691, matrix[4]);
+    TEST_ASSERT_EQUAL_INT32(0, matrix[5]);
+
+    /* x' = 0.5 * x - 1, y' = 0.5 * y: halves are rounded up, also below zero */
+    const int32_t half[6] = {32768, 0, -65536, 0, 32768, 0};
+    const uint16_t in[] = {1, 3, 4, 5, 7};
+    const uint16_t out_x[] = {0, 1, 1, 2, 3};
+    const uint16_t out_y[] = {1, 2, 2, 3, 4};
+    for (size_t i = 0; i < sizeof(in) / sizeof(in[0]); i++) {
+        uint16_t x = in[i];
+        uint16_t y = in[i];
+        esp_lcd_touch_calibration_apply(half, &x, &y, 1, 100, 100);
+        TEST_ASSERT_EQUAL(out_x[i], x);
+        TEST_ASSERT_EQUAL(out_y[i], y);
+    }
+}
+
+TEST_CASE("Points are clamped to display", "[calibration]")
+{
+    /* x' = 2 * x - 10, y' = -y + 100 */
+    const int32_t matrix[6] = {2 << 16, 0, -(10 << 16), 0, -(1 << 16), 100 << 16};
+    uint16_t x[] = {2, 100, 200, 65535};
+    uint16_t y[] = {150, 50, 0, 65535};
+    const uint16_t out_x[] = {0, 190, 319, 319};
+    const uint16_t out_y[] = {0, 50, 100, 0};
+
+    esp_lcd_touch_calibration_apply(matrix, x, y, 4, 319, 239);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(out_x, x, 4);
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(out_y, y, 4);
+}
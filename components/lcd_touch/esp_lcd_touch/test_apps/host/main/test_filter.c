@@ -0,0 +1,195 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unity.h"
+#include "esp_lcd_touch_filter.h"
+
+#define TEST_TRACE_SAMPLES_MAX  (1024)
+
+/* One read of the touch controller, first point only */
+typedef struct {
+    int64_t  t_us;
+    uint8_t  points;
+    uint16_t x;
+    uint16_t y;
+} test_sample_t;
+
+static test_sample_t test_trace[TEST_TRACE_SAMPLES_MAX];
+
+/* Trace line: t_us,points[,x0,y0,...], '#' is comment */
+static size_t test_load_trace(const char *name)
+{
+    char path[256];
+    char line[256];
+    size_t n = 0;
+
+    snprintf(path, sizeof(path), "%s/%s", TEST_TRACE_DIR, name);
+    FILE *f = fopen(path, "r");
+    TEST_ASSERT_NOT_NULL_MESSAGE(f, path);
+    while (n < TEST_TRACE_SAMPLES_MAX && fgets(line, sizeof(line), f)) {
+        unsigned points = 0;
+        unsigned x = 0;
+        unsigned y = 0;
+        long long t = 0;
+        if (line[0] == '#' || sscanf(line, "%lld,%u,%u,%u", &t, &points, &x, &y) < 2) {
+            continue;
+        }
+        test_trace[n].t_us = t;
+        test_trace[n].points = (points > 0 ? 1 : 0);
+        test_trace[n].x = (uint16_t)x;
+        test_trace[n].y = (uint16_t)y;
+        n++;
+    }
+    fclose(f);
+
+    return n;
+}
+
+/* Replay trace through the filter, returns count of reported releases */
+static uint32_t test_replay(esp_lcd_touch_filter_t *filter, size_t count)
+{
+    uint32_t releases = 0;
+    uint8_t reported = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        int64_t t = test_trace[i].t_us;
+        do {
+            uint16_t x[ESP_LCD_TOUCH_FILTER_POINTS_MAX] = {test_trace[i].x};
+            uint16_t y[ESP_LCD_TOUCH_FILTER_POINTS_MAX] = {test_trace[i].y};
+            const uint8_t n = esp_lcd_touch_filter_update(filter, x, y, test_trace[i].points, t);
+            if (reported > 0 && n == 0) {
+                releases++;
+            }
+            reported = n;
+            /* Trace has one line per release, the touch is polled every 10 ms until the next press (or for 100 ms) */
+            t += 10000;
+        } while (test_trace[i].points == 0 && t < (i + 1 < count ? test_trace[i + 1].t_us : test_trace[i].t_us + 100000));
+    }
+
+    return releases;
+}
+
+TEST_CASE("Median removes single spikes", "[filter]")
+{
+    esp_lcd_touch_filter_t filter;
+    const esp_lcd_touch_filter_cfg_t cfg = { .median = 3 };
+    esp_lcd_touch_filter_init(&filter, &cfg);
+
+    const uint16_t in[] = {100, 101, 160, 102, 103, 40, 104};
+    const uint16_t out[] = {100, 101, 101, 102, 103, 102, 103};
+    for (size_t i = 0; i < sizeof(in) / sizeof(in[0]); i++) {
+        uint16_t x = in[i];
+        uint16_t y = 50;
+        TEST_ASSERT_EQUAL(1, esp_lcd_touch_filter_update(&filter, &x, &y, 1, i * 10000));
+        TEST_ASSERT_EQUAL(out[i], x);
+        TEST_ASSERT_EQUAL(50, y);
+    }
+}
+
+TEST_CASE("Smoothing and dead-zone keep held point still", "[filter]")
+{
+    esp_lcd_touch_filter_t filter;
+    const esp_lcd_touch_filter_cfg_t cfg = { .smooth = 128, .dead_zone = 2 };
+    esp_lcd_touch_filter_init(&filter, &cfg);
+
+    /* New press is reported without lag */
+    uint16_t x = 200;
+    uint16_t y = 100;
+    esp_lcd_touch_filter_update(&filter, &x, &y, 1, 0);
+    TEST_ASSERT_EQUAL(200, x);
+
+    /* Noise of +-2 pixels does not move the point */
+    const int16_t noise[] = {2, -2, 1, 2, -1, -2, 2, 0};
+    for (size_t i = 0; i < sizeof(noise) / sizeof(noise[0]); i++) {
+        x = 200 + noise[i];
+        y = 100 - noise[i];
+        esp_lcd_touch_filter_update(&filter, &x, &y, 1, (i + 1) * 10000);
+        TEST_ASSERT_EQUAL(200, x);
+        TEST_ASSERT_EQUAL(100, y);
+    }
+
+    /* Move is followed with lag of smoothing and dead-zone */
+    for (int i = 0; i < 10; i++) {
+        x = 300;
+        esp_lcd_touch_filter_update(&filter, &x, &y, 1, (i + 10) * 10000);
+    }
+    TEST_ASSERT_INT_WITHIN(2, 298, x);
+    TEST_ASSERT_LESS_OR_EQUAL(filter.metrics.path_raw, filter.metrics.path_filtered);
+}
+
+TEST_CASE("Release debounce holds short releases", "[filter]")
+{
+    esp_lcd_touch_filter_t filter;
+    const esp_lcd_touch_filter_cfg_t cfg = { .release_us = 30000 };
+    esp_lcd_touch_filter_init(&filter, &cfg);
+
+    uint16_t x[ESP_LCD_TOUCH_FILTER_POINTS_MAX] = {10, 20};
+    uint16_t y[ESP_LCD_TOUCH_FILTER_POINTS_MAX] = {30, 40};
+    TEST_ASSERT_EQUAL(2, esp_lcd_touch_filter_update(&filter, x, y, 2, 0));
+
+    /* Release shorter than 30 ms reports the last points */
+    memset(x, 0, sizeof(x));
+    memset(y, 0, sizeof(y));
+    TEST_ASSERT_EQUAL(2, esp_lcd_touch_filter_update(&filter, x, y, 0, 10000));
+    TEST_ASSERT_EQUAL(20, x[1]);
+    TEST_ASSERT_EQUAL(40, y[1]);
+    TEST_ASSERT_EQUAL(2, esp_lcd_touch_filter_update(&filter, x, y, 0, 30000));
+    x[0] = 11;
+    TEST_ASSERT_EQUAL(2, esp_lcd_touch_filter_update(&filter, x, y, 2, 35000));
+    TEST_ASSERT_EQUAL(1, filter.metrics.releases_held);
+
+    /* Release is reported 30 ms after the last touch */
+    TEST_ASSERT_EQUAL(2, esp_lcd_touch_filter_update(&filter, x, y, 0, 45000));
+    TEST_ASSERT_EQUAL(11, x[0]);
+    TEST_ASSERT_EQUAL(0, esp_lcd_touch_filter_update(&filter, x, y, 0, 75000));
+    TEST_ASSERT_EQUAL(0, esp_lcd_touch_filter_update(&filter, x, y, 0, 85000));
+    TEST_ASSERT_EQUAL(1, filter.metrics.releases_held);
+}
+
+TEST_CASE("Filter chain on noisy trace of held finger", "[filter]")
+{
+    esp_lcd_touch_filter_t filter;
+    const esp_lcd_touch_filter_cfg_t cfg = { .median = 3, .smooth = 128, .dead_zone = 2, .release_us = 30000 };
+    const size_t count = test_load_trace("noisy_hold.csv");
+    TEST_ASSERT_GREATER_THAN(0, count);
+
+    /* Without filter, every dropped read is a release */
+    esp_lcd_touch_filter_cfg_t off = { 0 };
+    esp_lcd_touch_filter_init(&filter, &off);
+    TEST_ASSERT_GREATER_THAN(2, test_replay(&filter, count));
+    const esp_lcd_touch_filter_metrics_t raw = filter.metrics;
+    TEST_ASSERT_EQUAL(raw.path_raw, raw.path_filtered);
+
+    /* Two presses are two releases, jitter is reduced at least 5 times, spikes do not get through */
+    esp_lcd_touch_filter_init(&filter, &cfg);
+    TEST_ASSERT_EQUAL(2, test_replay(&filter, count));
+    const esp_lcd_touch_filter_metrics_t *metrics = &filter.metrics;
+    printf("noisy_hold: path raw %u filtered %u, lag mean %u max %u, held releases %u\n", (unsigned)metrics->path_raw,
+           (unsigned)metrics->path_filtered, (unsigned)(metrics->lag_sum / metrics->samples), metrics->lag_max, (unsigned)metrics->releases_held);
+    TEST_ASSERT_LESS_THAN(metrics->path_raw / 5, metrics->path_filtered);
+    TEST_ASSERT_GREATER_THAN(0, metrics->releases_held);
+}
+
+TEST_CASE("Filter chain on noisy trace of drag", "[filter]")
+{
+    esp_lcd_touch_filter_t filter;
+    const esp_lcd_touch_filter_cfg_t cfg = { .median = 3, .smooth = 128, .dead_zone = 2, .release_us = 30000 };
+    const size_t count = test_load_trace("noisy_drag.csv");
+    TEST_ASSERT_GREATER_THAN(0, count);
+
+    esp_lcd_touch_filter_init(&filter, &cfg);
+    TEST_ASSERT_EQUAL(2, test_replay(&filter, count));
+    const esp_lcd_touch_filter_metrics_t *metrics = &filter.metrics;
+    printf("noisy_drag: path raw %u filtered %u, lag mean %u max %u, held releases %u\n", (unsigned)metrics->path_raw,
+           (unsigned)metrics->path_filtered, (unsigned)(metrics->lag_sum / metrics->samples), metrics->lag_max, (unsigned)metrics->releases_held);
+
+    /* The filtered point follows the drag with a few pixels lag, spikes of 20-40 pixels are removed */
+    TEST_ASSERT_LESS_THAN(metrics->path_raw / 2, metrics->path_filtered);
+    TEST_ASSERT_LESS_THAN(20, metrics->lag_sum / metrics->samples);
+}
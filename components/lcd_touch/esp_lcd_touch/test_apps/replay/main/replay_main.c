@@ -0,0 +1,224 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: CC0-1.0
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <dirent.h>
+#include "sdkconfig.h"
+#include "esp_lcd_touch_predict.h"
+
+#define REPLAY_SAMPLES_MAX  (4096)
+#define REPLAY_TRACES_MAX   (32)
+#define REPLAY_X_MAX        (0xFFFF)
+#define REPLAY_Y_MAX        (0xFFFF)
+
+/* One read of the touch controller */
+typedef struct {
+    int64_t  t_us;
+    uint8_t  points;
+    uint16_t x[ESP_LCD_TOUCH_PREDICT_POINTS_MAX];
+    uint16_t y[ESP_LCD_TOUCH_PREDICT_POINTS_MAX];
+} replay_sample_t;
+
+/* Filter configuration, "off" returns the read without prediction */
+typedef struct {
+    const char *name;
+    bool  predict;
+    float alpha;
+    float beta;
+} replay_cfg_t;
+
+static const replay_cfg_t replay_cfgs[] = {
+    { .name = "off" },
+    { .name = "ab 0.3/0.05", .predict = true, .alpha = 0.3f, .beta = 0.05f },
+    { .name = "ab 0.5/0.1", .predict = true, .alpha = 0.5f, .beta = 0.1f },
+    { .name = "ab 0.7/0.2", .predict = true, .alpha = 0.7f, .beta = 0.2f },
+    { .name = "ab 0.9/0.4", .predict = true, .alpha = 0.9f, .beta = 0.4f },
+};
+
+#define REPLAY_CFGS     (sizeof(replay_cfgs) / sizeof(replay_cfgs[0]))
+
+/* Error of the first point against the trace position lead_ms later (pixels) */
+typedef struct {
+    float   *errors;        /* Errors of points, which have the trace position lead_ms later */
+    uint32_t count;
+    float    stop_max;      /* Maximum distance from the release position, when the release comes before lead_ms */
+} replay_score_t;
+
+static replay_sample_t replay_samples[REPLAY_SAMPLES_MAX];
+static float replay_errors[REPLAY_CFGS][REPLAY_SAMPLES_MAX * REPLAY_TRACES_MAX];
+static replay_score_t replay_total[REPLAY_CFGS];
+
+static size_t replay_load(const char *path)
+{
+    char line[256];
+    size_t n = 0;
+    FILE *f = fopen(path, "r");
+    if (f == NULL) {
+        return 0;
+    }
+
+    while (n < REPLAY_SAMPLES_MAX && fgets(line, sizeof(line), f)) {
+        replay_sample_t *s = &replay_samples[n];
+        char *p = line;
+        if (line[0] == '#' || line[0] == '\n') {
+            continue;
+        }
+        s->t_us = strtoll(p, &p, 10);
+        s->points = (uint8_t)strtoul(p + 1, &p, 10);
+        if (s->points > ESP_LCD_TOUCH_PREDICT_POINTS_MAX) {
+            s->points = ESP_LCD_TOUCH_PREDICT_POINTS_MAX;
+        }
+        for (int i = 0; i < s->points; i++) {
+            s->x[i] = (uint16_t)strtoul(p + 1, &p, 10);
+            s->y[i] = (uint16_t)strtoul(p + 1, &p, 10);
+        }
+        n++;
+    }
+    fclose(f);
+
+    return n;
+}
+
+/* Position of the first point at time t between reads of one stroke */
+static void replay_position(size_t first, size_t last, int64_t t, float *x, float *y)
+{
+    size_t i = first;
+    while (i < last && replay_samples[i + 1].t_us <= t) {
+        i++;
+    }
+    const replay_sample_t *a = &replay_samples[i];
+    const replay_sample_t *b = &replay_samples[(i < last ? i + 1 : i)];
+    const float k = (b->t_us > a->t_us ? (float)(t - a->t_us) / (float)(b->t_us - a->t_us) : 0.0f);
+    *x = a->x[0] + k * ((float)b->x[0] - a->x[0]);
+    *y = a->y[0] + k * ((float)b->y[0] - a->y[0]);
+}
+
+static void replay_run(const replay_cfg_t *cfg, size_t count, replay_score_t *score)
+{
+    const int64_t lead_us = CONFIG_REPLAY_LEAD_MS * 1000;
+    const esp_lcd_touch_predict_cfg_t predict_cfg = {
+        .alpha = cfg->alpha,
+        .beta = cfg->beta,
+        .lead_us = lead_us,
+        .max_lead = CONFIG_REPLAY_MAX_LEAD,
+        .reset_us = 100000,
+        .reset_dist = CONFIG_REPLAY_JUMP_DIST,
+    };
+    esp_lcd_touch_predict_t predict;
+    esp_lcd_touch_predict_init(&predict, &predict_cfg);
+
+    size_t first = 0;
+    for (size_t i = 0; i < count; i++) {
+        const replay_sample_t *s = &replay_samples[i];
+        uint16_t x[ESP_LCD_TOUCH_PREDICT_POINTS_MAX];
+        uint16_t y[ESP_LCD_TOUCH_PREDICT_POINTS_MAX];
+
+        esp_lcd_touch_predict_update(&predict, s->x, s->y, s->points, s->t_us);
+        if (s->points == 0) {
+            first = i + 1;
+            continue;
+        }
+        memcpy(x, s->x, sizeof(x));
+        memcpy(y, s->y, sizeof(y));
+        if (cfg->predict) {
+            esp_lcd_touch_predict_get(&predict, x, y, s->points, s->t_us, REPLAY_X_MAX, REPLAY_Y_MAX);
+        }
+
+        /* The stroke ends before release or at the end of the trace */
+        size_t last = i;
+        while (last + 1 < count && replay_samples[last + 1].points > 0) {
+            last++;
+        }
+
+        float tx;
+        float ty;
+        const int64_t target = s->t_us + lead_us;
+        if (target <= replay_samples[last].t_us) {
+            replay_position(first, last, target, &tx, &ty);
+            score->errors[score->count++] = hypotf(x[0] - tx, y[0] - ty);
+        } else {
+            const float stop = hypotf((float)x[0] - replay_samples[last].x[0], (float)y[0] - replay_samples[last].y[0]);
+            score->stop_max = fmaxf(score->stop_max, stop);
+        }
+    }
+}
+
+static int replay_compare(const void *a, const void *b)
+{
+    const float fa = *(const float *)a;
+    const float fb = *(const float *)b;
+    return (fa > fb) - (fa < fb);
+}
+
+static int replay_compare_names(const void *a, const void *b)
+{
+    return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static void replay_print(const char *trace, const char *cfg, replay_score_t *score)
+{
+    float sum = 0;
+    for (uint32_t i = 0; i < score->count; i++) {
+        sum += score->errors[i];
+    }
+    qsort(score->errors, score->count, sizeof(float), replay_compare);
+    const uint32_t p95 = (score->count > 0 ? (score->count * 95 + 99) / 100 - 1 : 0);
+    printf("%-14s %-12s %6u %8.2f %8.2f %8.2f %8.2f\n", trace, cfg, (unsigned)score->count,
+           (score->count ? sum / score->count : 0.0f), (score->count ? score->errors[p95] : 0.0f),
+           (score->count ? score->errors[score->count - 1] : 0.0f), score->stop_max);
+}
+
+void app_main(void)
+{
+    char *names[REPLAY_TRACES_MAX];
+    size_t traces = 0;
+    char path[512];
+
+    DIR *dir = opendir(CONFIG_REPLAY_TRACE_DIR);
+    if (dir == NULL) {
+        printf("Directory %s not found\n", CONFIG_REPLAY_TRACE_DIR);
+        exit(1);
+    }
+    const struct dirent *entry;
+    while (traces < REPLAY_TRACES_MAX && (entry = readdir(dir)) != NULL) {
+        const size_t len = strlen(entry->d_name);
+        if (len > 4 && strcmp(entry->d_name + len - 4, ".csv") == 0) {
+            names[traces++] = strdup(entry->d_name);
+        }
+    }
+    closedir(dir);
+    qsort(names, traces, sizeof(char *), replay_compare_names);
+
+    printf("Lead %d ms, error is distance from the trace position %d ms later (pixels)\n", CONFIG_REPLAY_LEAD_MS, CONFIG_REPLAY_LEAD_MS);
+    printf("%-14s %-12s %6s %8s %8s %8s %8s\n", "trace", "filter", "points", "mean", "p95", "max", "stop");
+
+    for (size_t c = 0; c < REPLAY_CFGS; c++) {
+        replay_total[c].errors = replay_errors[c];
+    }
+    for (size_t t = 0; t < traces; t++) {
+        snprintf(path, sizeof(path), "%s/%s", CONFIG_REPLAY_TRACE_DIR, names[t]);
+        const size_t count = replay_load(path);
+        for (size_t c = 0; c < REPLAY_CFGS; c++) {
+            float errors[REPLAY_SAMPLES_MAX];
+            replay_score_t score = { .errors = errors };
+            replay_run(&replay_cfgs[c], count, &score);
+            memcpy(&replay_total[c].errors[replay_total[c].count], errors, score.count * sizeof(float));
+            replay_total[c].count += score.count;
+            replay_total[c].stop_max = fmaxf(replay_total[c].stop_max, score.stop_max);
+            replay_print(names[t], replay_cfgs[c].name, &score);
+        }
+        free(names[t]);
+    }
+
+    for (size_t c = 0; c < REPLAY_CFGS; c++) {
+        replay_print("all", replay_cfgs[c].name, &replay_total[c]);
+    }
+
+    exit(0);
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+# SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+# SPDX-License-Identifier: CC0-1.0
+"""
+Generate synthetic touch traces in the format of the replay tool.
+
+Line format: t_us,points[,x0,y0[,x1,y1...]], points 0 is release. Lines starting with '#' are comments.
+Recorded traces (e.g. printed from esp_lcd_touch sampler callback) use the same format.
+"""
+
+import math
+import random
+
+RATE_US = 10000     # 100 Hz report rate of capacitive controller
+JITTER_US = 1000
+NOISE = 0.8         # Standard deviation of position noise (pixels)
+X_MAX = 480
+Y_MAX = 320
+
+
+def smoothstep(t):
+    return t * t * (3 - 2 * t)
+
+
+def swipe(t):
+    # Horizontal swipe with ease-in-out, 400 ms
+    if t > 0.4:
+        return None
+    s = smoothstep(t / 0.4)
+    return 40 + 380 * s, 160 + 20 * s
+
+
+def fling(t):
+    # Accelerating fling lifted at full speed, 150 ms
+    if t > 0.15:
+        return None
+    return 60 + 6000 * t * t, 260 - 400 * t
+
+
+def circle(t):
+    # Circle with constant speed, one turn per 800 ms
+    if t > 0.8:
+        return None
+    a = 2 * math.pi * t / 0.8
+    return 240 + 100 * math.cos(a), 160 + 100 * math.sin(a)
+
+
+def zigzag(t):
+    # Quick changes of direction, stop at the end
+    if t > 0.9:
+        return None
+    seg = min(int(t / 0.15), 5)
+    u = min((t - seg * 0.15) / 0.15, 1.0)
+    x0 = 80 + seg * 60
+    y0 = 80 if seg % 2 == 0 else 240
+    y1 = 240 if seg % 2 == 0 else 80
+    return x0 + 60 * u, y0 + (y1 - y0) * smoothstep(u)
+
+
+def hold(t):
+    # Finger held still, prediction must not amplify the noise
+    if t > 0.5:
+        return None
+    return 300, 200
+
+
+def drag_stop(t):
+    # Slow drag, stop and hold before release
+    if t > 0.8:
+        return None
+    s = min(t / 0.4, 1.0)
+    return 100 + 200 * smoothstep(s), 100 + 100 * smoothstep(s)
+
+
+def write(name, strokes, rnd, noise=NOISE, spikes=0.0, drops=0.0):
+    # Noisy traces model resistive or low cost capacitive controller: spikes and single reads without touch
+    with open(name + '.csv', 'w') as f:
+        f.write('# Synthetic trace "{}" generated by generate.py (100 Hz, noise {} px{})\n'.format(
+            name, noise, ', spikes {}, drops {}'.format(spikes, drops) if spikes or drops else ''))
+        t0 = 100000
+        for stroke in strokes:
+            t = 0
+            while True:
+                pos = stroke(t / 1e6)
+                if pos is None:
+                    break
+                if drops and t > 0 and rnd.random() < drops:
+                    f.write('{},0\n'.format(t0 + t + rnd.randint(-JITTER_US, JITTER_US)))
+                    t += RATE_US
+                    continue
+                x = pos[0] + rnd.gauss(0, noise)
+                y = pos[1] + rnd.gauss(0, noise)
+                if spikes and rnd.random() < spikes:
+                    x += rnd.choice((-1, 1)) * rnd.uniform(20, 40)
+                    y += rnd.choice((-1, 1)) * rnd.uniform(20, 40)
+                x = min(max(round(x), 0), X_MAX)
+                y = min(max(round(y), 0), Y_MAX)
+                f.write('{},1,{},{}\n'.format(t0 + t + rnd.randint(-JITTER_US, JITTER_US), x, y))
+                t += RATE_US
+            f.write('{},0\n'.format(t0 + t))
+            t0 += t + 200000
+
+
+if __name__ == '__main__':
+    rnd = random.Random(2024)
+    write('swipe', [swipe, swipe], rnd)
+    write('fling', [fling, fling, fling], rnd)
+    write('circle', [circle], rnd)
+    write('zigzag', [zigzag], rnd)
+    write('hold', [hold], rnd)
+    write('drag_stop', [drag_stop], rnd)
+    write('noisy_hold', [hold, hold], rnd, noise=3.0, spikes=0.05, drops=0.05)
+    write('noisy_drag', [drag_stop, swipe], rnd, noise=3.0, spikes=0.05, drops=0.05)
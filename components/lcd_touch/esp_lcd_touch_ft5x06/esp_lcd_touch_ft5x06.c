@@ -54,6 +54,11 @@ static const char *TAG = "FT5x06";
 #define FT5x06_TOUCH5_YH        (0x1D)
 #define FT5x06_TOUCH5_YL        (0x1E)
 
+/* FT5x06 reports up to 5 points, 6 bytes each after the count */
+#define FT5x06_TOUCH_MAX_POINTS     (5)
+#define FT5x06_TOUCH_READ_POINTS    ((FT5x06_TOUCH_MAX_POINTS < CONFIG_ESP_LCD_TOUCH_MAX_POINTS) ? \
+                                     (FT5x06_TOUCH_MAX_POINTS) : (CONFIG_ESP_LCD_TOUCH_MAX_POINTS))
+
 #define FT5x06_ID_G_THGROUP             (0x80)
 #define FT5x06_ID_G_THPEAK              (0x81)
 #define FT5x06_ID_G_THCAL               (0x82)
@@ -170,24 +175,23 @@ err:
 static esp_err_t esp_lcd_touch_ft5x06_read_data(esp_lcd_touch_handle_t tp)
 {
     esp_err_t err;
-    uint8_t data[30];
+    uint8_t data[1 + FT5x06_TOUCH_READ_POINTS * 6];
     uint8_t points;
     size_t i = 0;
 
     assert(tp != NULL);
 
-    err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH_POINTS, &points, 1);
+    /* Count and all points of one frame are read in one transaction */
+    err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH_POINTS, data, sizeof(data));
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
 
-    if (points > 5 || points == 0) {
+    points = data[0];
+    if (points > FT5x06_TOUCH_MAX_POINTS || points == 0) {
         return ESP_OK;
     }
 
     /* Number of touched points */
-    points = (points > CONFIG_ESP_LCD_TOUCH_MAX_POINTS ? CONFIG_ESP_LCD_TOUCH_MAX_POINTS : points);
-
-    err = touch_ft5x06_i2c_read(tp, FT5x06_TOUCH1_XH, data, 6 * points);
-    ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
+    points = (points > FT5x06_TOUCH_READ_POINTS ? FT5x06_TOUCH_READ_POINTS : points);
 
     portENTER_CRITICAL(&tp->data.lock);
 
@@ -196,8 +200,8 @@ static esp_err_t esp_lcd_touch_ft5x06_read_data(esp_lcd_touch_handle_t tp)
 
     /* Fill all coordinates */
     for (i = 0; i < points; i++) {
-        tp->data.coords[i].x = (((uint16_t)data[(i * 6) + 0] & 0x0f) << 8) + data[(i * 6) + 1];
-        tp->data.coords[i].y = (((uint16_t)data[(i * 6) + 2] & 0x0f) << 8) + data[(i * 6) + 3];
+        tp->data.coords[i].x = (((uint16_t)data[(i * 6) + 1] & 0x0f) << 8) + data[(i * 6) + 2];
+        tp->data.coords[i].y = (((uint16_t)data[(i * 6) + 3] & 0x0f) << 8) + data[(i * 6) + 4];
     }
 
     portEXIT_CRITICAL(&tp->data.lock);
@@ -30,6 +30,11 @@ static const char *TAG = "GT911";
 /* GT911 support key num */
 #define ESP_GT911_TOUCH_MAX_BUTTONS         (4)
 
+/* GT911 reports up to 5 points, 8 bytes each after the status byte */
+#define ESP_GT911_TOUCH_MAX_POINTS          (5)
+#define ESP_GT911_TOUCH_READ_POINTS         ((ESP_GT911_TOUCH_MAX_POINTS < CONFIG_ESP_LCD_TOUCH_MAX_POINTS) ? \
+                                             (ESP_GT911_TOUCH_MAX_POINTS) : (CONFIG_ESP_LCD_TOUCH_MAX_POINTS))
+
 /*******************************************************************************
 * Function definitions
 *******************************************************************************/
@@ -217,7 +222,8 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 
     assert(tp != NULL);
 
-    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1);
+    /* Status and all points of one frame are read in one transaction */
+    err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, buf, 1 + ESP_GT911_TOUCH_READ_POINTS * 8);
     ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
 
     /* Any touch data? */
@@ -255,15 +261,11 @@ static esp_err_t esp_lcd_touch_gt911_read_data(esp_lcd_touch_handle_t tp)
 #endif
         /* Count of touched points */
         touch_cnt = buf[0] & 0x0f;
-        if (touch_cnt > 5 || touch_cnt == 0) {
+        if (touch_cnt > ESP_GT911_TOUCH_MAX_POINTS || touch_cnt == 0) {
             touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
             return ESP_OK;
         }
 
-        /* Read all points */
-        err = touch_gt911_i2c_read(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG + 1, &buf[1], touch_cnt * 8);
-        ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");
-
         /* Clear all */
         err = touch_gt911_i2c_write(tp, ESP_LCD_TOUCH_GT911_READ_XY_REG, clear);
         ESP_RETURN_ON_ERROR(err, TAG, "I2C read error!");